@@ -0,0 +1,189 @@
+#include "Benchmark.h"
+
+#include "Core/FileSystem/AssetPack.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Hub startup asset loading: the dozen loose files the hub opens (icons, logo, font,
+// settings defaults) read the way it used to read them, against the same files
+// served out of one mapped .vpak, stored and LZ4 compressed. Every byte is touched
+// in both cases, as the decoders would.
+//
+// Warm runs have everything in the page cache. Cold runs drop the files from the
+// cache before each sample (posix_fadvise DONTNEED, Linux only); elsewhere the
+// cold benchmark records cold_supported = 0 and nothing else.
+
+namespace {
+
+    constexpr int ColdIterations = 30;
+
+    struct AssetSpec {
+        const char* path;
+        size_t size;
+        bool compressible;
+    };
+
+    // Sizes of the hub's own assets, rounded. PNGs and the TTF are already
+    // compressed and get random bytes; JSON gets repetitive text.
+    constexpr AssetSpec Assets[] = {
+        { "logo.png", 64 * 1024, false },
+        { "project_icon.png", 12 * 1024, false },
+        { "settings_icon.png", 8 * 1024, false },
+        { "new_project_icon.png", 10 * 1024, false },
+        { "empty_project_template_icon.png", 14 * 1024, false },
+        { "Fredoka-Medium.ttf", 280 * 1024, false },
+        { "defaults/hub_settings.json", 4 * 1024, true },
+        { "defaults/projects.json", 2 * 1024, true },
+        { "defaults/key_bindings.json", 3 * 1024, true },
+        { "templates/empty/template.json", 1024, true },
+        { "templates/2d/template.json", 1024, true },
+        { "templates/3d/template.json", 1024, true },
+    };
+
+    std::vector<uint8_t> assetBytes(const AssetSpec& spec) {
+        std::vector<uint8_t> bytes(spec.size);
+        if (spec.compressible) {
+            string line;
+            for (size_t i = 0; line.size() < spec.size; ++i)
+                line += std::format("    \"setting_{}\": {},\n", i % 40, i % 7 == 0 ? "true" : "false");
+            std::copy_n(line.begin(), spec.size, bytes.begin());
+        }
+        else {
+            uint64_t state = 0x9E3779B97F4A7C15ull ^ spec.size;
+            for (uint8_t& byte : bytes) {
+                state = state * 6364136223846793005ull + 1442695040888963407ull;
+                byte = static_cast<uint8_t>(state >> 56);
+            }
+        }
+        return bytes;
+    }
+
+    size_t touch(std::span<const uint8_t> bytes) {
+        size_t sum = 0;
+        for (uint8_t byte : bytes)
+            sum += byte;
+        return sum;
+    }
+
+    // How every loose asset was read: open, read the whole file into a buffer.
+    size_t readLoose(const std::filesystem::path& assetDirectory) {
+        size_t sum = 0;
+        for (const AssetSpec& spec : Assets) {
+            std::ifstream file(assetDirectory / spec.path, std::ios::binary);
+            std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            sum += touch(bytes);
+        }
+        return sum;
+    }
+
+    size_t readPack(const std::filesystem::path& packPath) {
+        FileSystem::AssetPackReader pack;
+        string error;
+        if (!pack.open(packPath, error))
+            return 0;
+
+        size_t sum = 0;
+        for (const AssetSpec& spec : Assets) {
+            if (std::optional<FileSystem::AssetData> data = pack.read(spec.path, error))
+                sum += touch(data->bytes());
+        }
+        return sum;
+    }
+
+    bool evictFromPageCache(const std::filesystem::path& path) {
+#ifdef __linux__
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        // Dirty pages aren't dropped, and setUp() has only just written these files.
+        int result = fdatasync(fd) == 0 ? posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) : -1;
+        ::close(fd);
+        return result == 0;
+#else
+        (void)path;
+        return false;
+#endif
+    }
+
+    class AssetPackFixture : public Benchmark::Fixture {
+    public:
+        Benchmark::TempDirectory directory;
+        std::filesystem::path assetDirectory;
+        std::filesystem::path packPath;
+        std::filesystem::path lz4PackPath;
+
+        void setUp() override {
+            assetDirectory = directory / "assets";
+            packPath = directory / "assets.vpak";
+            lz4PackPath = directory / "assets_lz4.vpak";
+
+            std::error_code ec;
+            for (const AssetSpec& spec : Assets) {
+                std::filesystem::path path = assetDirectory / spec.path;
+                std::filesystem::create_directories(path.parent_path(), ec);
+
+                std::vector<uint8_t> bytes = assetBytes(spec);
+                std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+            }
+
+            string error;
+            if (!FileSystem::packDirectory(assetDirectory, packPath, FileSystem::PackFormat::Compression::None, error)
+                || !FileSystem::packDirectory(assetDirectory, lz4PackPath, FileSystem::PackFormat::Compression::LZ4, error))
+                std::cerr << "Could not pack " << assetDirectory << ": " << error << std::endl;
+        }
+
+        bool evictAll() {
+            bool evicted = evictFromPageCache(packPath) && evictFromPageCache(lz4PackPath);
+            for (const AssetSpec& spec : Assets)
+                evicted = evictFromPageCache(assetDirectory / spec.path) && evicted;
+            return evicted;
+        }
+
+        void recordSizes(Benchmark::Context& context) {
+            size_t looseBytes = 0;
+            for (const AssetSpec& spec : Assets)
+                looseBytes += spec.size;
+
+            std::error_code ec;
+            context.counter("files", static_cast<double>(std::size(Assets)));
+            context.counter("loose_bytes", static_cast<double>(looseBytes));
+            context.counter("pack_bytes", static_cast<double>(std::filesystem::file_size(packPath, ec)));
+            context.counter("pack_lz4_bytes", static_cast<double>(std::filesystem::file_size(lz4PackPath, ec)));
+        }
+    };
+
+}
+
+VOLT_BENCHMARK_F(AssetPackFixture, AssetStartupWarm) {
+    recordSizes(context);
+
+    context.measure("loose", [&] { Benchmark::doNotOptimize(readLoose(assetDirectory)); });
+    context.measure("pack", [&] { Benchmark::doNotOptimize(readPack(packPath)); });
+    context.measure("pack_lz4", [&] { Benchmark::doNotOptimize(readPack(lz4PackPath)); });
+}
+
+VOLT_BENCHMARK_F(AssetPackFixture, AssetStartupCold) {
+    if (!evictAll()) {
+        context.counter("cold_supported", 0);
+        return;
+    }
+    context.counter("cold_supported", 1);
+
+    auto sample = [&](auto&& function) {
+        std::vector<double> samples;
+        for (int i = 0; i < ColdIterations; ++i) {
+            evictAll();
+            Benchmark::Clock::time_point start = Benchmark::Clock::now();
+            Benchmark::doNotOptimize(function());
+            samples.push_back(std::chrono::duration<double, std::micro>(Benchmark::Clock::now() - start).count());
+        }
+        return samples;
+    };
+
+    context.percentiles("loose_us", sample([&] { return readLoose(assetDirectory); }));
+    context.percentiles("pack_us", sample([&] { return readPack(packPath); }));
+    context.percentiles("pack_lz4_us", sample([&] { return readPack(lz4PackPath); }));
+}
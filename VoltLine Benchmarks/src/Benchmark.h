@@ -0,0 +1,171 @@
+#pragma once
+
+#include "pch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+
+namespace Benchmark {
+
+    using Clock = std::chrono::steady_clock;
+
+    // Keeps the compiler from dropping a computation whose result is otherwise unused.
+    inline const void* volatile escapeSink = nullptr;
+
+    template<typename T>
+    inline void doNotOptimize(const T& value) {
+        escapeSink = &value;
+    }
+
+    // Per-benchmark output: named counters that end up in the console table and the
+    // JSON report.
+    class Context {
+    public:
+        explicit Context(string name) : name(std::move(name)) {}
+
+        void counter(const string& key, double value) { counters.emplace_back(key, value); }
+
+        // Records p50/p99/p999/max of a set of samples under "<key>_p50" and so on.
+        void percentiles(const string& key, std::vector<double> samples) {
+            if (samples.empty())
+                return;
+
+            std::sort(samples.begin(), samples.end());
+            auto at = [&](double p) { return samples[static_cast<size_t>(p * (samples.size() - 1))]; };
+
+            counter(key + "_p50", at(0.50));
+            counter(key + "_p99", at(0.99));
+            counter(key + "_p999", at(0.999));
+            counter(key + "_max", samples.back());
+        }
+
+        // Google Benchmark style timing loop for operations far shorter than a clock tick:
+        // the iteration count grows until one run takes MinimumRunTime, then Repetitions
+        // runs of that many iterations are timed. Records "<key>_ns" (median time per
+        // iteration), "<key>_ns_min", "<key>_ns_max" and "<key>_iterations".
+        template<typename Function>
+        void measure(const string& key, Function&& function) {
+            static constexpr std::chrono::milliseconds MinimumRunTime{ 50 };
+            static constexpr int Repetitions = 9;
+
+            auto run = [&](uint64_t iterations) {
+                Clock::time_point start = Clock::now();
+                for (uint64_t i = 0; i < iterations; ++i)
+                    function();
+                return Clock::now() - start;
+            };
+
+            uint64_t iterations = 1;
+            for (Clock::duration elapsed = run(iterations); elapsed < MinimumRunTime; elapsed = run(iterations)) {
+                // Aim a little past the minimum instead of creeping up on it tenfold at a time.
+                double scale = elapsed.count() > 0 ? 1.4 * MinimumRunTime / elapsed : 10.0;
+                iterations = std::max(iterations + 1, static_cast<uint64_t>(iterations * std::min(scale, 10.0)));
+            }
+
+            std::vector<double> nanoseconds;
+            for (int i = 0; i < Repetitions; ++i)
+                nanoseconds.push_back(std::chrono::duration<double, std::nano>(run(iterations)).count() / iterations);
+
+            std::sort(nanoseconds.begin(), nanoseconds.end());
+            counter(key + "_ns", nanoseconds[nanoseconds.size() / 2]);
+            counter(key + "_ns_min", nanoseconds.front());
+            counter(key + "_ns_max", nanoseconds.back());
+            counter(key + "_iterations", static_cast<double>(iterations));
+        }
+
+        const string& getName() const { return name; }
+        const std::vector<std::pair<string, double>>& getCounters() const { return counters; }
+
+    private:
+        string name;
+        std::vector<std::pair<string, double>> counters;
+    };
+
+    using Function = void(*)(Context&);
+
+    struct Entry {
+        const char* name;
+        Function function;
+    };
+
+    inline std::vector<Entry>& registry() {
+        static std::vector<Entry> entries;
+        return entries;
+    }
+
+    struct Registration {
+        Registration(const char* name, Function function) { registry().push_back({ name, function }); }
+    };
+
+    // A new, empty directory under the system temp path for the files a benchmark
+    // works on, removed with everything in it on destruction. Keeps benchmark files
+    // out of the working directory, and concurrent runs out of each other's way.
+    class TempDirectory {
+    public:
+        explicit TempDirectory(std::string_view prefix = "voltline_benchmark") {
+            static std::atomic<uint32_t> sequence{ 0 };
+
+            std::error_code ec;
+            std::filesystem::path base = std::filesystem::temp_directory_path(ec);
+            if (ec)
+                base = std::filesystem::current_path();
+
+            // create_directory is false for a directory that already existed, so a
+            // leftover from an earlier run is never reused.
+            do {
+                uint64_t stamp = static_cast<uint64_t>(Clock::now().time_since_epoch().count());
+                root = base / std::format("{}_{:x}_{}", prefix, stamp, sequence++);
+            } while (!std::filesystem::create_directory(root, ec) && !ec);
+
+            if (ec)
+                std::cerr << "Could not create " << root << ": " << ec.message() << std::endl;
+        }
+
+        ~TempDirectory() {
+            std::error_code ec;
+            std::filesystem::remove_all(root, ec);
+        }
+
+        TempDirectory(const TempDirectory&) = delete;
+        TempDirectory& operator=(const TempDirectory&) = delete;
+
+        const std::filesystem::path& path() const { return root; }
+        std::filesystem::path operator/(const std::filesystem::path& name) const { return root / name; }
+
+    private:
+        std::filesystem::path root;
+    };
+
+    // State shared by the benchmarks of a VOLT_BENCHMARK_F: setUp() runs before each
+    // of them on a fresh instance and tearDown() after, both outside the timed code.
+    class Fixture {
+    public:
+        virtual ~Fixture() = default;
+
+        virtual void setUp() {}
+        virtual void tearDown() {}
+    };
+
+    // Runs every registered benchmark whose name contains --filter, printing the
+    // counters and writing them to --json <file> if given.
+    int runAll(int argc, char** argv);
+
+}
+
+#define VOLT_BENCHMARK(name) \
+    static void name(Benchmark::Context& context); \
+    static Benchmark::Registration name##Registration(#name, name); \
+    static void name(Benchmark::Context& context)
+
+// A benchmark with a fixture: the body is a member function of a class derived from
+// `fixture`, so it sees the fixture's members directly.
+#define VOLT_BENCHMARK_F(fixture, name) \
+    namespace { struct name##Fixture : fixture { void run(Benchmark::Context& context); }; } \
+    VOLT_BENCHMARK(name) { \
+        name##Fixture instance; \
+        instance.setUp(); \
+        instance.run(context); \
+        instance.tearDown(); \
+    } \
+    void name##Fixture::run(Benchmark::Context& context)
@@ -0,0 +1,116 @@
+#include "Benchmark.h"
+
+#include "nlohmann/json.hpp"
+
+namespace Benchmark {
+
+    namespace {
+
+        // Counters of an earlier --json report, by benchmark and counter name.
+        std::map<string, std::map<string, double>> loadBaseline(const string& path) {
+            std::map<string, std::map<string, double>> baseline;
+
+            std::ifstream file(path, std::ios::binary);
+            nlohmann::json report = nlohmann::json::parse(file, nullptr, false);
+            if (report.is_discarded() || !report.contains("benchmarks")) {
+                std::cerr << "Could not read the baseline " << path << std::endl;
+                return baseline;
+            }
+
+            for (const nlohmann::json& result : report["benchmarks"]) {
+                if (!result.contains("counters"))
+                    continue;
+                for (const auto& [key, value] : result["counters"].items()) {
+                    if (value.is_number())
+                        baseline[result.value("name", "")][key] = value.get<double>();
+                }
+            }
+            return baseline;
+        }
+
+    }
+
+    int runAll(int argc, char** argv) {
+        string filter;
+        string jsonPath;
+        string label;
+        string baselinePath;
+
+        for (int i = 1; i < argc; ++i) {
+            std::string_view arg = argv[i];
+            if (arg == "--filter" && i + 1 < argc)
+                filter = argv[++i];
+            else if (arg == "--json" && i + 1 < argc)
+                jsonPath = argv[++i];
+            else if (arg == "--label" && i + 1 < argc)
+                label = argv[++i];
+            else if (arg == "--baseline" && i + 1 < argc)
+                baselinePath = argv[++i];
+            else {
+                std::cerr << "Usage: VoltLine Benchmarks [--filter <substring>] [--json <file>] [--label <text>] [--baseline <file>]" << std::endl;
+                return 1;
+            }
+        }
+
+        std::map<string, std::map<string, double>> baseline;
+        if (!baselinePath.empty())
+            baseline = loadBaseline(baselinePath);
+
+        // Enough to tell two reports apart when comparing runs across commits; --label is
+        // usually the commit hash.
+        nlohmann::json report;
+        report["context"]["label"] = label;
+        report["context"]["date"] = std::format("{:%Y-%m-%dT%H:%M:%SZ}", std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now()));
+        report["context"]["configuration"] = CURRENT_CONF;
+        report["context"]["platform"] = CURRENT_PLAT;
+        report["context"]["hardware_threads"] = std::thread::hardware_concurrency();
+        report["benchmarks"] = nlohmann::json::array();
+
+        for (const Entry& entry : registry()) {
+            if (!filter.empty() && string(entry.name).find(filter) == string::npos)
+                continue;
+
+            std::cout << entry.name << std::endl;
+
+            Context context(entry.name);
+            Clock::time_point start = Clock::now();
+            entry.function(context);
+            double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+            nlohmann::json result;
+            result["name"] = entry.name;
+            result["wall_seconds"] = seconds;
+
+            const std::map<string, double>& previous = baseline[entry.name];
+
+            for (const auto& [key, value] : context.getCounters()) {
+                std::cout << tenSpace << std::left << std::setw(28) << key << std::setw(14) << value;
+
+                auto old = previous.find(key);
+                if (old != previous.end() && old->second != 0.0)
+                    std::cout << std::format("(baseline {}, {:+.1f}%)", old->second, (value - old->second) / old->second * 100.0);
+
+                std::cout << std::endl;
+                result["counters"][key] = value;
+            }
+
+            report["benchmarks"].push_back(result);
+        }
+
+        if (!jsonPath.empty()) {
+            std::ofstream out(jsonPath, std::ios::out | std::ios::trunc);
+            if (!out.is_open()) {
+                std::cerr << "Could not write " << jsonPath << std::endl;
+                return 1;
+            }
+            out << report.dump(4);
+        }
+
+        return 0;
+    }
+
+}
+
+int main(int argc, char** argv) {
+    return Benchmark::runAll(argc, argv);
+}
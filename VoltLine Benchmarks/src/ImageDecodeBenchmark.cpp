@@ -0,0 +1,118 @@
+#include "Benchmark.h"
+
+#include "Core/Renderer/ImageDecode.h"
+
+// PNG decode through decodeImage, the work every hub icon goes through before it
+// is uploaded. The images are generated here (the repository has no sample art):
+// uncompressed PNGs, so the numbers are the decoder's filtering and conversion
+// cost plus the file read, without much inflate work.
+
+namespace {
+
+    uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0) {
+        static const std::array<uint32_t, 256> table = [] {
+            std::array<uint32_t, 256> values{};
+            for (uint32_t n = 0; n < 256; ++n) {
+                uint32_t c = n;
+                for (int k = 0; k < 8; ++k)
+                    c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                values[n] = c;
+            }
+            return values;
+        }();
+
+        crc = ~crc;
+        for (size_t i = 0; i < size; ++i)
+            crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    void appendBigEndian(std::vector<uint8_t>& out, uint32_t value) {
+        for (int shift = 24; shift >= 0; shift -= 8)
+            out.push_back(static_cast<uint8_t>(value >> shift));
+    }
+
+    void appendChunk(std::vector<uint8_t>& out, const char type[4], const std::vector<uint8_t>& data) {
+        appendBigEndian(out, static_cast<uint32_t>(data.size()));
+
+        size_t start = out.size();
+        out.insert(out.end(), type, type + 4);
+        out.insert(out.end(), data.begin(), data.end());
+        appendBigEndian(out, crc32(out.data() + start, out.size() - start));
+    }
+
+    // An RGBA8 PNG whose image data is stored as raw deflate blocks.
+    std::vector<uint8_t> encodePng(uint32_t width, uint32_t height) {
+        std::vector<uint8_t> raw;
+        raw.reserve((width * 4 + 1) * height);
+        for (uint32_t y = 0; y < height; ++y) {
+            raw.push_back(0); // filter: none
+            for (uint32_t x = 0; x < width; ++x) {
+                raw.push_back(static_cast<uint8_t>(x * 255 / width));
+                raw.push_back(static_cast<uint8_t>(y * 255 / height));
+                raw.push_back(static_cast<uint8_t>((x ^ y) & 0xFF));
+                raw.push_back(255);
+            }
+        }
+
+        std::vector<uint8_t> zlib = { 0x78, 0x01 };
+        for (size_t offset = 0; offset < raw.size();) {
+            uint16_t length = static_cast<uint16_t>(std::min<size_t>(raw.size() - offset, 0xFFFF));
+            bool last = offset + length == raw.size();
+
+            zlib.push_back(last ? 1 : 0);
+            zlib.push_back(static_cast<uint8_t>(length));
+            zlib.push_back(static_cast<uint8_t>(length >> 8));
+            zlib.push_back(static_cast<uint8_t>(~length));
+            zlib.push_back(static_cast<uint8_t>(~length >> 8));
+            zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + length);
+            offset += length;
+        }
+
+        uint32_t a = 1, b = 0;
+        for (uint8_t byte : raw) {
+            a = (a + byte) % 65521;
+            b = (b + a) % 65521;
+        }
+        appendBigEndian(zlib, (b << 16) | a);
+
+        std::vector<uint8_t> header;
+        appendBigEndian(header, width);
+        appendBigEndian(header, height);
+        header.insert(header.end(), { 8, 6, 0, 0, 0 }); // 8 bits, RGBA, deflate, adaptive filtering, no interlace
+
+        std::vector<uint8_t> png = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        appendChunk(png, "IHDR", header);
+        appendChunk(png, "IDAT", zlib);
+        appendChunk(png, "IEND", {});
+        return png;
+    }
+
+    void measureDecode(Benchmark::Context& context, uint32_t size) {
+        Benchmark::TempDirectory directory;
+        const std::filesystem::path path = directory / std::format("image_{}.png", size);
+
+        std::vector<uint8_t> png = encodePng(size, size);
+        std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(png.data()), png.size());
+
+        string file = path.string();
+        context.measure("decode", [&] {
+            Renderer::DecodedImage image = Renderer::decodeImage(file);
+            Benchmark::doNotOptimize(image);
+        });
+
+        context.counter("file_bytes", static_cast<double>(png.size()));
+        context.counter("decoded_ok", Renderer::decodeImage(file).valid());
+    }
+
+}
+
+// The size of the hub's sidebar icons.
+VOLT_BENCHMARK(ImageDecodeIcon) {
+    measureDecode(context, 64);
+}
+
+// The size of the project template preview.
+VOLT_BENCHMARK(ImageDecodeTemplate) {
+    measureDecode(context, 512);
+}
@@ -0,0 +1,172 @@
+#include "Benchmark.h"
+
+#include <cmath>
+
+#include "Core/Managers/EngineManager/EngineManager.h"
+
+// Scaling of the job system across core counts. Each run builds its own
+// JobSystem, with 1, 2, 4, ... workers up to hardware_concurrency() - 1 (the
+// calling thread always works too), and reports time and speedup over the
+// serial loop as "<threads>t_..." counters.
+
+namespace {
+
+    constexpr size_t ElementCount = 1 << 21;
+    constexpr int TinyJobCount = 200000;
+    constexpr int Repetitions = 5;
+
+    std::vector<unsigned> workerCounts() {
+        unsigned maxWorkers = std::max(1u, std::thread::hardware_concurrency() - 1);
+
+        std::vector<unsigned> counts;
+        for (unsigned count = 1; count < maxWorkers; count *= 2)
+            counts.push_back(count);
+        counts.push_back(maxWorkers);
+        return counts;
+    }
+
+    // Stands in for per-element work like decoding or transforming a vertex.
+    float work(size_t index) {
+        float value = static_cast<float>(index);
+        for (int i = 0; i < 32; ++i)
+            value = std::sin(value) * 0.5f + std::sqrt(value + 1.0f);
+        return value;
+    }
+
+    template<typename Function>
+    double bestOf(Function&& function) {
+        double best = std::numeric_limits<double>::max();
+        for (int i = 0; i < Repetitions; ++i) {
+            Benchmark::Clock::time_point start = Benchmark::Clock::now();
+            function();
+            best = std::min(best, std::chrono::duration<double, std::milli>(Benchmark::Clock::now() - start).count());
+        }
+        return best;
+    }
+
+}
+
+VOLT_BENCHMARK(JobSystemParallelForScaling) {
+    std::vector<float> output(ElementCount);
+
+    double serialMs = bestOf([&] {
+        for (size_t i = 0; i < ElementCount; ++i)
+            output[i] = work(i);
+    });
+    context.counter("1t_serial_ms", serialMs);
+
+    for (unsigned workers : workerCounts()) {
+        EngineManager::JobSystem system(workers);
+
+        double ms = bestOf([&] {
+            system.parallelFor(0, ElementCount, 0, [&](size_t first, size_t last) {
+                for (size_t i = first; i < last; ++i)
+                    output[i] = work(i);
+            });
+        });
+
+        string prefix = std::format("{}t_", workers + 1);
+        context.counter(prefix + "ms", ms);
+        context.counter(prefix + "speedup", serialMs / ms);
+    }
+}
+
+VOLT_BENCHMARK(JobSystemTinyJobThroughput) {
+    for (unsigned workers : workerCounts()) {
+        EngineManager::JobSystem system(workers);
+        std::atomic<int> sum{ 0 };
+
+        double ms = bestOf([&] {
+            EngineManager::JobCounter counter;
+            for (int i = 0; i < TinyJobCount; ++i)
+                system.run([&sum]() { sum.fetch_add(1, std::memory_order_relaxed); }, &counter);
+            system.wait(counter);
+        });
+
+        context.counter(std::format("{}t_jobs_per_sec", workers + 1), TinyJobCount / (ms / 1000.0));
+    }
+}
+
+VOLT_BENCHMARK(JobSystemGraphFanOut) {
+    // A root, a fan of independent nodes, then a join, repeated: the shape of a
+    // frame's "prepare, process in parallel, merge" pass.
+    constexpr int Layers = 64;
+    constexpr int Width = 64;
+
+    for (unsigned workers : workerCounts()) {
+        EngineManager::JobSystem system(workers);
+        std::vector<float> results(Layers * Width);
+
+        double ms = bestOf([&] {
+            EngineManager::JobGraph graph;
+            EngineManager::JobGraph::NodeId previousJoin = graph.add([] {});
+
+            for (int layer = 0; layer < Layers; ++layer) {
+                EngineManager::JobGraph::NodeId join = graph.add([] {});
+                for (int column = 0; column < Width; ++column) {
+                    size_t slot = static_cast<size_t>(layer) * Width + column;
+                    EngineManager::JobGraph::NodeId node = graph.add([&results, slot] {
+                        for (size_t i = 0; i < 256; ++i)
+                            results[slot] += work(slot + i);
+                    });
+                    graph.precede(previousJoin, node);
+                    graph.precede(node, join);
+                }
+                previousJoin = join;
+            }
+
+            EngineManager::JobCounter counter;
+            graph.run(system, counter);
+            system.wait(counter);
+        });
+
+        context.counter(std::format("{}t_ms", workers + 1), ms);
+    }
+}
+
+VOLT_BENCHMARK(JobSystemGraphFanOutFailure) {
+    // A root fanning out to a chain of two nodes per column, then a join, with one
+    // first-in-chain node throwing: its follow-up and the join must be skipped,
+    // every other node must still run, and the wait must cover all of them.
+    constexpr int Width = 64;
+    constexpr int FailingColumn = Width / 2;
+
+    EngineManager::JobSystem system(std::max(1u, std::thread::hardware_concurrency() - 1));
+    std::atomic<int> ran{ 0 };
+
+    EngineManager::JobGraph graph;
+    EngineManager::JobGraph::NodeId root = graph.add([&ran] { ran.fetch_add(1); });
+    EngineManager::JobGraph::NodeId join = graph.add([&ran] { ran.fetch_add(1); });
+
+    for (int column = 0; column < Width; ++column) {
+        EngineManager::JobGraph::NodeId first = graph.add([&ran, column] {
+            if (column == FailingColumn)
+                throw std::runtime_error("benchmark failure");
+            ran.fetch_add(1);
+        });
+        EngineManager::JobGraph::NodeId second = graph.add([&ran] { ran.fetch_add(1); });
+
+        graph.precede(root, first);
+        graph.precede(first, second);
+        graph.precede(second, join);
+    }
+
+    double ms = 0.0;
+    {
+        Benchmark::Clock::time_point start = Benchmark::Clock::now();
+        EngineManager::JobCounter counter;
+        graph.run(system, counter);
+        system.wait(counter);
+        ms = std::chrono::duration<double, std::milli>(Benchmark::Clock::now() - start).count();
+    }
+
+    // Expected: root + (Width - 1) full chains ran; the failing column's second node and the join were skipped.
+    int expectedRan = 1 + (Width - 1) * 2;
+    size_t skipped = graph.getSkippedNodes().size();
+
+    context.counter("ms", ms);
+    context.counter("ran", ran.load());
+    context.counter("skipped", static_cast<double>(skipped));
+    context.counter("failed", graph.hasFailed());
+    context.counter("as_expected", graph.hasFailed() && ran.load() == expectedRan && skipped == 2);
+}
@@ -0,0 +1,61 @@
+#include "Benchmark.h"
+
+#include "Core/Managers/KeyBindingManager/KeyBindingManager.h"
+
+// Parsing a binding string happens when bindings are (re)registered; matching runs
+// for every key event.
+
+namespace {
+
+    constexpr std::string_view Combos[] = {
+        "ESCAPE", "CTRL+S", "CTRL+SHIFT+S", "ALT+F4", "CTRL+ALT+DELETE",
+        "SHIFT+TAB", "CTRL+KP_ADD", "SUPER+SPACE", "CTRL+SHIFT+F12", "RIGHT_CONTROL",
+    };
+
+    class KeyBindingFixture : public Benchmark::Fixture {
+    public:
+        KeyBindingManager manager;
+        std::vector<KeyCombination> combinations;
+
+        void setUp() override {
+            for (std::string_view combo : Combos) {
+                combinations.push_back(*KeyBindingManager::parseKeyCombo(combo));
+                manager.registerKeyBinding(string(combo), Action::CloseApp);
+            }
+
+            // Enough unrelated bindings that a lookup isn't trivially the only entry.
+            for (int i = 0; i < 12; ++i)
+                manager.registerKeyBinding(std::format("CTRL+ALT+F{}", i + 1), Action::CloseApp);
+        }
+    };
+
+}
+
+VOLT_BENCHMARK(KeyBindingParse) {
+    context.measure("parse", [] {
+        for (std::string_view combo : Combos) {
+            std::optional<KeyCombination> parsed = KeyBindingManager::parseKeyCombo(combo);
+            Benchmark::doNotOptimize(parsed);
+        }
+    });
+    context.counter("combos_per_iteration", std::size(Combos));
+}
+
+VOLT_BENCHMARK_F(KeyBindingFixture, KeyBindingCheck) {
+    context.measure("check", [&] {
+        int matches = 0;
+        for (const KeyCombination& combo : combinations)
+            matches += KeyBindingManager::checkKeyCombination(combo, GLFW_KEY_S, GLFW_MOD_CONTROL | GLFW_MOD_SHIFT);
+        Benchmark::doNotOptimize(matches);
+    });
+    context.counter("combos_per_iteration", static_cast<double>(combinations.size()));
+}
+
+// A full press/release through the compiled table, the path every key callback takes.
+VOLT_BENCHMARK_F(KeyBindingFixture, KeyBindingEvent) {
+    context.measure("event", [&] {
+        std::optional<Action> action = manager.onKeyEvent(GLFW_KEY_S, GLFW_PRESS, GLFW_MOD_CONTROL | GLFW_MOD_SHIFT);
+        Benchmark::doNotOptimize(action);
+        manager.onKeyEvent(GLFW_KEY_S, GLFW_RELEASE, GLFW_MOD_CONTROL | GLFW_MOD_SHIFT);
+    });
+}
@@ -0,0 +1,84 @@
+#include "Benchmark.h"
+
+#include "Core/Logging/AsyncSink.h"
+
+// Compares the hub's original logging setup (a file sink flushed on every info
+// line, written on the calling thread) with the async sink under each overflow
+// policy. The console sink is left out of both so the terminal doesn't dominate.
+
+namespace {
+
+    constexpr int MessagesPerThread = 100000;
+
+    void measure(Benchmark::Context& context, spdlog::logger& logger, int threadCount, const std::function<void()>& drain) {
+        std::vector<std::vector<double>> latencies(threadCount);
+        std::vector<std::thread> threads;
+
+        Benchmark::Clock::time_point start = Benchmark::Clock::now();
+
+        for (int t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&, t] {
+                std::vector<double>& samples = latencies[t];
+                samples.reserve(MessagesPerThread);
+
+                for (int i = 0; i < MessagesPerThread; ++i) {
+                    Benchmark::Clock::time_point before = Benchmark::Clock::now();
+                    logger.info("Frame {} on thread {}: uploaded {} textures in {:.3f} ms", i, t, i % 7, i * 0.001);
+                    samples.push_back(std::chrono::duration<double, std::micro>(Benchmark::Clock::now() - before).count());
+                }
+            });
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        double callerSeconds = std::chrono::duration<double>(Benchmark::Clock::now() - start).count();
+        drain();
+        double totalSeconds = std::chrono::duration<double>(Benchmark::Clock::now() - start).count();
+
+        std::vector<double> all;
+        for (const std::vector<double>& samples : latencies)
+            all.insert(all.end(), samples.begin(), samples.end());
+
+        double messages = static_cast<double>(threadCount) * MessagesPerThread;
+        context.counter("threads", threadCount);
+        context.counter("caller_msgs_per_sec", messages / callerSeconds);
+        context.counter("end_to_end_msgs_per_sec", messages / totalSeconds);
+        context.percentiles("call_latency_us", std::move(all));
+    }
+
+    // The directory is declared first so the logger has closed the file before it is removed.
+    void synchronous(Benchmark::Context& context, int threadCount) {
+        Benchmark::TempDirectory directory;
+
+        auto fileSink = std::make_shared<spdlog::sinks::basic_file_sink_mt>((directory / "log.txt").string(), true);
+        spdlog::logger logger("benchmark", fileSink);
+        logger.flush_on(spdlog::level::info);
+
+        measure(context, logger, threadCount, [&] { logger.flush(); });
+    }
+
+    void asynchronous(Benchmark::Context& context, int threadCount, Logging::OverflowPolicy policy) {
+        Benchmark::TempDirectory directory;
+
+        Logging::AsyncSinkOptions options;
+        options.policy = policy;
+
+        std::vector<spdlog::sink_ptr> sinks = { std::make_shared<spdlog::sinks::rotating_file_sink_st>((directory / "log.txt").string(), 64 * 1024 * 1024, 2, true) };
+        auto sink = std::make_shared<Logging::AsyncSink>(std::move(sinks), options);
+        spdlog::logger logger("benchmark", sink);
+        logger.flush_on(spdlog::level::info);
+
+        measure(context, logger, threadCount, [&] { sink->flushAndWait(); });
+        context.counter("dropped", static_cast<double>(sink->getDroppedCount()));
+    }
+
+}
+
+VOLT_BENCHMARK(LogSyncFlushOnInfo_1Thread) { synchronous(context, 1); }
+VOLT_BENCHMARK(LogSyncFlushOnInfo_4Threads) { synchronous(context, 4); }
+
+VOLT_BENCHMARK(LogAsyncBlock_1Thread) { asynchronous(context, 1, Logging::OverflowPolicy::Block); }
+VOLT_BENCHMARK(LogAsyncBlock_4Threads) { asynchronous(context, 4, Logging::OverflowPolicy::Block); }
+VOLT_BENCHMARK(LogAsyncDrop_4Threads) { asynchronous(context, 4, Logging::OverflowPolicy::Drop); }
+VOLT_BENCHMARK(LogAsyncOverwrite_4Threads) { asynchronous(context, 4, Logging::OverflowPolicy::Overwrite); }
@@ -0,0 +1,158 @@
+#include "Benchmark.h"
+
+#include "nlohmann/json.hpp"
+
+#include "Core/Managers/ProjectManager/ProjectFile.h"
+
+// Open time of a binary .voltproj against the same project stored as JSON: once
+// for what the project list needs (name, description, ...) and once for every
+// section. The project has a 256x256 thumbnail and a 10k entry asset manifest,
+// which the JSON version has to parse even when only the name is wanted.
+
+namespace {
+
+    constexpr int Iterations = 200;
+    constexpr uint32_t ThumbnailSize = 256;
+    constexpr int AssetCount = 10000;
+
+    // The same project written both ways, in a temp directory for the benchmark.
+    struct ProjectFiles {
+        std::filesystem::path binary;
+        std::filesystem::path json;
+    };
+
+    string base64(std::span<const uint8_t> bytes) {
+        static constexpr char Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+        string out;
+        out.reserve((bytes.size() + 2) / 3 * 4);
+        for (size_t i = 0; i < bytes.size(); i += 3) {
+            uint32_t chunk = uint32_t(bytes[i]) << 16;
+            if (i + 1 < bytes.size()) chunk |= uint32_t(bytes[i + 1]) << 8;
+            if (i + 2 < bytes.size()) chunk |= bytes[i + 2];
+
+            out += Alphabet[(chunk >> 18) & 63];
+            out += Alphabet[(chunk >> 12) & 63];
+            out += i + 1 < bytes.size() ? Alphabet[(chunk >> 6) & 63] : '=';
+            out += i + 2 < bytes.size() ? Alphabet[chunk & 63] : '=';
+        }
+        return out;
+    }
+
+    void writeProjects(const ProjectFiles& files) {
+        ProjectManager::ProjectMetadata metadata{ "Benchmark Project", "A project with a thumbnail and a large asset manifest.", "Empty", "1.0.0", 1700000000, 1700000500 };
+
+        std::vector<uint8_t> pixels(ThumbnailSize * ThumbnailSize * 4);
+        for (size_t i = 0; i < pixels.size(); ++i)
+            pixels[i] = static_cast<uint8_t>(i * 31);
+
+        std::vector<ProjectManager::AssetEntry> assets;
+        for (int i = 0; i < AssetCount; ++i)
+            assets.push_back({ std::format("Assets/Textures/Level{}/texture_{}.png", i / 100, i), uint64_t(i) * 4096, uint64_t(i) * 0x9E3779B97F4A7C15ull });
+
+        ProjectManager::ProjectFileWriter writer;
+        writer.setMetadata(metadata);
+        writer.setThumbnail(ThumbnailSize, ThumbnailSize, pixels);
+        writer.setAssetManifest(assets);
+
+        string error;
+        if (!writer.write(files.binary, error))
+            std::cerr << "Could not write " << files.binary << ": " << error << std::endl;
+
+        nlohmann::json document;
+        document["name"] = metadata.name;
+        document["description"] = metadata.description;
+        document["template"] = metadata.templateName;
+        document["engine_version"] = metadata.engineVersion;
+        document["created"] = metadata.createdTime;
+        document["modified"] = metadata.modifiedTime;
+        document["thumbnail"] = { { "width", ThumbnailSize }, { "height", ThumbnailSize }, { "pixels", base64(pixels) } };
+
+        nlohmann::json& manifest = document["assets"] = nlohmann::json::array();
+        for (const ProjectManager::AssetEntry& asset : assets)
+            manifest.push_back({ { "path", asset.path }, { "size", asset.size }, { "hash", asset.hash } });
+
+        std::ofstream(files.json, std::ios::binary) << document.dump();
+    }
+
+    ProjectManager::ProjectMetadata metadataFromJson(const nlohmann::json& document) {
+        return { document["name"], document["description"], document["template"], document["engine_version"], document["created"], document["modified"] };
+    }
+
+    nlohmann::json parseJsonFile(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        return nlohmann::json::parse(file);
+    }
+
+    template<typename Function>
+    void measure(Benchmark::Context& context, Function&& function) {
+        Benchmark::TempDirectory directory;
+        ProjectFiles files{ directory / "project.voltproj", directory / "project.json" };
+        writeProjects(files);
+
+        std::vector<double> samples;
+        samples.reserve(Iterations);
+
+        size_t checksum = 0;
+        for (int i = 0; i < Iterations; ++i) {
+            Benchmark::Clock::time_point start = Benchmark::Clock::now();
+            checksum += function(files);
+            samples.push_back(std::chrono::duration<double, std::micro>(Benchmark::Clock::now() - start).count());
+        }
+
+        std::error_code ec;
+        context.counter("binary_bytes", static_cast<double>(std::filesystem::file_size(files.binary, ec)));
+        context.counter("json_bytes", static_cast<double>(std::filesystem::file_size(files.json, ec)));
+        context.counter("checksum", static_cast<double>(checksum));
+        context.percentiles("open_us", std::move(samples));
+    }
+
+}
+
+VOLT_BENCHMARK(ProjectFileMetadataBinary) {
+    measure(context, [](const ProjectFiles& files) {
+        ProjectManager::ProjectFileReader reader;
+        string error;
+        if (!reader.open(files.binary, error))
+            return size_t(0);
+        std::optional<ProjectManager::ProjectMetadata> metadata = reader.readMetadata(error);
+        return metadata ? metadata->name.size() : 0;
+    });
+}
+
+VOLT_BENCHMARK(ProjectFileMetadataJson) {
+    measure(context, [](const ProjectFiles& files) {
+        return metadataFromJson(parseJsonFile(files.json)).name.size();
+    });
+}
+
+VOLT_BENCHMARK(ProjectFileFullBinary) {
+    measure(context, [](const ProjectFiles& files) {
+        ProjectManager::ProjectFileReader reader;
+        string error;
+        if (!reader.open(files.binary, error))
+            return size_t(0);
+
+        std::optional<ProjectManager::ProjectMetadata> metadata = reader.readMetadata(error);
+        std::optional<ProjectManager::ProjectThumbnail> thumbnail = reader.readThumbnail(error);
+        std::optional<std::vector<ProjectManager::AssetEntry>> assets = reader.readAssetManifest(error);
+        return (metadata ? metadata->name.size() : 0) + (thumbnail ? thumbnail->pixels.size() : 0) + (assets ? assets->size() : 0);
+    });
+}
+
+VOLT_BENCHMARK(ProjectFileFullJson) {
+    measure(context, [](const ProjectFiles& files) {
+        nlohmann::json document = parseJsonFile(files.json);
+        ProjectManager::ProjectMetadata metadata = metadataFromJson(document);
+
+        // Decoding the base64 thumbnail is left out; the JSON side is timed generously.
+        const string& pixels = document["thumbnail"]["pixels"].get_ref<const string&>();
+
+        std::vector<ProjectManager::AssetEntry> assets;
+        assets.reserve(document["assets"].size());
+        for (const nlohmann::json& asset : document["assets"])
+            assets.push_back({ asset["path"], asset["size"], asset["hash"] });
+
+        return metadata.name.size() + pixels.size() + assets.size();
+    });
+}
@@ -0,0 +1,69 @@
+#include "Benchmark.h"
+
+#include "nlohmann/json.hpp"
+
+#include "Core/Managers/ProjectManager/ProjectManager.h"
+
+// Per-frame cost of the project list labels. ShowMainPanel used to walk
+// projects.json and format "name: \"path\"" for every project on every frame;
+// the registry now formats a label once per change and the list only touches the
+// rows ImGuiListClipper hands it.
+
+namespace {
+
+    constexpr int ProjectCount = 1000;
+    constexpr int VisibleRows = 30;
+
+    class ProjectListFixture : public Benchmark::Fixture {
+    public:
+        Benchmark::TempDirectory directory;
+        nlohmann::json projectsFile;
+        ProjectManager::ProjectRegistry registry;
+        ProjectManager::ProjectListModel list;
+
+        void setUp() override {
+            for (int i = 0; i < ProjectCount; ++i)
+                projectsFile["projects"][std::format("Project {}", i)]["project_file"] = std::format("C:/Users/Developer/Documents/VoltLine Projects/Project {}/Project {}.voltproj", i, i);
+
+            registry.open(directory / "projects.vlreg");
+            registry.importJson(projectsFile);
+        }
+
+        void tearDown() override {
+            registry.close();
+        }
+    };
+
+}
+
+VOLT_BENCHMARK_F(ProjectListFixture, ProjectLabelsLegacy) {
+    context.measure("frame", [&] {
+        for (const auto& [name, value] : projectsFile["projects"].items()) {
+            string label = std::format("{}: {}", name, value["project_file"].dump());
+            Benchmark::doNotOptimize(label);
+        }
+    });
+    context.counter("projects", ProjectCount);
+}
+
+VOLT_BENCHMARK_F(ProjectListFixture, ProjectLabelsCached) {
+    context.measure("frame", [&] {
+        list.sync(registry);
+
+        const std::vector<const ProjectManager::ProjectRecord*>& entries = list.getEntries();
+        for (int i = 0; i < VisibleRows && i < static_cast<int>(entries.size()); ++i)
+            Benchmark::doNotOptimize(entries[i]->label.c_str());
+    });
+    context.counter("projects", ProjectCount);
+    context.counter("visible_rows", VisibleRows);
+}
+
+// What opening a project costs: a touch appended to the registry log, then the list rebuilt.
+VOLT_BENCHMARK_F(ProjectListFixture, ProjectLabelsAfterChange) {
+    int round = 0;
+    context.measure("change", [&] {
+        registry.touch(std::format("Project {}", round++ % ProjectCount));
+        list.sync(registry);
+        Benchmark::doNotOptimize(list.getEntries().front()->label);
+    });
+}
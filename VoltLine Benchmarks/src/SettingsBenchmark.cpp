@@ -0,0 +1,159 @@
+#include "Benchmark.h"
+
+#include "nlohmann/json.hpp"
+
+#include "Core/FileSystem/VirtualFileSystem.h"
+#include "Core/Managers/SettingsManager/HubSettings.h"
+#include "Core/Managers/SettingsManager/SettingsManager.h"
+
+// The settings load and hub file lookup, each next to the way the hub originally
+// did it: getFileContents (getline into a string) + json::parse on every access,
+// and an ifstream open to test for a file followed by building the bin/ fallback.
+
+namespace {
+
+    // What Window.cpp used to call for every settings lookup.
+    string getFileContentsLegacy(const char* filePath) {
+        std::ifstream file(filePath);
+        if (!file.is_open())
+            throw std::runtime_error("Could not open file: " + string(filePath));
+
+        string contents;
+        string line;
+        while (std::getline(file, line))
+            contents += line + '\n';
+
+        return contents;
+    }
+
+    bool fileExistsLegacy(const string& fileName) {
+        std::ifstream file(fileName);
+        return file.good();
+    }
+
+    string hubAssetPathLegacy(const string& fileName) {
+        if (fileExistsLegacy(fileName))
+            return fileName;
+
+        return "bin/" + string(CURRENT_PLAT) + "-" + string(CURRENT_CONF) + "/VoltLine Engine/" + fileName;
+    }
+
+    // A hub_settings.json of the size a user ends up with, laid out the way the hub
+    // reads it: the HubSettings sections (written through their schema) with a few
+    // dozen key bindings, and plugins entries as the plugin host parses them.
+    class SettingsFixture : public Benchmark::Fixture {
+    public:
+        Benchmark::TempDirectory directory;
+        std::filesystem::path settingsPath;
+
+        void setUp() override {
+            SettingsManager::HubSettings hub;
+            hub.engine.engineVersion = "1.0.0";
+            hub.engine.logFileDir = "logs/voltline.log";
+            hub.debugging.showFps = true;
+            hub.render.maxFps = 144;
+            hub.render.renderers = { "OpenGL" };
+            hub.projectRoots = std::vector<string>{ "C:/Users/Developer/Documents/VoltLine Projects", "D:/Work/Games" };
+
+            for (int i = 0; i < 48; ++i)
+                hub.keybinds.emplace_back(std::format("Action{}", i), std::format("CTRL+SHIFT+F{}", i % 12 + 1));
+
+            nlohmann::json settings;
+            SettingsManager::writeSettings(hub, settings);
+
+            for (int i = 0; i < 16; ++i) {
+                settings["plugins"][std::format("plugin_{}", i)] = {
+                    { "enabled", true },
+                    { "type", i % 2 ? "core" : "external" },
+                    { "location", std::format("plugins/plugin_{}", i) },
+                    { "primaryFile", std::format("plugin_{}.dll", i) },
+                    { "dependencies", i > 0 ? nlohmann::json::array({ std::format("plugin_{}", i - 1) }) : nlohmann::json::array() },
+                };
+            }
+
+            settingsPath = directory / "hub_settings.json";
+            std::ofstream(settingsPath, std::ios::binary) << settings.dump(4);
+        }
+    };
+
+}
+
+VOLT_BENCHMARK_F(SettingsFixture, SettingsLoadLegacy) {
+    string path = settingsPath.string();
+    context.measure("load", [&] {
+        nlohmann::json settings = nlohmann::json::parse(getFileContentsLegacy(path.c_str()));
+        Benchmark::doNotOptimize(settings);
+    });
+}
+
+VOLT_BENCHMARK_F(SettingsFixture, SettingsLoad) {
+    context.measure("load", [&] {
+        string text;
+        SettingsManager::readWholeFile(settingsPath, text);
+        nlohmann::json settings = nlohmann::json::parse(text);
+        Benchmark::doNotOptimize(settings);
+    });
+}
+
+// What a settings lookup costs now that the document is cached: a poll that finds nothing changed.
+VOLT_BENCHMARK_F(SettingsFixture, SettingsStorePoll) {
+    SettingsManager::SettingsStore store(settingsPath.string());
+    context.measure("poll", [&] {
+        bool reloaded = store.poll();
+        Benchmark::doNotOptimize(reloaded);
+        Benchmark::doNotOptimize(store.get());
+    });
+}
+
+VOLT_BENCHMARK(HubAssetPathLegacy) {
+    context.measure("miss", [] {
+        string path = hubAssetPathLegacy("project_icon.png");
+        Benchmark::doNotOptimize(path);
+    });
+}
+
+// The same lookup through the virtual filesystem: by name (a hash lookup once the
+// path is interned) and by the interned handle.
+VOLT_BENCHMARK(HubAssetPathVfs) {
+    FileSystem::VirtualFileSystem& fileSystem = FileSystem::vfs();
+
+    context.measure("by_name", [&] {
+        const std::filesystem::path& path = fileSystem.resolve("hub://project_icon.png");
+        Benchmark::doNotOptimize(path);
+    });
+
+    FileSystem::PathHandle handle = fileSystem.intern("hub://project_icon.png");
+    context.measure("by_handle", [&] {
+        const std::filesystem::path& path = fileSystem.resolve(handle);
+        Benchmark::doNotOptimize(path);
+    });
+}
+
+// Reading one setting in a frame: the chained JSON lookups the settings popup used
+// to do, against the parsed HubSettings field. Also what parsing into it costs,
+// which now happens once per file change.
+VOLT_BENCHMARK_F(SettingsFixture, SettingsFieldAccess) {
+    string text;
+    SettingsManager::readWholeFile(settingsPath, text);
+    nlohmann::json document = nlohmann::json::parse(text);
+
+    context.measure("json", [&] {
+        string editor = document.at("engine_settings").at("preferred_editor_win");
+        int maxFps = document.at("render_settings").at("max_fps");
+        Benchmark::doNotOptimize(editor);
+        Benchmark::doNotOptimize(maxFps);
+    });
+
+    SettingsManager::SchemaReport report;
+    SettingsManager::HubSettings settings = SettingsManager::parseSettings<SettingsManager::HubSettings>(document, report);
+    context.measure("typed", [&] {
+        Benchmark::doNotOptimize(settings.engine.preferredEditorWin);
+        Benchmark::doNotOptimize(settings.render.maxFps);
+    });
+
+    context.measure("parse", [&] {
+        SettingsManager::SchemaReport parseReport;
+        SettingsManager::HubSettings parsed = SettingsManager::parseSettings<SettingsManager::HubSettings>(document, parseReport);
+        Benchmark::doNotOptimize(parsed);
+    });
+}
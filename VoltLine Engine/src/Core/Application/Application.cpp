@@ -1,12 +1,131 @@
 #include "Core/Window/Window.h"
+#include "Core/Profiler/Profiler.h"
+#include "Core/Managers/ProjectManager/ProjectFile.h"
+#include "Core/FileSystem/AssetPack.h"
 
-int main()
+// --validate-project <file>: checks a .voltproj and prints what is wrong with it.
+static int validateProject(const std::filesystem::path& path)
 {
+	ProjectManager::ValidationReport report = ProjectManager::validateProjectFile(path);
+
+	for (const string& error : report.errors)
+		std::cout << "error: " << error << std::endl;
+	for (const string& warning : report.warnings)
+		std::cout << "warning: " << warning << std::endl;
+
+	std::cout << path.string() << (report.ok() ? ": ok" : ": invalid") << std::endl;
+	return report.ok() ? 0 : 1;
+}
+
+// --validate-pack <file>: checks a .vpak, including every entry's checksum.
+static int validatePack(const std::filesystem::path& path)
+{
+	FileSystem::PackValidationReport report = FileSystem::validateAssetPack(path);
+
+	for (const string& error : report.errors)
+		std::cout << "error: " << error << std::endl;
+	for (const string& warning : report.warnings)
+		std::cout << "warning: " << warning << std::endl;
+
+	std::cout << path.string() << (report.ok() ? ": ok" : ": invalid") << std::endl;
+	return report.ok() ? 0 : 1;
+}
+
+// --pack-assets <dir> <out.vpak> [--compress none|lz4]: packs a directory of hub assets.
+static int packAssets(const std::filesystem::path& directory, const std::filesystem::path& output, std::string_view compressionName)
+{
+	std::optional<FileSystem::PackFormat::Compression> compression = FileSystem::PackFormat::parseCompression(compressionName);
+	if (!compression)
+	{
+		std::cout << "error: unknown compression '" << compressionName << "' (none, lz4)" << std::endl;
+		return 1;
+	}
+
+	string error;
+	std::optional<size_t> entries = FileSystem::packDirectory(directory, output, *compression, error);
+	if (!entries)
+	{
+		std::cout << "error: " << error << std::endl;
+		return 1;
+	}
+
+	std::cout << output.string() << ": " << *entries << " entries" << std::endl;
+	return 0;
+}
+
+// "project,settings" -> { "project", "settings" }
+static std::vector<string> splitList(std::string_view list)
+{
+	std::vector<string> items;
+	while (!list.empty())
+	{
+		size_t comma = list.find(',');
+		std::string_view item = list.substr(0, comma);
+		if (!item.empty())
+			items.emplace_back(item);
+		list = comma == std::string_view::npos ? std::string_view() : list.substr(comma + 1);
+	}
+	return items;
+}
+
+int main(int argc, char** argv)
+{
+	// --trace <file>: record a Chrome trace of the whole run (builds with VOLT_PROFILE=1).
+	string tracePath;
+	// --headless [--frames N] [--frames-per-screen N] [--screens a,b,c] [--report file]:
+	// run without a visible window for N frames and write a timing report (headless_report.json by default).
+	Window::HeadlessOptions headless;
+	std::filesystem::path packDirectory, packOutput;
+	string packCompression = "none";
+	// --stock-ui-renderer: draw ImGui with imgui_impl_opengl3, to compare against the streaming renderer.
+	bool stockUiRenderer = false;
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string_view arg = argv[i];
+		if (arg == "--trace" && i + 1 < argc)
+			tracePath = argv[++i];
+		else if (arg == "--validate-project" && i + 1 < argc)
+			return validateProject(argv[++i]);
+		else if (arg == "--validate-pack" && i + 1 < argc)
+			return validatePack(argv[++i]);
+		else if (arg == "--pack-assets" && i + 2 < argc)
+		{
+			packDirectory = argv[++i];
+			packOutput = argv[++i];
+		}
+		else if (arg == "--compress" && i + 1 < argc)
+			packCompression = argv[++i];
+		else if (arg == "--headless")
+			headless.enabled = true;
+		else if (arg == "--frames" && i + 1 < argc)
+			headless.frames = std::max(std::atoi(argv[++i]), 1);
+		else if (arg == "--frames-per-screen" && i + 1 < argc)
+			headless.framesPerScreen = std::max(std::atoi(argv[++i]), 1);
+		else if (arg == "--screens" && i + 1 < argc)
+			headless.screens = splitList(argv[++i]);
+		else if (arg == "--report" && i + 1 < argc)
+			headless.reportPath = argv[++i];
+		else if (arg == "--stock-ui-renderer")
+			stockUiRenderer = true;
+	}
+
+	if (!packOutput.empty())
+		return packAssets(packDirectory, packOutput, packCompression);
+
+	if (!tracePath.empty())
+		VOLT_PROFILE_BEGIN_SESSION("VoltLine Hub", tracePath);
+
 	Window::Window window;
 
 	window.windowW = 1280;
 	window.windowH = 720;
 	window.windowTitle = "VoltLine Hub";
+	window.headless = headless;
+	window.stockUiRenderer = stockUiRenderer;
+
+	int result = window.Init();
+
+	VOLT_PROFILE_END_SESSION();
 
-	return window.Init();
-}
\ No newline at end of file
+	return result;
+}
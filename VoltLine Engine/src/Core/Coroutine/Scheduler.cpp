@@ -0,0 +1,268 @@
+#include "Scheduler.h"
+
+#include "Core/Profiler/Profiler.h"
+#include "Core/Logging/HubLogger.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+#endif
+
+namespace Coroutine {
+
+    namespace {
+
+        // Returns a process id/handle, or -1.
+        int64_t launchProcess(const string& commandLine) {
+#ifdef _WIN32
+            string command = "cmd.exe /C " + commandLine;
+
+            STARTUPINFOA startupInfo{};
+            startupInfo.cb = sizeof(startupInfo);
+            PROCESS_INFORMATION processInfo{};
+
+            if (!CreateProcessA(nullptr, command.data(), nullptr, nullptr, FALSE, CREATE_NO_WINDOW, nullptr, nullptr, &startupInfo, &processInfo))
+                return -1;
+
+            CloseHandle(processInfo.hThread);
+            return reinterpret_cast<int64_t>(processInfo.hProcess);
+#else
+            pid_t pid;
+            const char* shell = "/bin/sh";
+            char* arguments[] = { const_cast<char*>("sh"), const_cast<char*>("-c"), const_cast<char*>(commandLine.c_str()), nullptr };
+
+            if (posix_spawn(&pid, shell, nullptr, nullptr, arguments, environ) != 0)
+                return -1;
+
+            return pid;
+#endif
+        }
+
+        // Non-blocking; true once the process has exited.
+        bool pollProcess(int64_t process, int& exitCode) {
+#ifdef _WIN32
+            HANDLE handle = reinterpret_cast<HANDLE>(process);
+            DWORD wait = WaitForSingleObject(handle, 0);
+            if (wait == WAIT_TIMEOUT)
+                return false;
+
+            // A failed wait (a bad or closed handle) won't succeed later either.
+            DWORD code = 0;
+            if (wait != WAIT_OBJECT_0 || !GetExitCodeProcess(handle, &code))
+                code = static_cast<DWORD>(-1);
+
+            CloseHandle(handle);
+            exitCode = static_cast<int>(code);
+            return true;
+#else
+            int status = 0;
+            pid_t result = waitpid(static_cast<pid_t>(process), &status, WNOHANG);
+            if (result == 0)
+                return false;
+
+            exitCode = result > 0 && WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+            return true;
+#endif
+        }
+
+        void releaseProcess(int64_t process) {
+#ifdef _WIN32
+            CloseHandle(reinterpret_cast<HANDLE>(process));
+#endif
+        }
+
+    }
+
+    namespace Detail {
+
+        void onDetachedTaskFinished(std::coroutine_handle<> handle, std::exception_ptr exception) noexcept {
+            mainScheduler().liveTasks.erase(handle.address());
+
+            if (!exception)
+                return;
+
+            try {
+                std::rethrow_exception(exception);
+            }
+            catch (const std::exception& e) {
+                cf_Sink::logger->error(std::format("Unhandled exception in hub task: {}", e.what()));
+            }
+            catch (...) {
+                cf_Sink::logger->error("Unhandled exception in hub task.");
+            }
+        }
+
+    }
+
+    Scheduler::~Scheduler() {
+        shutdown();
+    }
+
+    void Scheduler::spawn(Task<void> task) {
+        std::coroutine_handle<> handle = task.release();
+        if (!handle)
+            return;
+
+        liveTasks.insert(handle.address());
+        readyQueue.push_back(handle);
+    }
+
+    void Scheduler::tick() {
+        VOLT_PROFILE_SCOPE("Coroutine::Scheduler::tick");
+
+        // Whatever is resumed below and awaits nextFrame() again lands in a fresh
+        // queue, so it runs next tick rather than spinning here.
+        std::vector<std::coroutine_handle<>> frame = std::exchange(nextFrameQueue, {});
+        readyQueue.insert(readyQueue.end(), frame.begin(), frame.end());
+
+        {
+            std::lock_guard<std::mutex> lock(postedMutex);
+            readyQueue.insert(readyQueue.end(), posted.begin(), posted.end());
+            posted.clear();
+        }
+
+        for (size_t i = 0; i < processWaits.size();) {
+            ProcessWait& wait = processWaits[i];
+            if (pollProcess(wait.process, *wait.exitCode)) {
+                readyQueue.push_back(wait.handle);
+                wait = processWaits.back();
+                processWaits.pop_back();
+            }
+            else {
+                ++i;
+            }
+        }
+
+        timers.advance();
+        resumeAll(readyQueue);
+    }
+
+    bool Scheduler::hasPendingWork() const {
+        return !readyQueue.empty() || !nextFrameQueue.empty() || !timers.empty();
+    }
+
+    void Scheduler::resumeAfter(std::chrono::milliseconds delay, std::coroutine_handle<> handle) {
+        timers.schedule(delay, [this, handle]() { readyQueue.push_back(handle); });
+    }
+
+    void Scheduler::resumeWhenExited(int64_t process, int* exitCode, std::coroutine_handle<> handle) {
+        processWaits.push_back({ process, exitCode, handle });
+    }
+
+    void Scheduler::runInBackground(std::function<void()> job) {
+        {
+            std::lock_guard<std::mutex> lock(workMutex);
+            if (!worker.joinable() && !stopping)
+                worker = std::thread(&Scheduler::runWorker, this);
+
+            work.push_back(std::move(job));
+        }
+        workAvailable.notify_one();
+    }
+
+    void Scheduler::post(std::coroutine_handle<> handle) {
+        {
+            std::lock_guard<std::mutex> lock(postedMutex);
+            posted.push_back(handle);
+        }
+
+        if (wakeCallback)
+            wakeCallback();
+    }
+
+    void Scheduler::shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(workMutex);
+            stopping = true;
+            work.clear();
+        }
+        workAvailable.notify_one();
+        if (worker.joinable())
+            worker.join();
+
+        for (const ProcessWait& wait : processWaits)
+            releaseProcess(wait.process);
+
+        readyQueue.clear();
+        nextFrameQueue.clear();
+        processWaits.clear();
+        posted.clear();
+        timers = Threading::TimerWheel();
+
+        // Destroying a root also destroys every task it is awaiting.
+        std::unordered_set<void*> roots = std::exchange(liveTasks, {});
+        for (void* address : roots)
+            std::coroutine_handle<>::from_address(address).destroy();
+    }
+
+    void Scheduler::runWorker() {
+        VOLT_PROFILE_THREAD("Coroutine I/O");
+
+        while (true) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(workMutex);
+                workAvailable.wait(lock, [&] { return stopping || !work.empty(); });
+                if (stopping)
+                    return;
+
+                job = std::move(work.front());
+                work.pop_front();
+            }
+
+            job();
+        }
+    }
+
+    void Scheduler::resumeAll(std::vector<std::coroutine_handle<>>& handles) {
+        // Resuming can make more handles ready (a timer firing inside a task, a
+        // task finishing and resuming its parent); drain until nothing is left.
+        while (!handles.empty()) {
+            std::vector<std::coroutine_handle<>> batch = std::exchange(handles, {});
+            for (std::coroutine_handle<> handle : batch)
+                handle.resume();
+        }
+    }
+
+    Task<std::optional<string>> readFile(std::filesystem::path path) {
+        auto read = [path]() -> std::optional<string> {
+            std::ifstream file(path, std::ios::in | std::ios::binary);
+            if (!file.is_open())
+                return std::nullopt;
+
+            std::ostringstream contents;
+            contents << file.rdbuf();
+            return contents.str();
+        };
+
+        std::optional<string> contents = co_await runInBackground(std::move(read));
+        co_return contents;
+    }
+
+    Task<int> waitForProcess(string commandLine) {
+        int64_t process = launchProcess(commandLine);
+        if (process < 0)
+            co_return -1;
+
+        struct Awaiter {
+            int64_t process;
+            int exitCode = -1;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) { mainScheduler().resumeWhenExited(process, &exitCode, handle); }
+            int await_resume() const noexcept { return exitCode; }
+        };
+
+        int exitCode = co_await Awaiter{ process };
+        co_return exitCode;
+    }
+
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "pch.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <unordered_set>
+
+#include "Core/Coroutine/Task.h"
+#include "Core/Threading/TimerWheel.h"
+
+namespace Coroutine {
+
+    // Main-loop executor for coroutine tasks. Everything a task does between two
+    // co_awaits runs on the main thread inside tick(), so tasks may use ImGui and
+    // GL freely. Waiting (delays, frames, child processes, background I/O) never
+    // blocks the frame.
+    class Scheduler {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        Scheduler() = default;
+        ~Scheduler();
+
+        Scheduler(const Scheduler&) = delete;
+        Scheduler& operator=(const Scheduler&) = delete;
+
+        // Starts a task on the next tick; the scheduler owns it from here on.
+        void spawn(Task<void> task);
+
+        // Resumes everything that became ready. Call once per frame on the main
+        // thread, inside the ImGui frame.
+        void tick();
+
+        // True while any task is waiting on a frame or a timer, so the frame pacer
+        // shouldn't go idle. Child processes don't count: the idle loop still ticks
+        // often enough to notice them exit.
+        bool hasPendingWork() const;
+
+        // Called from other threads when background work finishes, to wake the main
+        // loop (glfwPostEmptyEvent).
+        void setWakeCallback(std::function<void()> callback) { wakeCallback = std::move(callback); }
+
+        // Destroys every task that is still suspended and stops the I/O thread.
+        void shutdown();
+
+        // Awaitable plumbing, used by nextFrame(), delay() and friends.
+        void resumeNextFrame(std::coroutine_handle<> handle) { nextFrameQueue.push_back(handle); }
+        void resumeAfter(std::chrono::milliseconds delay, std::coroutine_handle<> handle);
+        void resumeWhenExited(int64_t process, int* exitCode, std::coroutine_handle<> handle);
+        void runInBackground(std::function<void()> work);
+        // Thread-safe.
+        void post(std::coroutine_handle<> handle);
+
+    private:
+        friend void Detail::onDetachedTaskFinished(std::coroutine_handle<>, std::exception_ptr) noexcept;
+
+        struct ProcessWait {
+            int64_t process;
+            int* exitCode;
+            std::coroutine_handle<> handle;
+        };
+
+        std::vector<std::coroutine_handle<>> readyQueue;
+        std::vector<std::coroutine_handle<>> nextFrameQueue;
+        std::vector<ProcessWait> processWaits;
+        Threading::TimerWheel timers;
+        std::unordered_set<void*> liveTasks;
+
+        std::mutex postedMutex;
+        std::vector<std::coroutine_handle<>> posted;
+        std::function<void()> wakeCallback;
+
+        // Background I/O thread, started on first use.
+        std::mutex workMutex;
+        std::condition_variable workAvailable;
+        std::deque<std::function<void()>> work;
+        std::thread worker;
+        bool stopping = false;
+
+        void runWorker();
+        void resumeAll(std::vector<std::coroutine_handle<>>& handles);
+    };
+
+    inline Scheduler& mainScheduler() {
+        static Scheduler scheduler;
+        return scheduler;
+    }
+
+    inline void spawn(Task<void> task) {
+        mainScheduler().spawn(std::move(task));
+    }
+
+    // co_await nextFrame(): resume on the next tick.
+    inline auto nextFrame() {
+        struct Awaiter {
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) { mainScheduler().resumeNextFrame(handle); }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{};
+    }
+
+    // co_await delay(200ms): resume on the first tick after the delay.
+    inline auto delay(std::chrono::milliseconds duration) {
+        struct Awaiter {
+            std::chrono::milliseconds duration;
+
+            bool await_ready() const noexcept { return duration.count() <= 0; }
+            void await_suspend(std::coroutine_handle<> handle) { mainScheduler().resumeAfter(duration, handle); }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{ duration };
+    }
+
+    // co_await runInBackground(fn): runs fn on the background I/O thread and resumes
+    // on the main loop with its result (or rethrows what it threw).
+    template<typename Function>
+    auto runInBackground(Function function) {
+        using Result = std::invoke_result_t<Function>;
+
+        struct Awaiter {
+            Function function;
+            std::conditional_t<std::is_void_v<Result>, bool, std::optional<Result>> result{};
+            std::exception_ptr exception;
+
+            bool await_ready() const noexcept { return false; }
+
+            void await_suspend(std::coroutine_handle<> handle) {
+                mainScheduler().runInBackground([this, handle]() {
+                    try {
+                        if constexpr (std::is_void_v<Result>)
+                            function();
+                        else
+                            result.emplace(function());
+                    }
+                    catch (...) {
+                        exception = std::current_exception();
+                    }
+                    mainScheduler().post(handle);
+                });
+            }
+
+            Result await_resume() {
+                if (exception)
+                    std::rethrow_exception(exception);
+                if constexpr (!std::is_void_v<Result>)
+                    return std::move(*result);
+            }
+        };
+
+        return Awaiter{ std::move(function) };
+    }
+
+    // Reads a whole file off the main thread. Empty optional if it can't be read.
+    Task<std::optional<string>> readFile(std::filesystem::path path);
+
+    // Starts commandLine through the platform shell (cmd.exe /C or /bin/sh -c), as
+    // system() would, and resumes with its exit code once it exits; -1 if it could
+    // not be started.
+    Task<int> waitForProcess(string commandLine);
+
+}
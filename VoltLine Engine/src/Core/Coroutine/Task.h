@@ -0,0 +1,161 @@
+#pragma once
+
+#include "pch.h"
+
+#include <cassert>
+#include <coroutine>
+#include <exception>
+#include <optional>
+
+namespace Coroutine {
+
+    template<typename T = void>
+    class Task;
+
+    namespace Detail {
+
+        // Called when a detached task finishes; implemented by the scheduler so it can
+        // stop tracking the coroutine and report uncaught exceptions.
+        void onDetachedTaskFinished(std::coroutine_handle<> handle, std::exception_ptr exception) noexcept;
+
+        struct PromiseBase {
+            std::coroutine_handle<> continuation = std::noop_coroutine();
+            std::exception_ptr exception;
+            bool detached = false;
+
+            struct FinalAwaiter {
+                bool await_ready() noexcept { return false; }
+
+                template<typename Promise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+                    PromiseBase& promise = handle.promise();
+                    if (promise.detached) {
+                        onDetachedTaskFinished(handle, promise.exception);
+                        handle.destroy();
+                        return std::noop_coroutine();
+                    }
+
+                    // Symmetric transfer straight back into whoever co_awaited us.
+                    return promise.continuation;
+                }
+
+                void await_resume() noexcept {}
+            };
+
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            FinalAwaiter final_suspend() noexcept { return {}; }
+            void unhandled_exception() noexcept { exception = std::current_exception(); }
+        };
+
+        template<typename T>
+        struct Promise : PromiseBase {
+            std::optional<T> value;
+
+            Task<T> get_return_object() noexcept;
+
+            template<typename U>
+            void return_value(U&& result) { value.emplace(std::forward<U>(result)); }
+
+            T takeResult() {
+                if (exception)
+                    std::rethrow_exception(exception);
+                return std::move(*value);
+            }
+        };
+
+        template<>
+        struct Promise<void> : PromiseBase {
+            Task<void> get_return_object() noexcept;
+
+            void return_void() noexcept {}
+
+            void takeResult() {
+                if (exception)
+                    std::rethrow_exception(exception);
+            }
+        };
+
+    }
+
+    // Lazily started coroutine. A Task runs when it is co_awaited from another task
+    // (resuming the awaiter when it finishes) or when it is handed to
+    // Scheduler::spawn, which runs it on the main loop and owns it from then on.
+    //
+    //     Coroutine::Task<> openSettings() {
+    //         co_await Coroutine::runInBackground([] { SettingsManager::settingsWriter().flush(); });
+    //         int exitCode = co_await Coroutine::waitForProcess(command);
+    //     }
+    template<typename T>
+    class [[nodiscard]] Task {
+    public:
+        using promise_type = Detail::Promise<T>;
+        using Handle = std::coroutine_handle<promise_type>;
+
+        Task() = default;
+        explicit Task(Handle handle) : handle(handle) {}
+
+        Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+        Task& operator=(Task&& other) noexcept {
+            if (this != &other) {
+                if (handle)
+                    handle.destroy();
+                handle = std::exchange(other.handle, nullptr);
+            }
+            return *this;
+        }
+
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        ~Task() {
+            if (handle)
+                handle.destroy();
+        }
+
+        bool valid() const { return static_cast<bool>(handle); }
+
+        // An empty (default-constructed or moved-from) task has no result to wait for.
+        auto operator co_await() && noexcept {
+            assert(handle && "co_await on an empty Task");
+
+            struct Awaiter {
+                Handle handle;
+
+                bool await_ready() const noexcept { return handle.done(); }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                    handle.promise().continuation = awaiting;
+                    return handle;
+                }
+
+                T await_resume() { return handle.promise().takeResult(); }
+            };
+
+            return Awaiter{ handle };
+        }
+
+        // Gives up ownership; the coroutine frame destroys itself when it finishes.
+        Handle release() noexcept {
+            if (handle)
+                handle.promise().detached = true;
+            return std::exchange(handle, nullptr);
+        }
+
+    private:
+        Handle handle = nullptr;
+    };
+
+    namespace Detail {
+
+        template<typename T>
+        Task<T> Promise<T>::get_return_object() noexcept {
+            return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+        }
+
+        inline Task<void> Promise<void>::get_return_object() noexcept {
+            return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+        }
+
+    }
+
+}
@@ -0,0 +1,466 @@
+#include "AssetPack.h"
+
+#include <algorithm>
+#include <bit>
+
+#include "Core/FileSystem/AtomicFile.h"
+#include "Core/FileSystem/Lz4.h"
+#include "Core/Profiler/Profiler.h"
+
+namespace FileSystem {
+
+    using namespace PackFormat;
+
+    namespace {
+
+        uint64_t alignUp(uint64_t value) {
+            return (value + EntryAlignment - 1) & ~(EntryAlignment - 1);
+        }
+
+        // FNV-1a, the same checksum .voltproj sections use.
+        uint32_t checksum(std::span<const uint8_t> bytes, uint32_t hash = 2166136261u) {
+            for (uint8_t byte : bytes) {
+                hash ^= byte;
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+
+        uint32_t headerChecksum(PackHeader header) {
+            header.headerChecksum = 0;
+            return checksum({ reinterpret_cast<const uint8_t*>(&header), sizeof(header) });
+        }
+
+        bool samePath(std::string_view stored, std::string_view path) {
+            if (stored.size() != path.size())
+                return false;
+            for (size_t i = 0; i < path.size(); ++i) {
+                char c = path[i] == '\\' ? '/' : path[i];
+                if (stored[i] != c)
+                    return false;
+            }
+            return true;
+        }
+
+        string normalizedPath(std::string_view path) {
+            string normalized(path);
+            std::replace(normalized.begin(), normalized.end(), '\\', '/');
+            return normalized;
+        }
+
+        bool decompress(const PackEntry& entry, std::span<const uint8_t> stored, std::vector<uint8_t>& out, string& error) {
+            switch (static_cast<Compression>(entry.compression)) {
+            case Compression::LZ4:
+                out.resize(static_cast<size_t>(entry.size));
+                if (!lz4Decompress(stored, out)) {
+                    error = "LZ4 data is damaged";
+                    return false;
+                }
+                return true;
+            case Compression::Zstd:
+                error = "entry is zstd compressed, which this build can't decode";
+                return false;
+            default:
+                error = std::format("unknown compression {}", entry.compression);
+                return false;
+            }
+        }
+
+    }
+
+    uint64_t PackFormat::hashPath(std::string_view path) {
+        uint64_t hash = 14695981039346656037ull;
+        for (char c : path) {
+            hash ^= static_cast<uint8_t>(c == '\\' ? '/' : c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    string PackFormat::compressionName(Compression compression) {
+        switch (compression) {
+        case Compression::None: return "none";
+        case Compression::LZ4: return "lz4";
+        case Compression::Zstd: return "zstd";
+        }
+        return std::format("unknown ({})", static_cast<uint32_t>(compression));
+    }
+
+    std::optional<Compression> PackFormat::parseCompression(std::string_view name) {
+        for (Compression compression : { Compression::None, Compression::LZ4, Compression::Zstd }) {
+            if (name == compressionName(compression))
+                return compression;
+        }
+        return std::nullopt;
+    }
+
+    AssetData AssetData::view(std::span<const uint8_t> bytes) {
+        AssetData data;
+        data.contents = bytes;
+        return data;
+    }
+
+    AssetData AssetData::owned(std::vector<uint8_t> bytes) {
+        AssetData data;
+        data.buffer = std::move(bytes);
+        data.contents = data.buffer;
+        return data;
+    }
+
+    AssetData AssetData::mapped(MappedFile file) {
+        AssetData data;
+        data.file = std::move(file);
+        data.contents = data.file.bytes();
+        return data;
+    }
+
+    bool AssetPackReader::open(const std::filesystem::path& path, string& error) {
+        VOLT_PROFILE_SCOPE("AssetPackReader::open");
+
+        close();
+
+        if (!file.open(path)) {
+            error = std::format("could not open {}", path.string());
+            return false;
+        }
+
+        std::span<const uint8_t> bytes = file.bytes();
+        if (bytes.size() < sizeof(PackHeader)) {
+            error = "file is too small to be a VoltLine asset pack";
+            close();
+            return false;
+        }
+
+        std::memcpy(&header, bytes.data(), sizeof(PackHeader));
+
+        string problem;
+        if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0)
+            problem = "not a VoltLine asset pack";
+        else if (header.versionMajor != VersionMajor)
+            problem = std::format("unsupported asset pack version {}.{}", header.versionMajor, header.versionMinor);
+        else if (header.headerChecksum != headerChecksum(header))
+            problem = "header checksum mismatch";
+        else if (header.fileSize != bytes.size())
+            problem = std::format("file is {} bytes, header says {}", bytes.size(), header.fileSize);
+        else if (!std::has_single_bit(header.slotCount) || header.entryCount > header.slotCount / 2)
+            problem = std::format("{} entries don't fit a table of {} slots", header.entryCount, header.slotCount);
+        else if (header.headerSize < sizeof(PackHeader) || header.tableOffset < header.headerSize || header.tableOffset % alignof(PackEntry) != 0
+            || header.tableOffset > bytes.size() || header.slotCount > (bytes.size() - header.tableOffset) / sizeof(PackEntry))
+            problem = "table of contents is out of bounds";
+        else if (header.namesOffset > bytes.size() || header.namesSize > bytes.size() - header.namesOffset)
+            problem = "names are out of bounds";
+
+        if (!problem.empty()) {
+            error = std::move(problem);
+            close();
+            return false;
+        }
+
+        // The mapping is page aligned and tableOffset is checked above, so the table
+        // is used in place.
+        slots = { reinterpret_cast<const PackEntry*>(bytes.data() + header.tableOffset), header.slotCount };
+        names = { reinterpret_cast<const char*>(bytes.data() + header.namesOffset), static_cast<size_t>(header.namesSize) };
+
+        uint32_t tableChecksum = checksum({ reinterpret_cast<const uint8_t*>(slots.data()), slots.size_bytes() });
+        if (checksum({ reinterpret_cast<const uint8_t*>(names.data()), names.size() }, tableChecksum) != header.tableChecksum) {
+            error = "table of contents checksum mismatch";
+            close();
+            return false;
+        }
+
+        // find() relies on an empty slot to end a probe, which only holds if the
+        // table really has entryCount entries.
+        uint64_t usedSlots = 0;
+        for (const PackEntry& entry : slots) {
+            if (entry.nameLength == 0)
+                continue;
+            ++usedSlots;
+            if (entry.nameOffset > names.size() || entry.nameLength > names.size() - entry.nameOffset) {
+                error = "entry name is out of bounds";
+                close();
+                return false;
+            }
+            if (entry.offset > bytes.size() || entry.storedSize > bytes.size() - entry.offset) {
+                error = std::format("{} is out of bounds", entryName(entry));
+                close();
+                return false;
+            }
+            uint64_t maxSize = entry.compression == static_cast<uint32_t>(Compression::None) ? entry.storedSize : entry.storedSize * MaxCompressionRatio;
+            if (entry.size > maxSize) {
+                error = std::format("{} claims {} bytes from {} stored", entryName(entry), entry.size, entry.storedSize);
+                close();
+                return false;
+            }
+        }
+
+        if (usedSlots != header.entryCount) {
+            error = std::format("table holds {} entries, header says {}", usedSlots, header.entryCount);
+            close();
+            return false;
+        }
+
+        return true;
+    }
+
+    void AssetPackReader::close() {
+        file.close();
+        header = {};
+        slots = {};
+        names = {};
+    }
+
+    const PackEntry* AssetPackReader::find(std::string_view path) const {
+        if (slots.empty())
+            return nullptr;
+
+        uint64_t hash = hashPath(path);
+        size_t mask = slots.size() - 1;
+
+        // At most half the slots are used, so probing always reaches an empty one.
+        for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+            const PackEntry& entry = slots[slot];
+            if (entry.nameLength == 0)
+                return nullptr;
+            if (entry.pathHash == hash && samePath(entryName(entry), path))
+                return &entry;
+        }
+    }
+
+    std::string_view AssetPackReader::entryName(const PackEntry& entry) const {
+        return names.substr(entry.nameOffset, entry.nameLength);
+    }
+
+    std::span<const uint8_t> AssetPackReader::storedBytes(const PackEntry& entry) const {
+        return file.bytes().subspan(static_cast<size_t>(entry.offset), static_cast<size_t>(entry.storedSize));
+    }
+
+    std::optional<AssetData> AssetPackReader::read(const PackEntry& entry, string& error) const {
+        std::span<const uint8_t> stored = storedBytes(entry);
+        if (entry.compression == static_cast<uint32_t>(Compression::None))
+            return AssetData::view(stored);
+
+        VOLT_PROFILE_SCOPE("AssetPackReader::decompress");
+
+        std::vector<uint8_t> bytes;
+        if (!decompress(entry, stored, bytes, error)) {
+            error = std::format("{}: {}", entryName(entry), error);
+            return std::nullopt;
+        }
+        return AssetData::owned(std::move(bytes));
+    }
+
+    std::optional<AssetData> AssetPackReader::read(std::string_view path, string& error) const {
+        const PackEntry* entry = find(path);
+        if (!entry) {
+            error = std::format("{} is not in the pack", path);
+            return std::nullopt;
+        }
+        return read(*entry, error);
+    }
+
+    bool AssetPackWriter::add(std::string_view path, std::span<const uint8_t> bytes, Compression compression, string& error) {
+        if (path.empty() || path.size() > UINT32_MAX) {
+            error = "entry path must not be empty";
+            return false;
+        }
+
+        Entry entry{ normalizedPath(path), {}, bytes.size(), Compression::None };
+
+        switch (compression) {
+        case Compression::None:
+            break;
+        case Compression::LZ4: {
+            std::vector<uint8_t> compressed = lz4Compress(bytes);
+            if (compressed.size() < bytes.size() - bytes.size() / 8) {
+                entry.stored = std::move(compressed);
+                entry.compression = Compression::LZ4;
+            }
+            break;
+        }
+        default:
+            error = std::format("{} compression is not available in this build", compressionName(compression));
+            return false;
+        }
+
+        if (entry.compression == Compression::None)
+            entry.stored.assign(bytes.begin(), bytes.end());
+
+        auto existing = std::find_if(entries.begin(), entries.end(), [&](const Entry& other) { return other.path == entry.path; });
+        if (existing != entries.end())
+            *existing = std::move(entry);
+        else
+            entries.push_back(std::move(entry));
+        return true;
+    }
+
+    std::vector<uint8_t> AssetPackWriter::build() const {
+        uint32_t slotCount = std::bit_ceil(std::max<uint32_t>(static_cast<uint32_t>(entries.size()) * 2, 1));
+        std::vector<PackEntry> table(slotCount, PackEntry{});
+
+        string names;
+        for (const Entry& entry : entries)
+            names += entry.path;
+
+        uint64_t namesOffset = sizeof(PackHeader) + table.size() * sizeof(PackEntry);
+        uint64_t offset = alignUp(namesOffset + names.size());
+        uint32_t nameOffset = 0;
+
+        // Data goes out in insertion order; only the table is hashed.
+        std::vector<uint64_t> offsets(entries.size());
+        for (size_t i = 0; i < entries.size(); ++i) {
+            const Entry& entry = entries[i];
+            uint64_t hash = hashPath(entry.path);
+
+            size_t slot = hash & (slotCount - 1);
+            while (table[slot].nameLength != 0)
+                slot = (slot + 1) & (slotCount - 1);
+
+            table[slot] = { hash, nameOffset, static_cast<uint32_t>(entry.path.size()), offset, entry.stored.size(),
+                            entry.size, static_cast<uint32_t>(entry.compression), checksum(entry.stored) };
+
+            offsets[i] = offset;
+            nameOffset += static_cast<uint32_t>(entry.path.size());
+            offset = alignUp(offset + entry.stored.size());
+        }
+
+        uint64_t fileSize = entries.empty() ? namesOffset + names.size() : offsets.back() + entries.back().stored.size();
+
+        PackHeader header{};
+        std::memcpy(header.magic, Magic, sizeof(Magic));
+        header.versionMajor = VersionMajor;
+        header.versionMinor = VersionMinor;
+        header.headerSize = sizeof(PackHeader);
+        header.entryCount = static_cast<uint32_t>(entries.size());
+        header.slotCount = slotCount;
+        header.tableOffset = sizeof(PackHeader);
+        header.namesOffset = namesOffset;
+        header.namesSize = names.size();
+        header.fileSize = fileSize;
+        header.tableChecksum = checksum({ reinterpret_cast<const uint8_t*>(names.data()), names.size() },
+                                        checksum({ reinterpret_cast<const uint8_t*>(table.data()), table.size() * sizeof(PackEntry) }));
+        header.headerChecksum = headerChecksum(header);
+
+        std::vector<uint8_t> out(static_cast<size_t>(fileSize), 0);
+        std::memcpy(out.data(), &header, sizeof(header));
+        std::memcpy(out.data() + header.tableOffset, table.data(), table.size() * sizeof(PackEntry));
+        std::copy(names.begin(), names.end(), out.begin() + namesOffset);
+
+        for (size_t i = 0; i < entries.size(); ++i)
+            std::copy(entries[i].stored.begin(), entries[i].stored.end(), out.begin() + offsets[i]);
+
+        return out;
+    }
+
+    bool AssetPackWriter::write(const std::filesystem::path& path, string& error) const {
+        VOLT_PROFILE_SCOPE("AssetPackWriter::write");
+
+        std::vector<uint8_t> bytes = build();
+        return writeFileAtomically(path, { reinterpret_cast<const char*>(bytes.data()), bytes.size() }, error);
+    }
+
+    std::optional<size_t> packDirectory(const std::filesystem::path& directory, const std::filesystem::path& output,
+                                        Compression compression, string& error) {
+        VOLT_PROFILE_SCOPE("packDirectory");
+
+        std::error_code ec;
+        if (!std::filesystem::is_directory(directory, ec)) {
+            error = std::format("{} is not a directory", directory.string());
+            return std::nullopt;
+        }
+
+        std::filesystem::path outputPath = std::filesystem::weakly_canonical(output, ec);
+
+        // Sorted so the same directory always packs to the same bytes.
+        std::vector<std::filesystem::path> files;
+        for (auto it = std::filesystem::recursive_directory_iterator(directory, ec); !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+            // Its own error code, so a failure on one entry doesn't end the listing.
+            std::error_code entryEc;
+            if (it->is_regular_file(entryEc) && std::filesystem::weakly_canonical(it->path(), entryEc) != outputPath && !entryEc)
+                files.push_back(it->path());
+        }
+        if (ec) {
+            error = std::format("could not list {}: {}", directory.string(), ec.message());
+            return std::nullopt;
+        }
+        std::sort(files.begin(), files.end());
+
+        AssetPackWriter writer;
+        for (const std::filesystem::path& file : files) {
+            MappedFile mapped;
+            if (!mapped.open(file)) {
+                error = std::format("could not read {}", file.string());
+                return std::nullopt;
+            }
+            if (!writer.add(file.lexically_relative(directory).generic_string(), mapped.bytes(), compression, error))
+                return std::nullopt;
+        }
+
+        if (!writer.write(output, error))
+            return std::nullopt;
+        return writer.getEntryCount();
+    }
+
+    PackValidationReport validateAssetPack(const std::filesystem::path& path) {
+        PackValidationReport report;
+
+        AssetPackReader reader;
+        string error;
+        if (!reader.open(path, error)) {
+            report.errors.push_back(error);
+            return report;
+        }
+
+        const PackHeader& header = reader.getHeader();
+        if (header.versionMinor > VersionMinor)
+            report.warnings.push_back(std::format("written by a newer minor version ({}.{}); unknown fields are ignored", header.versionMajor, header.versionMinor));
+        if (header.headerSize != sizeof(PackHeader))
+            report.warnings.push_back(std::format("header size is {} bytes, expected {}", header.headerSize, sizeof(PackHeader)));
+
+        std::span<const PackEntry> slots = reader.getSlots();
+        uint64_t dataStart = header.namesOffset + header.namesSize;
+
+        std::vector<const PackEntry*> entries;
+        for (const PackEntry& entry : slots) {
+            if (entry.nameLength != 0)
+                entries.push_back(&entry);
+        }
+
+        std::sort(entries.begin(), entries.end(), [](const PackEntry* a, const PackEntry* b) { return a->offset < b->offset; });
+
+        uint64_t previousEnd = dataStart;
+        for (const PackEntry* entry : entries) {
+            std::string_view name = reader.entryName(*entry);
+
+            if (entry->pathHash != hashPath(name))
+                report.errors.push_back(std::format("{} has the wrong path hash", name));
+            else if (reader.find(name) != entry)
+                report.errors.push_back(std::format("{} can't be found from its hash slot (duplicate or misplaced)", name));
+
+            if (entry->offset % EntryAlignment != 0)
+                report.errors.push_back(std::format("{} at offset {} is not {}-byte aligned", name, entry->offset, EntryAlignment));
+            if (entry->offset < previousEnd)
+                report.errors.push_back(std::format("{} overlaps the header, table, names or another entry", name));
+            previousEnd = std::max(previousEnd, entry->offset + entry->storedSize);
+
+            std::span<const uint8_t> stored = reader.storedBytes(*entry);
+            if (checksum(stored) != entry->checksum) {
+                report.errors.push_back(std::format("{} checksum mismatch", name));
+                continue;
+            }
+
+            if (entry->compression == static_cast<uint32_t>(Compression::None)) {
+                if (entry->size != entry->storedSize)
+                    report.errors.push_back(std::format("{} is stored uncompressed but sizes differ", name));
+                continue;
+            }
+
+            std::vector<uint8_t> bytes;
+            string entryError;
+            if (!decompress(*entry, stored, bytes, entryError))
+                report.errors.push_back(std::format("{}: {}", name, entryError));
+        }
+
+        return report;
+    }
+
+}
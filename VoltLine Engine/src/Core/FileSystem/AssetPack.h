@@ -0,0 +1,171 @@
+#pragma once
+
+#include "pch.h"
+
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include "Core/FileSystem/MappedFile.h"
+
+namespace FileSystem {
+
+    // The .vpak asset archive. Little endian throughout:
+    //
+    //   PackHeader           64 bytes at offset 0
+    //   PackEntry[slotCount] the table of contents, an open-addressed hash table
+    //   names                entry paths, not null terminated
+    //   entry data           each aligned to EntryAlignment
+    //
+    // slotCount is a power of two at least twice the entry count. An entry lives at
+    // the slot its path hash selects, or the next free one after it (linear
+    // probing); empty slots have nameLength 0. Paths are stored relative to the
+    // packed directory with forward slashes, so a lookup is one hash and usually
+    // one probe straight into the mapped table, with no parsing at open.
+    namespace PackFormat {
+
+        inline constexpr char Magic[8] = { 'V', 'O', 'L', 'T', 'P', 'A', 'C', 'K' };
+        inline constexpr uint16_t VersionMajor = 1;
+        inline constexpr uint16_t VersionMinor = 0;
+        // A cache line, so entries can be handed out as aligned spans into the mapping.
+        inline constexpr uint64_t EntryAlignment = 64;
+        // An LZ4 sequence can't expand its input by more than this, so an entry
+        // claiming a larger decompressed size is rejected before anything is allocated.
+        inline constexpr uint64_t MaxCompressionRatio = 255;
+
+        enum class Compression : uint32_t {
+            None = 0,
+            LZ4 = 1,    // LZ4 block format, see Lz4.h
+            Zstd = 2,   // reserved: this build has no zstd decoder
+        };
+
+        struct PackHeader {
+            char magic[8];
+            uint16_t versionMajor;
+            uint16_t versionMinor;
+            uint32_t headerSize;
+            uint32_t entryCount;
+            uint32_t slotCount;
+            uint64_t tableOffset;
+            uint64_t namesOffset;
+            uint64_t namesSize;
+            uint64_t fileSize;
+            uint32_t headerChecksum;        // over the header with this field zeroed
+            uint32_t tableChecksum;         // over the table and the names
+        };
+
+        struct PackEntry {
+            uint64_t pathHash;
+            uint32_t nameOffset;            // into the names block
+            uint32_t nameLength;
+            uint64_t offset;
+            uint64_t storedSize;
+            uint64_t size;                  // after decompression
+            uint32_t compression;
+            uint32_t checksum;              // over the stored bytes
+        };
+
+        static_assert(sizeof(PackHeader) == 64);
+        static_assert(sizeof(PackEntry) == 48);
+
+        // FNV-1a 64 of the path with backslashes read as forward slashes.
+        uint64_t hashPath(std::string_view path);
+
+        string compressionName(Compression compression);
+        std::optional<Compression> parseCompression(std::string_view name);
+
+    }
+
+    // The bytes of one asset, without a copy wherever possible: a view into a
+    // mapped pack, a mapping of a loose file, or (for compressed pack entries) a
+    // buffer it owns. A view borrows from the pack it came from and must not
+    // outlive it. Moving keeps bytes() pointing at the same memory.
+    class AssetData {
+    public:
+        AssetData() = default;
+
+        static AssetData view(std::span<const uint8_t> bytes);
+        static AssetData owned(std::vector<uint8_t> bytes);
+        static AssetData mapped(MappedFile file);
+
+        std::span<const uint8_t> bytes() const { return contents; }
+        const uint8_t* data() const { return contents.data(); }
+        size_t size() const { return contents.size(); }
+        std::string_view text() const { return { reinterpret_cast<const char*>(contents.data()), contents.size() }; }
+
+    private:
+        std::span<const uint8_t> contents;
+        std::vector<uint8_t> buffer;
+        MappedFile file;
+    };
+
+    // Maps a .vpak once and serves entries out of the mapping. open() validates the
+    // header and table; entry checksums are only checked by validateAssetPack, so
+    // reading an uncompressed entry costs a hash lookup and nothing else.
+    class AssetPackReader {
+    public:
+        bool open(const std::filesystem::path& path, string& error);
+        void close();
+
+        bool isOpen() const { return file.isOpen(); }
+        const PackFormat::PackHeader& getHeader() const { return header; }
+        // All slots of the table, including empty ones (nameLength 0).
+        std::span<const PackFormat::PackEntry> getSlots() const { return slots; }
+
+        const PackFormat::PackEntry* find(std::string_view path) const;
+        std::string_view entryName(const PackFormat::PackEntry& entry) const;
+        std::span<const uint8_t> storedBytes(const PackFormat::PackEntry& entry) const;
+
+        // A view for stored entries, a decompressed buffer otherwise; nullopt (and
+        // error filled) if the entry is missing or can't be decompressed.
+        std::optional<AssetData> read(const PackFormat::PackEntry& entry, string& error) const;
+        std::optional<AssetData> read(std::string_view path, string& error) const;
+
+    private:
+        MappedFile file;
+        PackFormat::PackHeader header{};
+        std::span<const PackFormat::PackEntry> slots;
+        std::string_view names;
+    };
+
+    // Builds a .vpak in memory and writes it atomically (see writeFileAtomically).
+    class AssetPackWriter {
+    public:
+        // Adds or replaces an entry. A compressed entry is stored uncompressed
+        // anyway when compression saves less than an eighth of its size, which is
+        // what happens to PNGs and fonts.
+        bool add(std::string_view path, std::span<const uint8_t> bytes, PackFormat::Compression compression, string& error);
+
+        size_t getEntryCount() const { return entries.size(); }
+
+        std::vector<uint8_t> build() const;
+        bool write(const std::filesystem::path& path, string& error) const;
+
+    private:
+        struct Entry {
+            string path;
+            std::vector<uint8_t> stored;
+            uint64_t size = 0;
+            PackFormat::Compression compression = PackFormat::Compression::None;
+        };
+
+        std::vector<Entry> entries;
+    };
+
+    // Packs every regular file under directory, keyed by its path relative to it.
+    // Returns the number of entries written, or nullopt and fills error.
+    std::optional<size_t> packDirectory(const std::filesystem::path& directory, const std::filesystem::path& output,
+                                        PackFormat::Compression compression, string& error);
+
+    struct PackValidationReport {
+        std::vector<string> errors;
+        std::vector<string> warnings;
+
+        bool ok() const { return errors.empty(); }
+    };
+
+    // Everything the reader relies on plus what it skips: every entry's bounds,
+    // alignment, slot placement and checksum, and that compressed entries decode.
+    PackValidationReport validateAssetPack(const std::filesystem::path& path);
+
+}
@@ -0,0 +1,102 @@
+#include "AtomicFile.h"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace FileSystem {
+
+    bool writeFileAtomically(const std::filesystem::path& path, std::string_view contents, string& error) {
+        std::filesystem::path tempPath = path;
+        tempPath += ".tmp";
+
+#ifdef _WIN32
+        HANDLE file = CreateFileW(tempPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            error = std::format("Could not create {} (error {})", tempPath.string(), GetLastError());
+            return false;
+        }
+
+        size_t written = 0;
+        while (written < contents.size()) {
+            DWORD chunk = static_cast<DWORD>(std::min<size_t>(contents.size() - written, 1u << 30));
+            DWORD wrote = 0;
+            if (!WriteFile(file, contents.data() + written, chunk, &wrote, nullptr)) {
+                error = std::format("Could not write {} (error {})", tempPath.string(), GetLastError());
+                CloseHandle(file);
+                DeleteFileW(tempPath.c_str());
+                return false;
+            }
+            written += wrote;
+        }
+
+        if (!FlushFileBuffers(file)) {
+            error = std::format("Could not flush {} (error {})", tempPath.string(), GetLastError());
+            CloseHandle(file);
+            DeleteFileW(tempPath.c_str());
+            return false;
+        }
+        CloseHandle(file);
+
+        if (!MoveFileExW(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+            error = std::format("Could not replace {} (error {})", path.string(), GetLastError());
+            DeleteFileW(tempPath.c_str());
+            return false;
+        }
+#else
+        int fd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            error = std::format("Could not create {}: {}", tempPath.string(), std::strerror(errno));
+            return false;
+        }
+
+        size_t written = 0;
+        while (written < contents.size()) {
+            ssize_t wrote = ::write(fd, contents.data() + written, contents.size() - written);
+            if (wrote < 0) {
+                if (errno == EINTR)
+                    continue;
+
+                error = std::format("Could not write {}: {}", tempPath.string(), std::strerror(errno));
+                ::close(fd);
+                ::unlink(tempPath.c_str());
+                return false;
+            }
+            written += static_cast<size_t>(wrote);
+        }
+
+        if (::fsync(fd) != 0) {
+            error = std::format("Could not sync {}: {}", tempPath.string(), std::strerror(errno));
+            ::close(fd);
+            ::unlink(tempPath.c_str());
+            return false;
+        }
+        ::close(fd);
+
+        if (::rename(tempPath.c_str(), path.c_str()) != 0) {
+            error = std::format("Could not replace {}: {}", path.string(), std::strerror(errno));
+            ::unlink(tempPath.c_str());
+            return false;
+        }
+
+        // Persist the rename itself.
+        std::filesystem::path directory = path.has_parent_path() ? path.parent_path() : std::filesystem::path(".");
+        int dirFd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dirFd >= 0) {
+            ::fsync(dirFd);
+            ::close(dirFd);
+        }
+#endif
+        return true;
+    }
+
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "pch.h"
+
+namespace FileSystem {
+
+    // Replaces the file at path with contents so that readers, and the file after a
+    // crash, only ever see the old or the new version: the data goes to a temp file
+    // next to the target, is fsynced, then renamed over it.
+    // Returns false and fills error on failure; the original file is left untouched.
+    bool writeFileAtomically(const std::filesystem::path& path, std::string_view contents, string& error);
+
+}
@@ -0,0 +1,154 @@
+#include "Lz4.h"
+
+namespace FileSystem {
+
+    namespace {
+
+        constexpr size_t MinMatch = 4;
+        // The format requires the last 5 bytes to be literals and the last match to
+        // start at least 12 bytes before the end of the block.
+        constexpr size_t LastLiterals = 5;
+        constexpr size_t MatchFindLimit = 12;
+        constexpr size_t MaxOffset = 65535;
+        constexpr int HashBits = 14;
+
+        uint32_t read32(const uint8_t* bytes) {
+            uint32_t value;
+            std::memcpy(&value, bytes, sizeof(value));
+            return value;
+        }
+
+        uint32_t hashSequence(uint32_t sequence) {
+            return (sequence * 2654435761u) >> (32 - HashBits);
+        }
+
+        void putLength(std::vector<uint8_t>& out, size_t length) {
+            for (; length >= 255; length -= 255)
+                out.push_back(255);
+            out.push_back(static_cast<uint8_t>(length));
+        }
+
+        void putSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength) {
+            size_t matchCode = matchLength - MinMatch;
+            out.push_back(static_cast<uint8_t>((std::min<size_t>(literalLength, 15) << 4) | std::min<size_t>(matchCode, 15)));
+
+            if (literalLength >= 15)
+                putLength(out, literalLength - 15);
+            out.insert(out.end(), literals, literals + literalLength);
+
+            out.push_back(static_cast<uint8_t>(offset));
+            out.push_back(static_cast<uint8_t>(offset >> 8));
+
+            if (matchCode >= 15)
+                putLength(out, matchCode - 15);
+        }
+
+        bool getLength(std::span<const uint8_t> input, size_t& position, size_t& length) {
+            uint8_t byte;
+            do {
+                if (position >= input.size())
+                    return false;
+                byte = input[position++];
+                length += byte;
+            } while (byte == 255);
+            return true;
+        }
+
+    }
+
+    std::vector<uint8_t> lz4Compress(std::span<const uint8_t> input) {
+        const uint8_t* source = input.data();
+        const size_t size = input.size();
+
+        std::vector<uint8_t> out;
+        out.reserve(lz4CompressBound(size));
+
+        size_t anchor = 0;
+
+        if (size > MatchFindLimit) {
+            std::vector<uint32_t> table(size_t(1) << HashBits, UINT32_MAX);
+            const size_t matchLimit = size - LastLiterals;
+
+            for (size_t position = 0; position < size - MatchFindLimit;) {
+                uint32_t sequence = read32(source + position);
+                uint32_t& slot = table[hashSequence(sequence)];
+                size_t candidate = slot;
+                slot = static_cast<uint32_t>(position);
+
+                if (candidate == UINT32_MAX || position - candidate > MaxOffset || read32(source + candidate) != sequence) {
+                    ++position;
+                    continue;
+                }
+
+                size_t matchLength = MinMatch;
+                while (position + matchLength < matchLimit && source[candidate + matchLength] == source[position + matchLength])
+                    ++matchLength;
+
+                putSequence(out, source + anchor, position - anchor, position - candidate, matchLength);
+                position += matchLength;
+                anchor = position;
+            }
+        }
+
+        // Whatever is left goes out as a final literal-only sequence.
+        size_t literalLength = size - anchor;
+        out.push_back(static_cast<uint8_t>(std::min<size_t>(literalLength, 15) << 4));
+        if (literalLength >= 15)
+            putLength(out, literalLength - 15);
+        out.insert(out.end(), source + anchor, source + size);
+
+        return out;
+    }
+
+    bool lz4Decompress(std::span<const uint8_t> input, std::span<uint8_t> out) {
+        size_t in = 0;
+        size_t written = 0;
+
+        while (in < input.size()) {
+            uint8_t token = input[in++];
+
+            size_t literalLength = token >> 4;
+            if (literalLength == 15 && !getLength(input, in, literalLength))
+                return false;
+            if (literalLength > input.size() - in || literalLength > out.size() - written)
+                return false;
+
+            std::memcpy(out.data() + written, input.data() + in, literalLength);
+            in += literalLength;
+            written += literalLength;
+
+            // The last sequence has literals only.
+            if (in == input.size())
+                break;
+
+            if (input.size() - in < 2)
+                return false;
+            size_t offset = input[in] | size_t(input[in + 1]) << 8;
+            in += 2;
+            if (offset == 0 || offset > written)
+                return false;
+
+            size_t matchLength = token & 15;
+            if (matchLength == 15 && !getLength(input, in, matchLength))
+                return false;
+            matchLength += MinMatch;
+            if (matchLength > out.size() - written)
+                return false;
+
+            uint8_t* destination = out.data() + written;
+            const uint8_t* match = destination - offset;
+            if (offset >= matchLength) {
+                std::memcpy(destination, match, matchLength);
+            }
+            else {
+                // Overlapping copy: repeats the last `offset` bytes.
+                for (size_t i = 0; i < matchLength; ++i)
+                    destination[i] = match[i];
+            }
+            written += matchLength;
+        }
+
+        return written == out.size();
+    }
+
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "pch.h"
+
+#include <cstdint>
+#include <span>
+
+namespace FileSystem {
+
+    // LZ4 block format (no frame header), compatible with LZ4_compress_default /
+    // LZ4_decompress_safe. The compressor is the simple greedy single-probe kind:
+    // it is only run by the asset packer, where ratio matters more than speed.
+
+    // Worst case size of lz4Compress's output for an input of the given size.
+    constexpr size_t lz4CompressBound(size_t size) { return size + size / 255 + 16; }
+
+    std::vector<uint8_t> lz4Compress(std::span<const uint8_t> input);
+
+    // Decompresses into out, which must be exactly the original size. Returns false
+    // on malformed input instead of reading or writing out of bounds.
+    bool lz4Decompress(std::span<const uint8_t> input, std::span<uint8_t> out);
+
+}
@@ -0,0 +1,121 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace FileSystem {
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this == &other)
+            return *this;
+
+        close();
+
+        view = std::exchange(other.view, nullptr);
+        length = std::exchange(other.length, 0);
+        opened = std::exchange(other.opened, false);
+#ifdef _WIN32
+        fileHandle = std::exchange(other.fileHandle, nullptr);
+        mappingHandle = std::exchange(other.mappingHandle, nullptr);
+#else
+        fd = std::exchange(other.fd, -1);
+#endif
+        return *this;
+    }
+
+    bool MappedFile::open(const std::filesystem::path& path) {
+        close();
+
+#ifdef _WIN32
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER fileSize{};
+        if (!GetFileSizeEx(file, &fileSize)) {
+            CloseHandle(file);
+            return false;
+        }
+
+        fileHandle = file;
+        length = static_cast<size_t>(fileSize.QuadPart);
+        opened = true;
+
+        // CreateFileMapping refuses zero-length files.
+        if (length == 0)
+            return true;
+
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            close();
+            return false;
+        }
+        mappingHandle = mapping;
+
+        view = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!view) {
+            close();
+            return false;
+        }
+#else
+        fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return false;
+
+        struct stat info {};
+        if (fstat(fd, &info) != 0) {
+            close();
+            return false;
+        }
+
+        length = static_cast<size_t>(info.st_size);
+        opened = true;
+
+        if (length == 0)
+            return true;
+
+        void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            close();
+            return false;
+        }
+
+        view = static_cast<const uint8_t*>(mapped);
+        madvise(mapped, length, MADV_SEQUENTIAL);
+#endif
+        return true;
+    }
+
+    void MappedFile::close() {
+#ifdef _WIN32
+        if (view)
+            UnmapViewOfFile(view);
+        if (mappingHandle)
+            CloseHandle(static_cast<HANDLE>(mappingHandle));
+        if (fileHandle)
+            CloseHandle(static_cast<HANDLE>(fileHandle));
+        fileHandle = nullptr;
+        mappingHandle = nullptr;
+#else
+        if (view)
+            munmap(const_cast<uint8_t*>(view), length);
+        if (fd >= 0)
+            ::close(fd);
+        fd = -1;
+#endif
+        view = nullptr;
+        length = 0;
+        opened = false;
+    }
+
+}
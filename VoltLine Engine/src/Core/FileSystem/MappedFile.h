@@ -0,0 +1,45 @@
+#pragma once
+
+#include "pch.h"
+
+#include <cstdint>
+#include <span>
+
+namespace FileSystem {
+
+    // Read-only memory mapping of a whole file. The view stays valid until close()
+    // or destruction; an empty file maps successfully to an empty span.
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        explicit MappedFile(const std::filesystem::path& path) { open(path); }
+        ~MappedFile() { close(); }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        bool open(const std::filesystem::path& path);
+        void close();
+
+        bool isOpen() const { return opened; }
+        const uint8_t* data() const { return view; }
+        size_t size() const { return length; }
+        std::span<const uint8_t> bytes() const { return { view, length }; }
+
+    private:
+        const uint8_t* view = nullptr;
+        size_t length = 0;
+        bool opened = false;
+
+#ifdef _WIN32
+        void* fileHandle = nullptr;
+        void* mappingHandle = nullptr;
+#else
+        int fd = -1;
+#endif
+    };
+
+}
@@ -0,0 +1,164 @@
+#include "VirtualFileSystem.h"
+
+#include "Core/Logging/HubLogger.h"
+
+namespace FileSystem {
+
+    namespace {
+
+        constexpr std::string_view MountSeparator = "://";
+
+        // "hub://fonts/a.ttf" -> { "hub", "fonts/a.ttf" }; no mount name for plain paths.
+        std::pair<std::string_view, std::string_view> splitVirtualPath(std::string_view virtualPath) {
+            size_t separator = virtualPath.find(MountSeparator);
+            if (separator == std::string_view::npos)
+                return { {}, virtualPath };
+
+            return { virtualPath.substr(0, separator), virtualPath.substr(separator + MountSeparator.size()) };
+        }
+
+    }
+
+    VirtualFileSystem::VirtualFileSystem() {
+        std::error_code ec;
+        std::filesystem::path workingDirectory = std::filesystem::current_path(ec);
+
+        std::vector<std::filesystem::path> hubDirectories = {
+            workingDirectory,
+            workingDirectory / "bin" / (string(CURRENT_PLAT) + "-" + string(CURRENT_CONF)) / "VoltLine Engine",
+        };
+        mount("hub", hubDirectories);
+
+        for (const std::filesystem::path& directory : hubDirectories) {
+            std::filesystem::path packPath = directory / "hub.vpak";
+            if (!std::filesystem::exists(packPath, ec))
+                continue;
+
+            string error;
+            if (mountPack("hub", packPath, error))
+                break;
+            cf_Sink::logger->warn(std::format("Ignoring asset pack {}: {}", packPath.string(), error));
+        }
+    }
+
+    void VirtualFileSystem::mount(const string& name, std::vector<std::filesystem::path> directories) {
+        for (std::filesystem::path& directory : directories) {
+            std::error_code ec;
+            std::filesystem::path absolute = std::filesystem::absolute(directory, ec);
+            if (!ec)
+                directory = absolute.lexically_normal();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        mounts[name].directories = std::move(directories);
+
+        for (Entry& entry : entries) {
+            if (splitVirtualPath(entry.virtualPath).first == name)
+                entry.resolved = resolveLocked(entry.virtualPath);
+        }
+    }
+
+    bool VirtualFileSystem::mountPack(const string& name, const std::filesystem::path& packPath, string& error) {
+        auto pack = std::make_unique<AssetPackReader>();
+        if (!pack->open(packPath, error))
+            return false;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        mounts[name].packs.push_back(pack.get());
+        packs.push_back(std::move(pack));
+        return true;
+    }
+
+    PathHandle VirtualFileSystem::intern(std::string_view virtualPath) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto existing = handles.find(virtualPath);
+        if (existing != handles.end())
+            return existing->second;
+
+        PathHandle handle = static_cast<PathHandle>(entries.size());
+        entries.push_back({ string(virtualPath), resolveLocked(virtualPath) });
+        handles.emplace(string(virtualPath), handle);
+        return handle;
+    }
+
+    const ResolvedPath& VirtualFileSystem::get(PathHandle handle) const {
+        static const ResolvedPath invalid;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        return handle < entries.size() ? entries[handle].resolved : invalid;
+    }
+
+    std::optional<AssetData> VirtualFileSystem::read(std::string_view virtualPath, AssetOrigin* origin) {
+        auto [mountName, relative] = splitVirtualPath(virtualPath);
+
+        if (!mountName.empty()) {
+            std::vector<const AssetPackReader*> mountPacks;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto mount = mounts.find(string(mountName));
+                if (mount != mounts.end())
+                    mountPacks = mount->second.packs;
+            }
+
+            // Packs are immutable once mounted, so they're read without the lock.
+            for (const AssetPackReader* pack : mountPacks) {
+                const PackFormat::PackEntry* entry = pack->find(relative);
+                if (!entry)
+                    continue;
+
+                string error;
+                std::optional<AssetData> data = pack->read(*entry, error);
+                if (!data)
+                    cf_Sink::logger->error(std::format("Could not read {}: {}", virtualPath, error));
+                else if (origin)
+                    *origin = { true, 0 };
+                return data;
+            }
+        }
+
+        const ResolvedPath& resolved = get(intern(virtualPath));
+        if (!resolved.exists)
+            return std::nullopt;
+
+        MappedFile file;
+        if (!file.open(resolved.path))
+            return std::nullopt;
+
+        if (origin)
+            *origin = { false, resolved.directory };
+        return AssetData::mapped(std::move(file));
+    }
+
+    ResolvedPath VirtualFileSystem::resolveLocked(std::string_view virtualPath) const {
+        auto [mountName, relative] = splitVirtualPath(virtualPath);
+
+        ResolvedPath resolved;
+        std::error_code ec;
+
+        auto mount = mounts.find(string(mountName));
+        if (mountName.empty() || mount == mounts.end() || mount->second.directories.empty()) {
+            resolved.path = std::filesystem::path(virtualPath);
+            resolved.exists = std::filesystem::exists(resolved.path, ec);
+            return resolved;
+        }
+
+        const std::vector<std::filesystem::path>& directories = mount->second.directories;
+        for (size_t i = 0; i < directories.size(); ++i) {
+            std::filesystem::path candidate = directories[i] / relative;
+            if (std::filesystem::exists(candidate, ec)) {
+                resolved = { std::move(candidate), true, i };
+                return resolved;
+            }
+        }
+
+        resolved = { directories.back() / relative, false, directories.size() - 1 };
+        return resolved;
+    }
+
+    VirtualFileSystem& vfs() {
+        static VirtualFileSystem fileSystem;
+        return fileSystem;
+    }
+
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "pch.h"
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+#include "Core/FileSystem/AssetPack.h"
+
+namespace FileSystem {
+
+    using PathHandle = uint32_t;
+    inline constexpr PathHandle InvalidPath = UINT32_MAX;
+
+    struct ResolvedPath {
+        std::filesystem::path path;
+        bool exists = false;
+        // Which of the mount's directories the file was found in. A file found in
+        // none resolves into the last one, where the hub would create it.
+        size_t directory = 0;
+    };
+
+    // Where read() found a file: in the mount's pack, or else in one of its
+    // directories (indexed as in ResolvedPath).
+    struct AssetOrigin {
+        bool packed = false;
+        size_t directory = 0;
+    };
+
+    // Maps virtual paths like "hub://project_icon.png" onto the disk. A mount is a
+    // name and a list of directories searched in order; "hub" is the working
+    // directory, then the build output directory, which is where hub assets and
+    // settings have always been looked for.
+    //
+    // Mounts are made absolute once, when they are added. A virtual path is resolved
+    // the first time it is interned and the result kept, so looking it up again
+    // (by handle or by name) never touches the filesystem. Paths without a
+    // "name://" prefix, or with an unknown mount, resolve to themselves.
+    //
+    // A mount can also be backed by a .vpak (see AssetPack.h). read() looks there
+    // first and falls back to the mount's directories, so a packed build opens one
+    // file at startup while an unpacked development tree keeps working. The hub mount picks up a hub.vpak sitting in any of its
+    // directories when the filesystem is created.
+    class VirtualFileSystem {
+    public:
+        VirtualFileSystem();
+
+        VirtualFileSystem(const VirtualFileSystem&) = delete;
+        VirtualFileSystem& operator=(const VirtualFileSystem&) = delete;
+
+        // Adds or replaces a mount. Meant for startup: paths already interned under
+        // it are resolved again, so references to them must not be held across this.
+        void mount(const string& name, std::vector<std::filesystem::path> directories);
+
+        // Backs a mount with an asset pack, which is mapped once and kept for the
+        // life of the filesystem: AssetData views read from it stay valid until exit.
+        bool mountPack(const string& name, const std::filesystem::path& packPath, string& error);
+
+        PathHandle intern(std::string_view virtualPath);
+
+        const ResolvedPath& get(PathHandle handle) const;
+        const std::filesystem::path& resolve(PathHandle handle) const { return get(handle).path; }
+        const std::filesystem::path& resolve(std::string_view virtualPath) { return resolve(intern(virtualPath)); }
+
+        // The file's bytes from the mount's pack, or else a mapping of the resolved
+        // file on disk. nullopt if neither has it. origin, if given, is set to where
+        // the bytes came from.
+        std::optional<AssetData> read(std::string_view virtualPath, AssetOrigin* origin = nullptr);
+
+    private:
+        struct Mount {
+            std::vector<std::filesystem::path> directories;
+            std::vector<const AssetPackReader*> packs;
+        };
+
+        struct Entry {
+            string virtualPath;
+            ResolvedPath resolved;
+        };
+
+        struct StringHash {
+            using is_transparent = void;
+            size_t operator()(std::string_view text) const { return std::hash<std::string_view>{}(text); }
+        };
+
+        mutable std::mutex mutex;
+        std::unordered_map<string, Mount> mounts;
+        // A deque so references handed out by get() survive later interning.
+        std::deque<Entry> entries;
+        std::unordered_map<string, PathHandle, StringHash, std::equal_to<>> handles;
+        // Never closed or removed, see mountPack.
+        std::vector<std::unique_ptr<AssetPackReader>> packs;
+
+        ResolvedPath resolveLocked(std::string_view virtualPath) const;
+    };
+
+    VirtualFileSystem& vfs();
+
+}
@@ -0,0 +1,170 @@
+#include "AsyncSink.h"
+
+#include "Core/Profiler/Profiler.h"
+
+namespace Logging {
+
+    std::optional<OverflowPolicy> overflowPolicyFromName(std::string_view name) {
+        if (name == "block")
+            return OverflowPolicy::Block;
+        if (name == "drop")
+            return OverflowPolicy::Drop;
+        if (name == "overwrite")
+            return OverflowPolicy::Overwrite;
+
+        return std::nullopt;
+    }
+
+    AsyncSink::AsyncSink(std::vector<spdlog::sink_ptr> sinks, const AsyncSinkOptions& options)
+        : sinks(std::move(sinks)), options(options), queue(options.queueSize) {
+        writer = std::thread(&AsyncSink::run, this);
+    }
+
+    AsyncSink::~AsyncSink() {
+        stopping.store(true);
+        wakeWriter();
+
+        if (writer.joinable())
+            writer.join();
+    }
+
+    void AsyncSink::log(const spdlog::details::log_msg& msg) {
+        // Copies the payload and logger name; short messages stay in the buffer's inline storage.
+        spdlog::details::log_msg_buffer buffer(msg);
+
+        switch (options.policy) {
+        case OverflowPolicy::Block:
+            while (!queue.tryPush(std::move(buffer))) {
+                wakeWriter();
+                std::this_thread::yield();
+            }
+            break;
+
+        case OverflowPolicy::Drop:
+            if (!queue.tryPush(std::move(buffer)))
+                dropped.fetch_add(1, std::memory_order_relaxed);
+            break;
+
+        case OverflowPolicy::Overwrite:
+            while (!queue.tryPush(std::move(buffer))) {
+                spdlog::details::log_msg_buffer oldest;
+                if (queue.tryPop(oldest))
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+            break;
+        }
+
+        // Pairs with the fence in run(): either the writer sees the message, or we see it asleep.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (writerSleeping.load(std::memory_order_relaxed))
+            wakeWriter();
+    }
+
+    void AsyncSink::flush() {
+        flushRequested.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (writerSleeping.load(std::memory_order_relaxed))
+            wakeWriter();
+    }
+
+    void AsyncSink::flushAndWait() {
+        std::unique_lock<std::mutex> lock(flushMutex);
+        uint64_t ticket = ++flushTicket;
+
+        flushRequested.store(true);
+        wakeWriter();
+
+        flushed.wait(lock, [&] { return flushedTicket >= ticket; });
+    }
+
+    void AsyncSink::set_pattern(const std::string& pattern) {
+        std::lock_guard<std::mutex> lock(sinkMutex);
+        for (const spdlog::sink_ptr& sink : sinks)
+            sink->set_pattern(pattern);
+    }
+
+    void AsyncSink::set_formatter(std::unique_ptr<spdlog::formatter> sinkFormatter) {
+        std::lock_guard<std::mutex> lock(sinkMutex);
+        for (size_t i = 0; i < sinks.size(); ++i)
+            sinks[i]->set_formatter(i + 1 == sinks.size() ? std::move(sinkFormatter) : sinkFormatter->clone());
+    }
+
+    void AsyncSink::wakeWriter() {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        wake.notify_one();
+    }
+
+    void AsyncSink::run() {
+        VOLT_PROFILE_THREAD("Log Writer");
+
+        using Clock = std::chrono::steady_clock;
+        Clock::time_point nextFlush = Clock::now() + options.flushInterval;
+        uint64_t reportedDropped = 0;
+
+        while (true) {
+            drain();
+
+            uint64_t droppedNow = dropped.load(std::memory_order_relaxed);
+            if (droppedNow != reportedDropped) {
+                string text = std::format("Log queue overflowed: {} message(s) dropped.", droppedNow - reportedDropped);
+                spdlog::details::log_msg notice("multi_sink_logger", spdlog::level::warn, text);
+                std::lock_guard<std::mutex> lock(sinkMutex);
+                for (const spdlog::sink_ptr& sink : sinks)
+                    if (sink->should_log(notice.level))
+                        sink->log(notice);
+
+                reportedDropped = droppedNow;
+            }
+
+            bool stop = stopping.load();
+            if (flushRequested.exchange(false) || Clock::now() >= nextFlush || stop) {
+                uint64_t ticket;
+                {
+                    std::lock_guard<std::mutex> lock(flushMutex);
+                    ticket = flushTicket;
+                }
+
+                drain();
+                flushSinks();
+                nextFlush = Clock::now() + options.flushInterval;
+
+                {
+                    std::lock_guard<std::mutex> lock(flushMutex);
+                    flushedTicket = ticket;
+                }
+                flushed.notify_all();
+            }
+
+            if (stop && queue.approximateSize() == 0)
+                break;
+
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            writerSleeping.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (queue.approximateSize() == 0 && !flushRequested.load(std::memory_order_relaxed) && !stopping.load())
+                wake.wait_until(lock, nextFlush);
+
+            writerSleeping.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    void AsyncSink::drain() {
+        spdlog::details::log_msg_buffer message;
+        std::lock_guard<std::mutex> lock(sinkMutex);
+
+        while (queue.tryPop(message)) {
+            for (const spdlog::sink_ptr& sink : sinks) {
+                if (sink->should_log(message.level))
+                    sink->log(message);
+            }
+        }
+    }
+
+    void AsyncSink::flushSinks() {
+        std::lock_guard<std::mutex> lock(sinkMutex);
+        for (const spdlog::sink_ptr& sink : sinks)
+            sink->flush();
+    }
+
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "pch.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+
+#include "spdlog/details/log_msg_buffer.h"
+#include "spdlog/sinks/sink.h"
+
+#include "Core/Threading/MPMCQueue.h"
+
+namespace Logging {
+
+    // What a logging thread does when the queue is full.
+    enum class OverflowPolicy {
+        Block,      // wait for the writer thread to make room; nothing is lost
+        Drop,       // discard the new message
+        Overwrite,  // discard the oldest queued message to make room
+    };
+
+    std::optional<OverflowPolicy> overflowPolicyFromName(std::string_view name);
+
+    struct AsyncSinkOptions {
+        size_t queueSize = 8192;
+        OverflowPolicy policy = OverflowPolicy::Block;
+        std::chrono::milliseconds flushInterval{ 1000 };
+    };
+
+    // spdlog sink that copies each message into a lock-free queue and returns. A
+    // writer thread formats the messages, hands them to the wrapped sinks and
+    // flushes those periodically, so the threads doing the logging (the render
+    // thread in particular) never touch the console or the disk.
+    //
+    // flush() only asks the writer thread to flush soon. Everything still queued is
+    // written when the sink is destroyed.
+    class AsyncSink final : public spdlog::sinks::sink {
+    public:
+        AsyncSink(std::vector<spdlog::sink_ptr> sinks, const AsyncSinkOptions& options = {});
+        ~AsyncSink() override;
+
+        AsyncSink(const AsyncSink&) = delete;
+        AsyncSink& operator=(const AsyncSink&) = delete;
+
+        void log(const spdlog::details::log_msg& msg) override;
+        void flush() override;
+        void set_pattern(const std::string& pattern) override;
+        void set_formatter(std::unique_ptr<spdlog::formatter> sinkFormatter) override;
+
+        // Blocks until everything logged so far has been written and flushed.
+        void flushAndWait();
+
+        uint64_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+        const std::vector<spdlog::sink_ptr>& getSinks() const { return sinks; }
+
+    private:
+        std::vector<spdlog::sink_ptr> sinks;
+        AsyncSinkOptions options;
+
+        Threading::MPMCQueue<spdlog::details::log_msg_buffer> queue;
+
+        std::atomic<uint64_t> dropped{ 0 };
+        std::atomic<bool> flushRequested{ false };
+        std::atomic<bool> writerSleeping{ false };
+        std::atomic<bool> stopping{ false };
+
+        // Only used to park the writer thread while the queue is empty.
+        std::mutex wakeMutex;
+        std::condition_variable wake;
+
+        // flushAndWait() handshake.
+        std::mutex flushMutex;
+        std::condition_variable flushed;
+        uint64_t flushTicket = 0;
+        uint64_t flushedTicket = 0;
+
+        // Held by the writer thread while it uses the wrapped sinks, and by
+        // set_pattern()/set_formatter() while they swap a sink's formatter.
+        std::mutex sinkMutex;
+
+        std::thread writer;
+
+        void wakeWriter();
+        void run();
+        void drain();
+        void flushSinks();
+    };
+
+}
@@ -0,0 +1,24 @@
+#include "HubLogger.h"
+
+namespace cf_Sink {
+
+    namespace {
+
+        // Both constant-initialized, so logging during static initialization is safe.
+        std::shared_ptr<spdlog::logger> installed;
+        std::atomic<spdlog::logger*> current{ nullptr };
+
+    }
+
+    spdlog::logger* LoggerHandle::operator->() const {
+        if (spdlog::logger* hubLogger = current.load(std::memory_order_acquire))
+            return hubLogger;
+        return spdlog::default_logger_raw();
+    }
+
+    void setLogger(std::shared_ptr<spdlog::logger> hubLogger) {
+        installed = std::move(hubLogger);
+        current.store(installed.get(), std::memory_order_release);
+    }
+
+}
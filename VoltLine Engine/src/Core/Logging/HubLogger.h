@@ -0,0 +1,25 @@
+#pragma once
+
+#include "pch.h"
+
+#include <atomic>
+
+namespace cf_Sink {
+
+    // The hub's logger: console plus the rotating log file configured in
+    // hub_settings.json. Window installs it with setLogger() during start-up;
+    // before that, and in tools that never install one (the benchmarks), messages
+    // go to spdlog's default logger. Usable from any thread:
+    //
+    //   cf_Sink::logger->warn(std::format("Could not read {}", path.string()));
+    class LoggerHandle {
+    public:
+        spdlog::logger* operator->() const;
+    };
+
+    inline constexpr LoggerHandle logger{};
+
+    // Installs the hub logger. Meant to be called once; the logger lives until exit.
+    void setLogger(std::shared_ptr<spdlog::logger> hubLogger);
+
+}
@@ -0,0 +1,131 @@
+#include "DirectoryManager.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#include <ShlObj.h>
+#endif
+
+namespace DirectoryManager {
+
+    namespace {
+
+        std::filesystem::path environmentPath(const char* name) {
+#ifdef _WIN32
+            char* buffer = nullptr;
+            size_t size = 0;
+            if (_dupenv_s(&buffer, &size, name) != 0 || buffer == nullptr)
+                return {};
+
+            std::filesystem::path value(buffer);
+            free(buffer);
+            return value;
+#else
+            const char* value = std::getenv(name);
+            return value && *value ? std::filesystem::path(value) : std::filesystem::path();
+#endif
+        }
+
+#ifdef _WIN32
+        std::filesystem::path knownFolder(REFKNOWNFOLDERID id) {
+            PWSTR path = nullptr;
+            std::filesystem::path result;
+            if (SUCCEEDED(SHGetKnownFolderPath(id, KF_FLAG_DEFAULT, nullptr, &path)))
+                result = path;
+            CoTaskMemFree(path);
+            return result;
+        }
+#else
+        // XDG base directories only count when absolute; anything else means "use the default".
+        std::filesystem::path xdgDirectory(const char* variable, const std::filesystem::path& fallback) {
+            std::filesystem::path value = environmentPath(variable);
+            return value.is_absolute() ? value : fallback;
+        }
+
+        // Looks up XDG_<name>_DIR the way xdg-user-dir does: the environment, then
+        // user-dirs.dirs in the config directory, whose entries look like
+        // XDG_DOCUMENTS_DIR="$HOME/Documents".
+        std::filesystem::path xdgUserDirectory(const string& name, const PlatformDirectories& directories) {
+            string variable = "XDG_" + name + "_DIR";
+
+            std::filesystem::path value = environmentPath(variable.c_str());
+            if (value.is_absolute())
+                return value;
+
+            std::ifstream file(directories.config / "user-dirs.dirs");
+            string line;
+            while (std::getline(file, line)) {
+                if (!line.starts_with(variable + "="))
+                    continue;
+
+                std::string_view entry = std::string_view(line).substr(variable.size() + 1);
+                if (entry.size() < 2 || entry.front() != '"' || entry.back() != '"')
+                    continue;
+                entry = entry.substr(1, entry.size() - 2);
+
+                if (entry.starts_with("$HOME"))
+                    return directories.home / std::filesystem::path(entry.substr(5)).relative_path();
+                if (entry.starts_with("/"))
+                    return std::filesystem::path(entry);
+            }
+
+            return {};
+        }
+#endif
+
+        PlatformDirectories lookUpDirectories() {
+            PlatformDirectories directories;
+
+#ifdef _WIN32
+            directories.home = knownFolder(FOLDERID_Profile);
+            if (directories.home.empty())
+                directories.home = environmentPath("USERPROFILE");
+
+            directories.documents = knownFolder(FOLDERID_Documents);
+            directories.config = knownFolder(FOLDERID_RoamingAppData);
+            directories.data = knownFolder(FOLDERID_LocalAppData);
+            directories.cache = directories.data;
+
+            if (directories.documents.empty() && !directories.home.empty())
+                directories.documents = directories.home / "Documents";
+#else
+            directories.home = environmentPath("HOME");
+            if (directories.home.empty())
+                return directories;
+
+#ifdef __APPLE__
+            directories.documents = directories.home / "Documents";
+            directories.config = directories.home / "Library" / "Application Support";
+            directories.data = directories.config;
+            directories.cache = directories.home / "Library" / "Caches";
+#else
+            directories.config = xdgDirectory("XDG_CONFIG_HOME", directories.home / ".config");
+            directories.data = xdgDirectory("XDG_DATA_HOME", directories.home / ".local" / "share");
+            directories.cache = xdgDirectory("XDG_CACHE_HOME", directories.home / ".cache");
+
+            directories.documents = xdgUserDirectory("DOCUMENTS", directories);
+            if (directories.documents.empty())
+                directories.documents = directories.home / "Documents";
+#endif
+#endif
+
+            return directories;
+        }
+
+    }
+
+    const PlatformDirectories& platformDirectories() {
+        static const PlatformDirectories directories = lookUpDirectories();
+        return directories;
+    }
+
+    const std::filesystem::path& defaultProjectsPath() {
+        static const std::filesystem::path path = platformDirectories().documents.empty()
+            ? std::filesystem::path()
+            : platformDirectories().documents / "VoltLine Projects";
+        return path;
+    }
+
+}
@@ -4,50 +4,21 @@
 
 namespace DirectoryManager {
 
-    std::filesystem::path getUserDocumentsPath(std::initializer_list<std::string> endings = {}) {
-        static char userProfile[128]; // Static char array to hold the environment variable
-        char* buffer = nullptr;
-        size_t bufferSize = 0;
-
-        // Retrieve the USERPROFILE environment variable securely
-        if (_dupenv_s(&buffer, &bufferSize, "USERPROFILE") == 0 && buffer != nullptr) {
-            if (bufferSize >= sizeof(userProfile)) {
-                free(buffer); // Free the buffer before throwing
-                throw std::runtime_error("Environment variable value is too large for the static buffer.");
-            }
-
-            // Use strncpy_s for safe copying
-            errno_t err = strncpy_s(userProfile, sizeof(userProfile), buffer, bufferSize - 1);
-            if (err != 0) {
-                free(buffer); // Free the buffer before throwing
-                throw std::runtime_error("Error copying environment variable value.");
-            }
-
-            userProfile[sizeof(userProfile) - 1] = '\0'; // Ensure null termination
-            free(buffer); // Free the dynamically allocated buffer
-
-            // Start with the user profile path
-            std::filesystem::path finalPath(userProfile);
-
-            // Add the additional path segments (endings)
-            for (const auto& ending : endings) {
-                finalPath /= ending;
-            }
-
-            // Convert finalPath to string and copy into the static char array
-            static char projectLocation[128]; // Static char array to hold the result path
-            std::string pathString = finalPath.string(); // Convert the path to a string
-
-            // Use strncpy_s to copy the string into the static char array safely
-            errno_t errCopy = strncpy_s(projectLocation, sizeof(projectLocation), pathString.c_str(), pathString.length());
-            if (errCopy != 0) {
-                throw std::runtime_error("Error copying the final path into projectLocation.");
-            }
-
-            return finalPath; // Return the std::filesystem::path (if needed)
-        }
-
-        throw std::runtime_error("USERPROFILE environment variable not found.");
-    }
-
-}
\ No newline at end of file
+    // The current user's standard directories. Looked up once, on first use, from
+    // the known folders on Windows and the XDG base and user directories on Linux;
+    // any that can't be determined are left empty.
+    struct PlatformDirectories {
+        std::filesystem::path home;
+        std::filesystem::path documents;    // XDG_DOCUMENTS_DIR, FOLDERID_Documents
+        std::filesystem::path config;       // XDG_CONFIG_HOME, FOLDERID_RoamingAppData
+        std::filesystem::path data;         // XDG_DATA_HOME, FOLDERID_LocalAppData
+        std::filesystem::path cache;        // XDG_CACHE_HOME, FOLDERID_LocalAppData
+    };
+
+    const PlatformDirectories& platformDirectories();
+
+    // Documents/VoltLine Projects: the default project root and new project location.
+    // Empty if there is no documents directory.
+    const std::filesystem::path& defaultProjectsPath();
+
+}
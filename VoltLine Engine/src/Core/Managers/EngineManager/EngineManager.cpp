@@ -0,0 +1,291 @@
+#include "EngineManager.h"
+
+#include "Core/Profiler/Profiler.h"
+#include "Core/Logging/HubLogger.h"
+
+namespace EngineManager {
+
+    namespace {
+
+        // Which job system and deque the current thread belongs to.
+        thread_local const JobSystem* currentSystem = nullptr;
+        thread_local int currentIndex = -1;
+
+        // Per-thread xorshift for picking steal victims.
+        thread_local uint32_t stealSeed = 0;
+
+        uint32_t nextRandom() {
+            if (stealSeed == 0)
+                stealSeed = static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())) | 1u;
+
+            stealSeed ^= stealSeed << 13;
+            stealSeed ^= stealSeed >> 17;
+            stealSeed ^= stealSeed << 5;
+            return stealSeed;
+        }
+
+    }
+
+    JobSystem::JobSystem(unsigned workerCount) {
+        if (workerCount == 0)
+            workerCount = std::max(2u, std::thread::hardware_concurrency()) - 1;   // hardware_concurrency() may be 0
+
+        mainThreadId = std::this_thread::get_id();
+
+        for (unsigned i = 0; i <= workerCount; ++i)
+            deques.push_back(std::make_unique<Deque>());
+
+        currentSystem = this;
+        currentIndex = static_cast<int>(workerCount);
+
+        for (unsigned i = 0; i < workerCount; ++i)
+            workers.emplace_back(&JobSystem::workerLoop, this, static_cast<int>(i));
+    }
+
+    JobSystem::~JobSystem() {
+        stopping.store(true);
+        epoch.fetch_add(1);
+        epoch.notify_all();
+
+        for (std::thread& worker : workers)
+            worker.join();
+
+        // Whatever never ran is simply dropped.
+        Job* job;
+        for (std::unique_ptr<Deque>& deque : deques)
+            while (deque->steal(job))
+                delete job;
+        while (injectionQueue.tryPop(job))
+            delete job;
+        for (Job* mainJob : mainThreadJobs)
+            delete mainJob;
+
+        if (currentSystem == this) {
+            currentSystem = nullptr;
+            currentIndex = -1;
+        }
+    }
+
+    void JobSystem::run(std::function<void()> job, JobCounter* counter) {
+        if (counter)
+            counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+        submit(new Job{ std::move(job), counter });
+    }
+
+    void JobSystem::runOnMainThread(std::function<void()> job, JobCounter* counter) {
+        if (counter)
+            counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(mainThreadMutex);
+        mainThreadJobs.push_back(new Job{ std::move(job), counter });
+    }
+
+    size_t JobSystem::pumpMainThread() {
+        std::vector<Job*> jobs;
+        {
+            std::lock_guard<std::mutex> lock(mainThreadMutex);
+            jobs.swap(mainThreadJobs);
+        }
+
+        for (Job* job : jobs)
+            execute(job);
+
+        return jobs.size();
+    }
+
+    void JobSystem::wait(JobCounter& counter) {
+        VOLT_PROFILE_SCOPE("JobSystem::wait");
+
+        int queueIndex = currentQueueIndex();
+        bool mainThread = isMainThread();
+
+        while (!counter.done()) {
+            // The main thread may be waiting on a job that needs it.
+            if (mainThread && pumpMainThread() > 0)
+                continue;
+
+            if (Job* job = findJob(queueIndex))
+                execute(job);
+            else
+                std::this_thread::yield();
+        }
+    }
+
+    int JobSystem::currentQueueIndex() const {
+        return currentSystem == this ? currentIndex : -1;
+    }
+
+    void JobSystem::submit(Job* job) {
+        int queueIndex = currentQueueIndex();
+
+        bool queued = queueIndex >= 0 ? deques[queueIndex]->push(job) : false;
+        if (!queued)
+            queued = injectionQueue.tryPush(job);
+
+        if (!queued) {
+            // Everything is full: run it right here rather than block.
+            execute(job);
+            return;
+        }
+
+        wakeWorkers();
+    }
+
+    void JobSystem::wakeWorkers() {
+        epoch.fetch_add(1);
+        if (sleepers.load() > 0)
+            epoch.notify_one();
+    }
+
+    JobSystem::Job* JobSystem::findJob(int queueIndex) {
+        Job* job = nullptr;
+
+        if (queueIndex >= 0 && deques[queueIndex]->pop(job))
+            return job;
+
+        if (injectionQueue.tryPop(job))
+            return job;
+
+        size_t count = deques.size();
+        size_t start = nextRandom() % count;
+        for (size_t i = 0; i < count; ++i) {
+            size_t victim = (start + i) % count;
+            if (static_cast<int>(victim) != queueIndex && deques[victim]->steal(job))
+                return job;
+        }
+
+        return nullptr;
+    }
+
+    void JobSystem::execute(Job* job) {
+        // A throwing job must not take its worker (and the process) down, and its
+        // counter still has to drop or whoever waits on it would spin forever.
+        try {
+            job->function();
+        }
+        catch (const std::exception& e) {
+            cf_Sink::logger->error(std::format("Unhandled exception in job: {}", e.what()));
+        }
+        catch (...) {
+            cf_Sink::logger->error("Unhandled exception in job.");
+        }
+
+        if (job->counter)
+            job->counter->pending.fetch_sub(1, std::memory_order_release);
+
+        delete job;
+    }
+
+    void JobSystem::workerLoop(int index) {
+        VOLT_PROFILE_THREAD(std::format("Job Worker {}", index).c_str());
+
+        currentSystem = this;
+        currentIndex = index;
+
+        constexpr int SpinRounds = 64;
+
+        while (!stopping.load(std::memory_order_relaxed)) {
+            Job* job = findJob(index);
+
+            for (int spin = 0; !job && spin < SpinRounds; ++spin) {
+                std::this_thread::yield();
+                job = findJob(index);
+            }
+
+            if (job) {
+                execute(job);
+                continue;
+            }
+
+            // Read the epoch before the last look, so a submit in between is never missed.
+            uint32_t seen = epoch.load();
+            if ((job = findJob(index)) != nullptr) {
+                execute(job);
+                continue;
+            }
+
+            sleepers.fetch_add(1);
+            if (!stopping.load())
+                epoch.wait(seen);
+            sleepers.fetch_sub(1);
+        }
+
+        currentSystem = nullptr;
+        currentIndex = -1;
+    }
+
+    JobGraph::NodeId JobGraph::add(std::function<void()> job) {
+        Node& node = nodes.emplace_back();
+        node.job = std::move(job);
+        return nodes.size() - 1;
+    }
+
+    void JobGraph::precede(NodeId before, NodeId after) {
+        nodes[before].successors.push_back(after);
+        ++nodes[after].predecessorCount;
+    }
+
+    void JobGraph::run(JobSystem& system, JobCounter& counter) {
+        for (Node& node : nodes) {
+            node.remaining.store(node.predecessorCount, std::memory_order_relaxed);
+            node.cancelled.store(false, std::memory_order_relaxed);
+        }
+
+        failed.store(false, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(skippedMutex);
+            skipped.clear();
+        }
+
+        for (NodeId id = 0; id < nodes.size(); ++id) {
+            if (nodes[id].predecessorCount == 0)
+                schedule(system, counter, id);
+        }
+    }
+
+    std::vector<JobGraph::NodeId> JobGraph::getSkippedNodes() const {
+        std::lock_guard<std::mutex> lock(skippedMutex);
+        return skipped;
+    }
+
+    void JobGraph::schedule(JobSystem& system, JobCounter& counter, NodeId id) {
+        system.run([this, &system, &counter, id]() {
+            Node& node = nodes[id];
+
+            bool succeeded = false;
+            if (node.cancelled.load(std::memory_order_acquire)) {
+                cf_Sink::logger->warn(std::format("Job graph node {} skipped: a node it depends on failed.", id));
+
+                std::lock_guard<std::mutex> lock(skippedMutex);
+                skipped.push_back(id);
+            }
+            else {
+                try {
+                    node.job();
+                    succeeded = true;
+                }
+                catch (const std::exception& e) {
+                    cf_Sink::logger->error(std::format("Job graph node {} threw: {}", id, e.what()));
+                }
+                catch (...) {
+                    cf_Sink::logger->error(std::format("Job graph node {} threw.", id));
+                }
+            }
+
+            if (!succeeded)
+                failed.store(true, std::memory_order_release);
+
+            // Successors are queued before this job's own count is released, so the
+            // counter can't touch zero while the graph still has work left. Those of a
+            // failed node are still released, but only to be skipped in turn.
+            for (NodeId successor : node.successors) {
+                if (!succeeded)
+                    nodes[successor].cancelled.store(true, std::memory_order_relaxed);
+                if (nodes[successor].remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    schedule(system, counter, successor);
+            }
+        }, &counter);
+    }
+
+}
@@ -1,3 +1,167 @@
 #pragma once
 
-#include "pch.h"
\ No newline at end of file
+#include "pch.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+#include "Core/Threading/MPMCQueue.h"
+#include "Core/Threading/WorkStealingDeque.h"
+
+namespace EngineManager {
+
+    class JobSystem;
+
+    // Counts outstanding jobs. Pass one to JobSystem::run for every job in a batch,
+    // then JobSystem::wait on it.
+    class JobCounter {
+    public:
+        bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+        int value() const { return pending.load(std::memory_order_acquire); }
+
+    private:
+        friend class JobSystem;
+        std::atomic<int> pending{ 0 };
+    };
+
+    // Work-stealing job system: one worker per core (minus the main thread), each
+    // with its own lock-free deque. Jobs spawned from a worker go to that worker's
+    // deque; idle workers steal from the others. Jobs submitted from other threads
+    // go through a shared lock-free injection queue.
+    //
+    // Waiting never just blocks: a thread inside wait() runs other jobs until its
+    // counter drops to zero, so jobs may freely spawn and wait on sub-jobs.
+    //
+    // GL calls must stay on the main thread: runOnMainThread() queues work that the
+    // main loop runs in pumpMainThread() (or while the main thread waits).
+    class JobSystem {
+    public:
+        // 0 picks hardware_concurrency() - 1. The constructing thread becomes the main thread.
+        explicit JobSystem(unsigned workerCount = 0);
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        void run(std::function<void()> job, JobCounter* counter = nullptr);
+        void wait(JobCounter& counter);
+
+        // Splits [begin, end) into chunks of grainSize (0 = pick one from the worker
+        // count) and calls body(first, last) for each in parallel. Returns when all
+        // chunks are done; the calling thread works on them too.
+        template<typename Body>
+        void parallelFor(size_t begin, size_t end, size_t grainSize, Body&& body) {
+            if (begin >= end)
+                return;
+
+            size_t count = end - begin;
+            if (grainSize == 0)
+                grainSize = std::max<size_t>(1, count / ((getWorkerCount() + 1) * 4));
+
+            if (count <= grainSize) {
+                body(begin, end);
+                return;
+            }
+
+            JobCounter counter;
+            size_t first = begin;
+            for (; first + grainSize < end; first += grainSize) {
+                size_t last = first + grainSize;
+                run([&body, first, last]() { body(first, last); }, &counter);
+            }
+
+            // The tail runs here while the workers chew through the rest. The queued
+            // chunks use body and counter, so they are waited for even if it throws.
+            try {
+                body(first, end);
+            }
+            catch (...) {
+                wait(counter);
+                throw;
+            }
+            wait(counter);
+        }
+
+        void runOnMainThread(std::function<void()> job, JobCounter* counter = nullptr);
+
+        // Main thread only: runs everything queued with runOnMainThread. Returns how many jobs ran.
+        size_t pumpMainThread();
+
+        bool isMainThread() const { return std::this_thread::get_id() == mainThreadId; }
+        unsigned getWorkerCount() const { return static_cast<unsigned>(workers.size()); }
+
+    private:
+        struct Job {
+            std::function<void()> function;
+            JobCounter* counter;
+        };
+
+        using Deque = Threading::WorkStealingDeque<Job*>;
+
+        std::vector<std::thread> workers;
+        // One deque per worker plus one for the main thread (the last).
+        std::vector<std::unique_ptr<Deque>> deques;
+        Threading::MPMCQueue<Job*> injectionQueue{ 16384 };
+
+        std::mutex mainThreadMutex;
+        std::vector<Job*> mainThreadJobs;
+        std::thread::id mainThreadId;
+
+        std::atomic<uint32_t> epoch{ 0 };
+        std::atomic<int> sleepers{ 0 };
+        std::atomic<bool> stopping{ false };
+
+        int currentQueueIndex() const;
+        void submit(Job* job);
+        Job* findJob(int queueIndex);
+        void execute(Job* job);
+        void workerLoop(int index);
+        void wakeWorkers();
+    };
+
+    // Small dependency graph of jobs: add nodes, declare which must finish before
+    // which, then run it. Every node is counted on the counter passed to run(); the
+    // graph must stay alive until that counter reaches zero.
+    //
+    // A node that throws fails the graph: the exception is logged, and every node
+    // downstream of it is skipped (and logged) instead of run.
+    class JobGraph {
+    public:
+        using NodeId = size_t;
+
+        NodeId add(std::function<void()> job);
+        void precede(NodeId before, NodeId after);
+        void run(JobSystem& system, JobCounter& counter);
+
+        // Valid once the counter passed to run() has reached zero.
+        bool hasFailed() const { return failed.load(std::memory_order_acquire); }
+        std::vector<NodeId> getSkippedNodes() const;
+
+    private:
+        struct Node {
+            std::function<void()> job;
+            std::vector<NodeId> successors;
+            int predecessorCount = 0;
+            std::atomic<int> remaining{ 0 };
+            // Set when a predecessor threw or was skipped itself.
+            std::atomic<bool> cancelled{ false };
+        };
+
+        std::deque<Node> nodes;
+
+        std::atomic<bool> failed{ false };
+        mutable std::mutex skippedMutex;
+        std::vector<NodeId> skipped;
+
+        void schedule(JobSystem& system, JobCounter& counter, NodeId id);
+    };
+
+    // The hub's job system. Touch it first from the main thread (Window::Init does).
+    inline JobSystem& jobSystem() {
+        static JobSystem system;
+        return system;
+    }
+
+}
@@ -1,61 +1,294 @@
-#pragma
+#pragma once
 
 #include "pch.h"
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <bitset>
+#include <cctype>
+#include <charconv>
+#include <optional>
+
 #include "Core/Window/Window.h"
 
+// Key bindings are compiled once, when they are registered, into a table indexed by
+// GLFW key code. Matching a key event is then a bitset update plus a lookup into the
+// handful of bindings triggered by that key: no parsing, no allocation.
 class KeyBindingManager {
 public:
+    static constexpr int KeyCount = GLFW_KEY_LAST + 1;
+    static constexpr int ModifierMask = GLFW_MOD_SHIFT | GLFW_MOD_CONTROL | GLFW_MOD_ALT | GLFW_MOD_SUPER;
+
     std::unordered_map<std::string, Action> keyBindings;
 
     void registerKeyBinding(const std::string& keyCombo, Action action) {
         keyBindings[keyCombo] = action;
+        compile();
+    }
+
+    void unregisterAction(Action action) {
+        std::erase_if(keyBindings, [action](const auto& binding) { return binding.second == action; });
+        compile();
     }
 
-    bool checkKeyCombination(const std::vector<int>& pressedKeys, const std::string& keyCombo) {
-        std::vector<int> expectedKeys = parseKeyCombo(keyCombo);
-        if (pressedKeys == expectedKeys) {
-            return true;
+    void clearKeyBindings() {
+        keyBindings.clear();
+        compile();
+    }
+
+    // Feeds a raw GLFW key event. Returns the bound action when the event completes a
+    // registered combination.
+    std::optional<Action> onKeyEvent(int key, int action, int mods) {
+        if (key < 0 || key >= KeyCount)
+            return std::nullopt;
+
+        if (action == GLFW_PRESS) {
+            pressedKeys.set(key);
+        }
+        else if (action == GLFW_RELEASE) {
+            pressedKeys.reset(key);
+            return std::nullopt;
+        }
+        else {
+            // Key repeats do not re-trigger bindings.
+            return std::nullopt;
+        }
+
+        int activeMods = (mods | modsFromPressedKeys()) & ModifierMask;
+
+        const BindingRange& range = keyRanges[key];
+        for (uint16_t i = range.first; i < range.first + range.count; ++i) {
+            const KeyCombination& combo = compiled[i];
+            if (checkKeyCombination(combo, key, activeMods))
+                return combo.action;
         }
-        return false;
+
+        return std::nullopt;
     }
 
-    std::vector<int> parseKeyCombo(const std::string& keyCombo) {
-        std::vector<int> keys;
-        std::vector<std::string> components = splitString(keyCombo, '+');
+    bool isKeyDown(int key) const {
+        return key >= 0 && key < KeyCount && pressedKeys.test(key);
+    }
 
-        for (const auto& component : components) {
-            if (component == "SHIFT") {
-                keys.push_back(GLFW_KEY_LEFT_SHIFT);
-            }
-            else if (component == "CTRL") {
-                keys.push_back(GLFW_KEY_LEFT_CONTROL);
-            }
-            else if (component == "ESC") {
-                keys.push_back(GLFW_KEY_ESCAPE);
-            }
-            else if (component == "ALT") {
-                keys.push_back(GLFW_KEY_LEFT_ALT);
+    // A combination matches when its trigger key is the one just pressed and every
+    // modifier it names is held. Extra held modifiers are tolerated, matching the old
+    // "all expected keys are down" behaviour.
+    static bool checkKeyCombination(const KeyCombination& combo, int key, int activeMods) {
+        return combo.key == key && (activeMods & combo.modifier) == combo.modifier;
+    }
+
+    // Parses "CTRL+SHIFT+S" style strings. The last non-modifier key is the trigger;
+    // a combination made only of modifiers (e.g. "CTRL+ALT") triggers on its last one.
+    static std::optional<KeyCombination> parseKeyCombo(std::string_view keyCombo, Action action = Action::CloseApp) {
+        KeyCombination combo{ GLFW_KEY_UNKNOWN, 0, action };
+        int lastModifierKey = GLFW_KEY_UNKNOWN;
+
+        while (!keyCombo.empty()) {
+            size_t split = keyCombo.find('+');
+            std::string_view component = keyCombo.substr(0, split);
+            keyCombo = split == std::string_view::npos ? std::string_view() : keyCombo.substr(split + 1);
+
+            if (component.empty())
+                continue;
+
+            int modifier = modifierFromName(component);
+            if (modifier != 0) {
+                combo.modifier |= modifier;
+                lastModifierKey = modifierKeyFromName(component, modifier);
+                continue;
             }
-            else {
+
+            int key = keyFromName(component);
+            if (key == GLFW_KEY_UNKNOWN) {
                 std::cout << "Unrecognized key: " << component << std::endl;
+                return std::nullopt;
             }
+
+            combo.key = key;
         }
 
-        return keys;
+        if (combo.key == GLFW_KEY_UNKNOWN) {
+            if (lastModifierKey == GLFW_KEY_UNKNOWN)
+                return std::nullopt;
+
+            combo.key = lastModifierKey;
+        }
+
+        return combo;
+    }
+
+    static std::optional<Action> actionFromName(std::string_view name) {
+        if (equalsIgnoreCase(name, "Escape") || equalsIgnoreCase(name, "CloseApp"))
+            return Action::CloseApp;
+
+        return std::nullopt;
     }
 
 private:
-    std::vector<std::string> splitString(const std::string& str, char delimiter) {
-        std::vector<std::string> result;
-        std::stringstream ss(str);
-        std::string token;
+    struct BindingRange {
+        uint16_t first = 0;
+        uint16_t count = 0;
+    };
+
+    std::bitset<KeyCount> pressedKeys;
+    std::vector<KeyCombination> compiled;
+    std::array<BindingRange, KeyCount> keyRanges{};
 
-        while (std::getline(ss, token, delimiter)) {
-            result.push_back(token);
+    void compile() {
+        compiled.clear();
+
+        for (const auto& [keyCombo, action] : keyBindings) {
+            std::optional<KeyCombination> combo = parseKeyCombo(keyCombo, action);
+            if (!combo)
+                continue;
+
+            compiled.push_back(*combo);
+
+            // Side-agnostic modifiers: "CTRL" alone should fire for either control key.
+            int twin = twinModifierKey(combo->key);
+            if (twin != GLFW_KEY_UNKNOWN)
+                compiled.push_back({ twin, combo->modifier, action });
+        }
+
+        // Most specific combinations first, so CTRL+SHIFT+S wins over CTRL+S.
+        std::sort(compiled.begin(), compiled.end(), [](const KeyCombination& a, const KeyCombination& b) {
+            if (a.key != b.key)
+                return a.key < b.key;
+            return std::popcount(static_cast<unsigned>(a.modifier)) > std::popcount(static_cast<unsigned>(b.modifier));
+            });
+
+        keyRanges.fill({});
+        for (size_t i = 0; i < compiled.size(); ++i) {
+            BindingRange& range = keyRanges[compiled[i].key];
+            if (range.count == 0)
+                range.first = static_cast<uint16_t>(i);
+            ++range.count;
+        }
+    }
+
+    int modsFromPressedKeys() const {
+        int mods = 0;
+        if (pressedKeys.test(GLFW_KEY_LEFT_SHIFT) || pressedKeys.test(GLFW_KEY_RIGHT_SHIFT))
+            mods |= GLFW_MOD_SHIFT;
+        if (pressedKeys.test(GLFW_KEY_LEFT_CONTROL) || pressedKeys.test(GLFW_KEY_RIGHT_CONTROL))
+            mods |= GLFW_MOD_CONTROL;
+        if (pressedKeys.test(GLFW_KEY_LEFT_ALT) || pressedKeys.test(GLFW_KEY_RIGHT_ALT))
+            mods |= GLFW_MOD_ALT;
+        if (pressedKeys.test(GLFW_KEY_LEFT_SUPER) || pressedKeys.test(GLFW_KEY_RIGHT_SUPER))
+            mods |= GLFW_MOD_SUPER;
+        return mods;
+    }
+
+    static int twinModifierKey(int key) {
+        switch (key) {
+        case GLFW_KEY_LEFT_SHIFT: return GLFW_KEY_RIGHT_SHIFT;
+        case GLFW_KEY_RIGHT_SHIFT: return GLFW_KEY_LEFT_SHIFT;
+        case GLFW_KEY_LEFT_CONTROL: return GLFW_KEY_RIGHT_CONTROL;
+        case GLFW_KEY_RIGHT_CONTROL: return GLFW_KEY_LEFT_CONTROL;
+        case GLFW_KEY_LEFT_ALT: return GLFW_KEY_RIGHT_ALT;
+        case GLFW_KEY_RIGHT_ALT: return GLFW_KEY_LEFT_ALT;
+        case GLFW_KEY_LEFT_SUPER: return GLFW_KEY_RIGHT_SUPER;
+        case GLFW_KEY_RIGHT_SUPER: return GLFW_KEY_LEFT_SUPER;
+        default: return GLFW_KEY_UNKNOWN;
+        }
+    }
+
+    static bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+            return std::toupper(static_cast<unsigned char>(x)) == std::toupper(static_cast<unsigned char>(y));
+            });
+    }
+
+    static int modifierFromName(std::string_view name) {
+        if (equalsIgnoreCase(name, "SHIFT") || equalsIgnoreCase(name, "LEFT_SHIFT") || equalsIgnoreCase(name, "RIGHT_SHIFT"))
+            return GLFW_MOD_SHIFT;
+        if (equalsIgnoreCase(name, "CTRL") || equalsIgnoreCase(name, "CONTROL") || equalsIgnoreCase(name, "LEFT_CONTROL") || equalsIgnoreCase(name, "RIGHT_CONTROL"))
+            return GLFW_MOD_CONTROL;
+        if (equalsIgnoreCase(name, "ALT") || equalsIgnoreCase(name, "LEFT_ALT") || equalsIgnoreCase(name, "RIGHT_ALT"))
+            return GLFW_MOD_ALT;
+        if (equalsIgnoreCase(name, "SUPER") || equalsIgnoreCase(name, "WIN") || equalsIgnoreCase(name, "CMD") || equalsIgnoreCase(name, "LEFT_SUPER") || equalsIgnoreCase(name, "RIGHT_SUPER"))
+            return GLFW_MOD_SUPER;
+        return 0;
+    }
+
+    static int modifierKeyFromName(std::string_view name, int modifier) {
+        bool right = name.size() > 6 && equalsIgnoreCase(name.substr(0, 6), "RIGHT_");
+
+        switch (modifier) {
+        case GLFW_MOD_SHIFT: return right ? GLFW_KEY_RIGHT_SHIFT : GLFW_KEY_LEFT_SHIFT;
+        case GLFW_MOD_CONTROL: return right ? GLFW_KEY_RIGHT_CONTROL : GLFW_KEY_LEFT_CONTROL;
+        case GLFW_MOD_ALT: return right ? GLFW_KEY_RIGHT_ALT : GLFW_KEY_LEFT_ALT;
+        case GLFW_MOD_SUPER: return right ? GLFW_KEY_RIGHT_SUPER : GLFW_KEY_LEFT_SUPER;
+        default: return GLFW_KEY_UNKNOWN;
         }
-        return result;
+    }
+
+    static int keyFromName(std::string_view name) {
+        struct NamedKey {
+            std::string_view name;
+            int key;
+        };
+
+        static constexpr NamedKey namedKeys[] = {
+            { "ESC", GLFW_KEY_ESCAPE }, { "ESCAPE", GLFW_KEY_ESCAPE },
+            { "ENTER", GLFW_KEY_ENTER }, { "RETURN", GLFW_KEY_ENTER },
+            { "TAB", GLFW_KEY_TAB }, { "BACKSPACE", GLFW_KEY_BACKSPACE },
+            { "INSERT", GLFW_KEY_INSERT }, { "INS", GLFW_KEY_INSERT },
+            { "DELETE", GLFW_KEY_DELETE }, { "DEL", GLFW_KEY_DELETE },
+            { "RIGHT", GLFW_KEY_RIGHT }, { "LEFT", GLFW_KEY_LEFT },
+            { "DOWN", GLFW_KEY_DOWN }, { "UP", GLFW_KEY_UP },
+            { "PAGE_UP", GLFW_KEY_PAGE_UP }, { "PAGEUP", GLFW_KEY_PAGE_UP },
+            { "PAGE_DOWN", GLFW_KEY_PAGE_DOWN }, { "PAGEDOWN", GLFW_KEY_PAGE_DOWN },
+            { "HOME", GLFW_KEY_HOME }, { "END", GLFW_KEY_END },
+            { "CAPS_LOCK", GLFW_KEY_CAPS_LOCK }, { "SCROLL_LOCK", GLFW_KEY_SCROLL_LOCK },
+            { "NUM_LOCK", GLFW_KEY_NUM_LOCK }, { "PRINT_SCREEN", GLFW_KEY_PRINT_SCREEN },
+            { "PAUSE", GLFW_KEY_PAUSE }, { "MENU", GLFW_KEY_MENU },
+            { "SPACE", GLFW_KEY_SPACE }, { "APOSTROPHE", GLFW_KEY_APOSTROPHE },
+            { "COMMA", GLFW_KEY_COMMA }, { "MINUS", GLFW_KEY_MINUS },
+            { "PERIOD", GLFW_KEY_PERIOD }, { "SLASH", GLFW_KEY_SLASH },
+            { "SEMICOLON", GLFW_KEY_SEMICOLON }, { "EQUAL", GLFW_KEY_EQUAL },
+            { "LEFT_BRACKET", GLFW_KEY_LEFT_BRACKET }, { "BACKSLASH", GLFW_KEY_BACKSLASH },
+            { "RIGHT_BRACKET", GLFW_KEY_RIGHT_BRACKET }, { "GRAVE_ACCENT", GLFW_KEY_GRAVE_ACCENT },
+            { "WORLD_1", GLFW_KEY_WORLD_1 }, { "WORLD_2", GLFW_KEY_WORLD_2 },
+            { "KP_DECIMAL", GLFW_KEY_KP_DECIMAL }, { "KP_DIVIDE", GLFW_KEY_KP_DIVIDE },
+            { "KP_MULTIPLY", GLFW_KEY_KP_MULTIPLY }, { "KP_SUBTRACT", GLFW_KEY_KP_SUBTRACT },
+            { "KP_ADD", GLFW_KEY_KP_ADD }, { "KP_ENTER", GLFW_KEY_KP_ENTER },
+            { "KP_EQUAL", GLFW_KEY_KP_EQUAL },
+            { "'", GLFW_KEY_APOSTROPHE }, { ",", GLFW_KEY_COMMA }, { "-", GLFW_KEY_MINUS },
+            { ".", GLFW_KEY_PERIOD }, { "/", GLFW_KEY_SLASH }, { ";", GLFW_KEY_SEMICOLON },
+            { "=", GLFW_KEY_EQUAL }, { "[", GLFW_KEY_LEFT_BRACKET }, { "\\", GLFW_KEY_BACKSLASH },
+            { "]", GLFW_KEY_RIGHT_BRACKET }, { "`", GLFW_KEY_GRAVE_ACCENT },
+        };
+
+        // Letters and digits map straight onto their ASCII codes in GLFW.
+        if (name.size() == 1) {
+            char c = static_cast<char>(std::toupper(static_cast<unsigned char>(name[0])));
+            if (c >= 'A' && c <= 'Z')
+                return GLFW_KEY_A + (c - 'A');
+            if (c >= '0' && c <= '9')
+                return GLFW_KEY_0 + (c - '0');
+        }
+
+        // F1 - F25
+        if (name.size() >= 2 && name.size() <= 3 && std::toupper(static_cast<unsigned char>(name[0])) == 'F') {
+            int number = 0;
+            auto [ptr, ec] = std::from_chars(name.data() + 1, name.data() + name.size(), number);
+            if (ec == std::errc() && ptr == name.data() + name.size() && number >= 1 && number <= 25)
+                return GLFW_KEY_F1 + (number - 1);
+        }
+
+        // KP_0 - KP_9
+        if (name.size() == 4 && equalsIgnoreCase(name.substr(0, 3), "KP_") && name[3] >= '0' && name[3] <= '9')
+            return GLFW_KEY_KP_0 + (name[3] - '0');
+
+        for (const NamedKey& namedKey : namedKeys) {
+            if (equalsIgnoreCase(name, namedKey.name))
+                return namedKey.key;
+        }
+
+        return GLFW_KEY_UNKNOWN;
     }
 };
 
-KeyBindingManager keyBindingManager;
+inline KeyBindingManager keyBindingManager;
@@ -0,0 +1,434 @@
+#include "ProjectFile.h"
+
+#include <algorithm>
+#include <cctype>
+
+#include "Core/FileSystem/AtomicFile.h"
+#include "Core/Profiler/Profiler.h"
+
+namespace ProjectManager {
+
+    using namespace ProjectFormat;
+
+    namespace {
+
+        // Section payload encodings, little endian:
+        //   META  int64 created, int64 modified, then name, description, template
+        //         and engine version as uint32 length + bytes. Newer minor versions
+        //         may append fields; readers ignore trailing bytes.
+        //   THMB  uint32 width, uint32 height, width * height RGBA8 pixels.
+        //   ASET  uint32 count, then per asset uint64 size, uint64 hash, path.
+
+        class Encoder {
+        public:
+            template<typename T>
+            void put(const T& value) {
+                const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+                out.insert(out.end(), bytes, bytes + sizeof(T));
+            }
+
+            void putString(std::string_view text) {
+                put(static_cast<uint32_t>(text.size()));
+                out.insert(out.end(), text.begin(), text.end());
+            }
+
+            void putBytes(std::span<const uint8_t> bytes) {
+                out.insert(out.end(), bytes.begin(), bytes.end());
+            }
+
+            std::vector<uint8_t> take() { return std::move(out); }
+
+        private:
+            std::vector<uint8_t> out;
+        };
+
+        class Decoder {
+        public:
+            explicit Decoder(std::span<const uint8_t> bytes) : bytes(bytes) {}
+
+            template<typename T>
+            bool get(T& value) {
+                if (remaining() < sizeof(T))
+                    return false;
+                std::memcpy(&value, bytes.data() + offset, sizeof(T));
+                offset += sizeof(T);
+                return true;
+            }
+
+            bool getString(string& text) {
+                uint32_t size = 0;
+                if (!get(size) || remaining() < size)
+                    return false;
+                text.assign(reinterpret_cast<const char*>(bytes.data() + offset), size);
+                offset += size;
+                return true;
+            }
+
+            bool getBytes(size_t size, std::span<const uint8_t>& view) {
+                if (remaining() < size)
+                    return false;
+                view = bytes.subspan(offset, size);
+                offset += size;
+                return true;
+            }
+
+            size_t remaining() const { return bytes.size() - offset; }
+
+        private:
+            std::span<const uint8_t> bytes;
+            size_t offset = 0;
+        };
+
+        uint64_t alignUp(uint64_t value) {
+            return (value + SectionAlignment - 1) & ~(SectionAlignment - 1);
+        }
+
+        uint32_t headerChecksum(FileHeader header) {
+            header.headerChecksum = 0;
+            return checksum({ reinterpret_cast<const uint8_t*>(&header), sizeof(header) });
+        }
+
+        std::span<const uint8_t> tableBytes(std::span<const SectionEntry> table) {
+            return { reinterpret_cast<const uint8_t*>(table.data()), table.size_bytes() };
+        }
+
+        bool decodeMetadata(std::span<const uint8_t> bytes, ProjectMetadata& metadata) {
+            Decoder decoder(bytes);
+            return decoder.get(metadata.createdTime) && decoder.get(metadata.modifiedTime)
+                && decoder.getString(metadata.name) && decoder.getString(metadata.description)
+                && decoder.getString(metadata.templateName) && decoder.getString(metadata.engineVersion);
+        }
+
+        bool decodeThumbnail(std::span<const uint8_t> bytes, ProjectThumbnail& thumbnail) {
+            Decoder decoder(bytes);
+            if (!decoder.get(thumbnail.width) || !decoder.get(thumbnail.height))
+                return false;
+
+            uint64_t pixelBytes = uint64_t(thumbnail.width) * thumbnail.height * 4;
+            return pixelBytes <= decoder.remaining() && decoder.getBytes(static_cast<size_t>(pixelBytes), thumbnail.pixels);
+        }
+
+        bool decodeAssetManifest(std::span<const uint8_t> bytes, std::vector<AssetEntry>& assets) {
+            Decoder decoder(bytes);
+            uint32_t count = 0;
+            if (!decoder.get(count) || count > decoder.remaining() / (sizeof(uint64_t) * 2 + sizeof(uint32_t)))
+                return false;
+
+            assets.resize(count);
+            for (AssetEntry& asset : assets) {
+                if (!decoder.get(asset.size) || !decoder.get(asset.hash) || !decoder.getString(asset.path))
+                    return false;
+            }
+            return true;
+        }
+
+    }
+
+    uint32_t ProjectFormat::checksum(std::span<const uint8_t> bytes, uint32_t hash) {
+        for (uint8_t byte : bytes) {
+            hash ^= byte;
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    string ProjectFormat::sectionName(uint32_t type) {
+        string name(4, ' ');
+        for (int i = 0; i < 4; ++i) {
+            char c = static_cast<char>((type >> (i * 8)) & 0xff);
+            name[i] = std::isprint(static_cast<unsigned char>(c)) ? c : '?';
+        }
+        return name;
+    }
+
+    bool ProjectFileReader::open(const std::filesystem::path& path, string& error) {
+        VOLT_PROFILE_SCOPE("ProjectFileReader::open");
+
+        close();
+
+        if (!file.open(path)) {
+            error = std::format("could not open {}", path.string());
+            return false;
+        }
+
+        std::span<const uint8_t> bytes = file.bytes();
+        if (bytes.size() < sizeof(FileHeader)) {
+            error = "file is too small to be a VoltLine project";
+            close();
+            return false;
+        }
+
+        std::memcpy(&header, bytes.data(), sizeof(FileHeader));
+
+        string problem;
+        if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0)
+            problem = "not a VoltLine project file";
+        else if (header.versionMajor != VersionMajor)
+            problem = std::format("unsupported project format version {}.{}", header.versionMajor, header.versionMinor);
+        else if (header.headerChecksum != headerChecksum(header))
+            problem = "header checksum mismatch";
+        else if (header.fileSize != bytes.size())
+            problem = std::format("file is {} bytes, header says {}", bytes.size(), header.fileSize);
+        else if (header.headerSize < sizeof(FileHeader) || header.sectionTableOffset < header.headerSize || header.sectionTableOffset > bytes.size()
+            || header.sectionCount > (bytes.size() - header.sectionTableOffset) / sizeof(SectionEntry))
+            problem = "section table is out of bounds";
+
+        if (!problem.empty()) {
+            error = std::move(problem);
+            close();
+            return false;
+        }
+
+        sections.resize(header.sectionCount);
+        std::memcpy(sections.data(), bytes.data() + header.sectionTableOffset, sections.size() * sizeof(SectionEntry));
+
+        if (checksum(tableBytes(sections)) != header.sectionTableChecksum) {
+            error = "section table checksum mismatch";
+            close();
+            return false;
+        }
+
+        for (const SectionEntry& section : sections) {
+            if (section.offset > bytes.size() || section.size > bytes.size() - section.offset) {
+                error = std::format("section {} is out of bounds", sectionName(section.type));
+                close();
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void ProjectFileReader::close() {
+        file.close();
+        header = {};
+        sections.clear();
+    }
+
+    const SectionEntry* ProjectFileReader::findSection(SectionType type) const {
+        for (const SectionEntry& section : sections) {
+            if (section.type == static_cast<uint32_t>(type))
+                return &section;
+        }
+        return nullptr;
+    }
+
+    std::optional<std::span<const uint8_t>> ProjectFileReader::sectionBytes(SectionType type, string& error) const {
+        const SectionEntry* section = findSection(type);
+        if (!section) {
+            error = std::format("no {} section", sectionName(static_cast<uint32_t>(type)));
+            return std::nullopt;
+        }
+
+        std::span<const uint8_t> payload = file.bytes().subspan(section->offset, section->size);
+        if (checksum(payload) != section->checksum) {
+            error = std::format("{} section checksum mismatch", sectionName(section->type));
+            return std::nullopt;
+        }
+
+        return payload;
+    }
+
+    std::optional<ProjectMetadata> ProjectFileReader::readMetadata(string& error) const {
+        std::optional<std::span<const uint8_t>> bytes = sectionBytes(SectionType::Metadata, error);
+        if (!bytes)
+            return std::nullopt;
+
+        ProjectMetadata metadata;
+        if (!decodeMetadata(*bytes, metadata)) {
+            error = "META section is truncated";
+            return std::nullopt;
+        }
+
+        return metadata;
+    }
+
+    std::optional<ProjectThumbnail> ProjectFileReader::readThumbnail(string& error) const {
+        std::optional<std::span<const uint8_t>> bytes = sectionBytes(SectionType::Thumbnail, error);
+        if (!bytes)
+            return std::nullopt;
+
+        ProjectThumbnail thumbnail;
+        if (!decodeThumbnail(*bytes, thumbnail)) {
+            error = "THMB section is truncated";
+            return std::nullopt;
+        }
+
+        return thumbnail;
+    }
+
+    std::optional<std::vector<AssetEntry>> ProjectFileReader::readAssetManifest(string& error) const {
+        std::optional<std::span<const uint8_t>> bytes = sectionBytes(SectionType::AssetManifest, error);
+        if (!bytes)
+            return std::nullopt;
+
+        std::vector<AssetEntry> assets;
+        if (!decodeAssetManifest(*bytes, assets)) {
+            error = "ASET section is truncated";
+            return std::nullopt;
+        }
+
+        return assets;
+    }
+
+    void ProjectFileWriter::setMetadata(const ProjectMetadata& metadata) {
+        Encoder encoder;
+        encoder.put(metadata.createdTime);
+        encoder.put(metadata.modifiedTime);
+        encoder.putString(metadata.name);
+        encoder.putString(metadata.description);
+        encoder.putString(metadata.templateName);
+        encoder.putString(metadata.engineVersion);
+        setSection(static_cast<uint32_t>(SectionType::Metadata), encoder.take());
+    }
+
+    void ProjectFileWriter::setThumbnail(uint32_t width, uint32_t height, std::span<const uint8_t> rgbaPixels) {
+        Encoder encoder;
+        encoder.put(width);
+        encoder.put(height);
+        encoder.putBytes(rgbaPixels.first(std::min<size_t>(rgbaPixels.size(), size_t(width) * height * 4)));
+        setSection(static_cast<uint32_t>(SectionType::Thumbnail), encoder.take());
+    }
+
+    void ProjectFileWriter::setAssetManifest(const std::vector<AssetEntry>& assets) {
+        Encoder encoder;
+        encoder.put(static_cast<uint32_t>(assets.size()));
+        for (const AssetEntry& asset : assets) {
+            encoder.put(asset.size);
+            encoder.put(asset.hash);
+            encoder.putString(asset.path);
+        }
+        setSection(static_cast<uint32_t>(SectionType::AssetManifest), encoder.take());
+    }
+
+    void ProjectFileWriter::setSection(uint32_t type, std::vector<uint8_t> payload) {
+        auto existing = std::find_if(payloads.begin(), payloads.end(), [type](const auto& entry) { return entry.first == type; });
+        if (existing != payloads.end()) {
+            existing->second = std::move(payload);
+            return;
+        }
+
+        if (type == static_cast<uint32_t>(SectionType::Metadata))
+            payloads.emplace(payloads.begin(), type, std::move(payload));
+        else
+            payloads.emplace_back(type, std::move(payload));
+    }
+
+    std::vector<uint8_t> ProjectFileWriter::build() const {
+        std::vector<SectionEntry> table(payloads.size());
+
+        uint64_t offset = alignUp(sizeof(FileHeader) + table.size() * sizeof(SectionEntry));
+        for (size_t i = 0; i < payloads.size(); ++i) {
+            const std::vector<uint8_t>& payload = payloads[i].second;
+            table[i] = { payloads[i].first, 0, offset, payload.size(), checksum(payload), 0 };
+            offset = alignUp(offset + payload.size());
+        }
+
+        uint64_t fileSize = table.empty() ? sizeof(FileHeader) : table.back().offset + table.back().size;
+
+        FileHeader header{};
+        std::memcpy(header.magic, Magic, sizeof(Magic));
+        header.versionMajor = VersionMajor;
+        header.versionMinor = VersionMinor;
+        header.headerSize = sizeof(FileHeader);
+        header.sectionCount = static_cast<uint32_t>(table.size());
+        header.sectionTableOffset = sizeof(FileHeader);
+        header.fileSize = fileSize;
+        header.sectionTableChecksum = checksum(tableBytes(table));
+        header.headerChecksum = headerChecksum(header);
+
+        std::vector<uint8_t> out(static_cast<size_t>(fileSize), 0);
+        std::memcpy(out.data(), &header, sizeof(header));
+        if (!table.empty())
+            std::memcpy(out.data() + sizeof(FileHeader), table.data(), table.size() * sizeof(SectionEntry));
+
+        for (size_t i = 0; i < payloads.size(); ++i)
+            std::copy(payloads[i].second.begin(), payloads[i].second.end(), out.begin() + table[i].offset);
+
+        return out;
+    }
+
+    bool ProjectFileWriter::write(const std::filesystem::path& path, string& error) const {
+        VOLT_PROFILE_SCOPE("ProjectFileWriter::write");
+
+        std::vector<uint8_t> bytes = build();
+        return FileSystem::writeFileAtomically(path, { reinterpret_cast<const char*>(bytes.data()), bytes.size() }, error);
+    }
+
+    ValidationReport validateProjectFile(const std::filesystem::path& path) {
+        ValidationReport report;
+
+        ProjectFileReader reader;
+        string error;
+        if (!reader.open(path, error)) {
+            report.errors.push_back(error);
+            return report;
+        }
+
+        const FileHeader& header = reader.getHeader();
+        if (header.versionMinor > VersionMinor)
+            report.warnings.push_back(std::format("written by a newer minor version ({}.{}); unknown fields are ignored", header.versionMajor, header.versionMinor));
+        if (header.headerSize != sizeof(FileHeader))
+            report.warnings.push_back(std::format("header size is {} bytes, expected {}", header.headerSize, sizeof(FileHeader)));
+
+        std::vector<SectionEntry> sections(reader.getSections().begin(), reader.getSections().end());
+        uint64_t tableEnd = header.sectionTableOffset + sections.size() * sizeof(SectionEntry);
+
+        std::sort(sections.begin(), sections.end(), [](const SectionEntry& a, const SectionEntry& b) { return a.offset < b.offset; });
+
+        uint64_t previousEnd = tableEnd;
+        for (size_t i = 0; i < sections.size(); ++i) {
+            const SectionEntry& section = sections[i];
+            string name = sectionName(section.type);
+
+            if (section.offset % SectionAlignment != 0)
+                report.errors.push_back(std::format("{} section at offset {} is not {}-byte aligned", name, section.offset, SectionAlignment));
+            if (section.offset < previousEnd)
+                report.errors.push_back(std::format("{} section overlaps the header, section table or another section", name));
+            previousEnd = std::max(previousEnd, section.offset + section.size);
+
+            for (size_t j = 0; j < i; ++j) {
+                if (sections[j].type == section.type)
+                    report.errors.push_back(std::format("duplicate {} section", name));
+            }
+
+            bool known = section.type == static_cast<uint32_t>(SectionType::Metadata)
+                || section.type == static_cast<uint32_t>(SectionType::Thumbnail)
+                || section.type == static_cast<uint32_t>(SectionType::AssetManifest);
+
+            if (!known) {
+                string sectionError;
+                if (!reader.sectionBytes(static_cast<SectionType>(section.type), sectionError))
+                    report.errors.push_back(sectionError);
+                report.warnings.push_back(std::format("unknown {} section ({} bytes) is ignored", name, section.size));
+            }
+        }
+
+        if (!reader.hasSection(SectionType::Metadata)) {
+            report.errors.push_back("no META section");
+        }
+        else {
+            if (reader.getSections().front().type != static_cast<uint32_t>(SectionType::Metadata))
+                report.warnings.push_back("META is not the first section; listing the project reads more of the file");
+
+            std::optional<ProjectMetadata> metadata = reader.readMetadata(error);
+            if (!metadata)
+                report.errors.push_back(error);
+            else if (metadata->name.empty())
+                report.warnings.push_back("project has no name");
+        }
+
+        if (reader.hasSection(SectionType::Thumbnail)) {
+            if (!reader.readThumbnail(error))
+                report.errors.push_back(error);
+        }
+
+        if (reader.hasSection(SectionType::AssetManifest)) {
+            if (!reader.readAssetManifest(error))
+                report.errors.push_back(error);
+        }
+
+        return report;
+    }
+
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "pch.h"
+
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include "Core/FileSystem/MappedFile.h"
+
+namespace ProjectManager {
+
+    // The .voltproj container. Little endian throughout:
+    //
+    //   FileHeader           64 bytes at offset 0
+    //   SectionEntry[]       right after the header
+    //   section payloads     each aligned to SectionAlignment
+    //
+    // The header and section table carry their own checksums and the metadata
+    // section is written first, so listing a project only touches the first page
+    // or two of the file. Every other section is found through the table and
+    // checked only when it is read. Readers accept any minor version of the same
+    // major version and skip section types they don't know.
+    namespace ProjectFormat {
+
+        inline constexpr char Magic[8] = { 'V', 'O', 'L', 'T', 'P', 'R', 'O', 'J' };
+        inline constexpr uint16_t VersionMajor = 1;
+        inline constexpr uint16_t VersionMinor = 0;
+        inline constexpr uint64_t SectionAlignment = 16;
+
+        constexpr uint32_t fourCC(char a, char b, char c, char d) {
+            return uint32_t(uint8_t(a)) | uint32_t(uint8_t(b)) << 8 | uint32_t(uint8_t(c)) << 16 | uint32_t(uint8_t(d)) << 24;
+        }
+
+        enum class SectionType : uint32_t {
+            Metadata = fourCC('M', 'E', 'T', 'A'),
+            Thumbnail = fourCC('T', 'H', 'M', 'B'),
+            AssetManifest = fourCC('A', 'S', 'E', 'T'),
+        };
+
+        struct FileHeader {
+            char magic[8];
+            uint16_t versionMajor;
+            uint16_t versionMinor;
+            uint32_t headerSize;
+            uint32_t sectionCount;
+            uint32_t flags;
+            uint64_t sectionTableOffset;
+            uint64_t fileSize;
+            uint32_t headerChecksum;        // over the header with this field zeroed
+            uint32_t sectionTableChecksum;
+            uint8_t reserved[16];
+        };
+
+        struct SectionEntry {
+            uint32_t type;
+            uint32_t flags;
+            uint64_t offset;
+            uint64_t size;
+            uint32_t checksum;              // over the payload
+            uint32_t reserved;
+        };
+
+        static_assert(sizeof(FileHeader) == 64);
+        static_assert(sizeof(SectionEntry) == 32);
+
+        // FNV-1a, the same checksum the project registry uses.
+        uint32_t checksum(std::span<const uint8_t> bytes, uint32_t hash = 2166136261u);
+
+        string sectionName(uint32_t type);
+
+    }
+
+    struct ProjectMetadata {
+        string name;
+        string description;
+        string templateName;
+        string engineVersion;
+        int64_t createdTime = 0;    // seconds since the Unix epoch
+        int64_t modifiedTime = 0;
+    };
+
+    // RGBA8 pixels pointing straight into the mapped file.
+    struct ProjectThumbnail {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::span<const uint8_t> pixels;
+    };
+
+    struct AssetEntry {
+        string path;        // relative to the project directory
+        uint64_t size = 0;
+        uint64_t hash = 0;
+    };
+
+    // Maps a .voltproj and reads sections on demand. open() only validates the
+    // header and section table; payloads are checked the first time they're read.
+    // Spans handed out stay valid until close() or destruction.
+    class ProjectFileReader {
+    public:
+        bool open(const std::filesystem::path& path, string& error);
+        void close();
+
+        bool isOpen() const { return file.isOpen(); }
+        const ProjectFormat::FileHeader& getHeader() const { return header; }
+        std::span<const ProjectFormat::SectionEntry> getSections() const { return sections; }
+
+        bool hasSection(ProjectFormat::SectionType type) const { return findSection(type) != nullptr; }
+
+        // Payload of a section after its checksum was verified; nullopt (and error
+        // filled) if it is missing or damaged.
+        std::optional<std::span<const uint8_t>> sectionBytes(ProjectFormat::SectionType type, string& error) const;
+
+        std::optional<ProjectMetadata> readMetadata(string& error) const;
+        std::optional<ProjectThumbnail> readThumbnail(string& error) const;
+        std::optional<std::vector<AssetEntry>> readAssetManifest(string& error) const;
+
+    private:
+        FileSystem::MappedFile file;
+        ProjectFormat::FileHeader header{};
+        std::vector<ProjectFormat::SectionEntry> sections;
+
+        const ProjectFormat::SectionEntry* findSection(ProjectFormat::SectionType type) const;
+    };
+
+    // Builds a .voltproj in memory and writes it atomically (see FileSystem::writeFileAtomically).
+    class ProjectFileWriter {
+    public:
+        void setMetadata(const ProjectMetadata& metadata);
+        void setThumbnail(uint32_t width, uint32_t height, std::span<const uint8_t> rgbaPixels);
+        void setAssetManifest(const std::vector<AssetEntry>& assets);
+        // Adds or replaces a section with an already encoded payload.
+        void setSection(uint32_t type, std::vector<uint8_t> payload);
+
+        std::vector<uint8_t> build() const;
+        bool write(const std::filesystem::path& path, string& error) const;
+
+    private:
+        // Kept in insertion order, except that metadata always goes first.
+        std::vector<std::pair<uint32_t, std::vector<uint8_t>>> payloads;
+    };
+
+    struct ValidationReport {
+        std::vector<string> errors;
+        std::vector<string> warnings;
+
+        bool ok() const { return errors.empty(); }
+    };
+
+    // Checks everything a reader relies on plus what it only checks lazily: every
+    // section's bounds, alignment, overlap and checksum, and that the known sections decode.
+    ValidationReport validateProjectFile(const std::filesystem::path& path);
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "pch.h"
+
+#include "Core/Managers/ProjectManager/ProjectFile.h"
+#include "Core/Managers/ProjectManager/ProjectRegistry.h"
+#include "Core/Profiler/Profiler.h"
+
+namespace ProjectManager {
+
+    // What the project list shows about a project beyond its name and path.
+    struct ProjectSummary {
+        std::optional<ProjectMetadata> metadata;
+        string error;
+    };
+
+    // View model behind the "Projects" screen. The registry already keeps each
+    // record's button label, so all this does is flatten the recently opened list
+    // into an indexable array when the registry changes, never per frame. Drawing it
+    // with ImGuiListClipper then costs the same for ten projects as for a hundred thousand.
+    //
+    // Summaries are read on first request only (the list asks for the hovered row):
+    // mapping a .voltproj and reading its header and metadata section is all it takes.
+    class ProjectListModel {
+    public:
+        void sync(const ProjectRegistry& registry) {
+            if (registry.getGeneration() == syncedGeneration)
+                return;
+
+            VOLT_PROFILE_SCOPE("ProjectListModel::sync");
+
+            syncedGeneration = registry.getGeneration();
+            summaries.clear();
+            entries.clear();
+            entries.reserve(registry.size());
+
+            for (const ProjectRecord& record : registry.getRecent())
+                entries.push_back(&record);
+        }
+
+        const std::vector<const ProjectRecord*>& getEntries() const { return entries; }
+        size_t size() const { return entries.size(); }
+
+        const ProjectSummary& getSummary(const ProjectRecord& record) {
+            auto [it, inserted] = summaries.try_emplace(record.projectFile);
+            if (!inserted)
+                return it->second;
+
+            VOLT_PROFILE_SCOPE("ProjectListModel::getSummary");
+
+            ProjectFileReader reader;
+            if (reader.open(record.projectFile, it->second.error))
+                it->second.metadata = reader.readMetadata(it->second.error);
+
+            return it->second;
+        }
+
+    private:
+        uint64_t syncedGeneration = UINT64_MAX;
+        std::vector<const ProjectRecord*> entries;
+        std::unordered_map<string, ProjectSummary> summaries;
+    };
+
+}
@@ -0,0 +1,357 @@
+#include "ProjectRegistry.h"
+
+#include "Core/FileSystem/MappedFile.h"
+#include "Core/Profiler/Profiler.h"
+#include "Core/Logging/HubLogger.h"
+
+namespace ProjectManager {
+
+    namespace {
+
+        uint32_t checksumRecord(uint32_t type, std::string_view name, std::string_view path) {
+            // FNV-1a over the record type and payload; enough to spot a torn append.
+            uint32_t hash = 2166136261u;
+            auto mix = [&](const void* data, size_t size) {
+                const uint8_t* bytes = static_cast<const uint8_t*>(data);
+                for (size_t i = 0; i < size; ++i) {
+                    hash ^= bytes[i];
+                    hash *= 16777619u;
+                }
+            };
+
+            mix(&type, sizeof(type));
+            mix(name.data(), name.size());
+            mix(path.data(), path.size());
+            return hash;
+        }
+
+        size_t paddedSize(size_t size) {
+            return (size + 7) & ~size_t(7);
+        }
+
+        string formatLabel(const string& name, const string& projectFile) {
+            // Same text the hub has always shown: the quoted path as stored in JSON.
+            return std::format("{}: {}", name, json(projectFile).dump());
+        }
+
+    }
+
+    ProjectRegistry::~ProjectRegistry() {
+        close();
+    }
+
+    bool ProjectRegistry::open(const std::filesystem::path& path) {
+        VOLT_PROFILE_SCOPE("ProjectRegistry::open");
+
+        close();
+        filePath = path;
+
+        std::error_code ec;
+        size_t validLength = 0;
+        bool tailDamaged = false;
+
+        if (std::filesystem::exists(filePath, ec)) {
+            FileSystem::MappedFile file;
+            if (!file.open(filePath)) {
+                cf_Sink::logger->error(std::format("Could not map project registry: {}", filePath.string()));
+                return false;
+            }
+
+            if (!replay(file.bytes(), validLength)) {
+                cf_Sink::logger->error(std::format("{} is not a VoltLine project registry.", filePath.string()));
+                return false;
+            }
+
+            tailDamaged = validLength != file.size();
+        }
+
+        if (validLength < sizeof(FileHeader)) {
+            if (!rewrite())
+                return false;
+        }
+        else if (tailDamaged) {
+            cf_Sink::logger->warn(std::format("Project registry {} has a damaged tail; dropping {} bytes.", filePath.string(), std::filesystem::file_size(filePath, ec) - validLength));
+            std::filesystem::resize_file(filePath, validLength, ec);
+        }
+
+        appendStream.open(filePath, std::ios::out | std::ios::binary | std::ios::app);
+        if (!appendStream.is_open()) {
+            cf_Sink::logger->error(std::format("Could not open project registry for writing: {}", filePath.string()));
+            return false;
+        }
+
+        ++generation;
+        return true;
+    }
+
+    void ProjectRegistry::close() {
+        if (appendStream.is_open())
+            appendStream.close();
+
+        recent.clear();
+        byName.clear();
+        byPath.clear();
+        logRecords = 0;
+    }
+
+    bool ProjectRegistry::add(const string& name, const string& projectFile) {
+        auto existingPath = byPath.find(projectFile);
+        if (existingPath != byPath.end() && existingPath->second->name != name)
+            return false;
+
+        if (!applyAdd(name, projectFile))
+            return false;
+
+        return append(RecordType::Add, name, projectFile);
+    }
+
+    bool ProjectRegistry::remove(const string& name) {
+        if (!applyRemove(name))
+            return false;
+
+        return append(RecordType::Remove, name, {});
+    }
+
+    bool ProjectRegistry::touch(const string& name) {
+        if (!applyTouch(name))
+            return false;
+
+        return append(RecordType::Touch, name, {});
+    }
+
+    const ProjectRecord* ProjectRegistry::findByName(const string& name) const {
+        auto it = byName.find(name);
+        return it != byName.end() ? &*it->second : nullptr;
+    }
+
+    const ProjectRecord* ProjectRegistry::findByPath(const string& projectFile) const {
+        auto it = byPath.find(projectFile);
+        return it != byPath.end() ? &*it->second : nullptr;
+    }
+
+    void ProjectRegistry::importJson(const json& document) {
+        VOLT_PROFILE_SCOPE("ProjectRegistry::importJson");
+
+        if (!document.is_object() || !document.contains("projects") || !document["projects"].is_object())
+            return;
+
+        const json& projects = document["projects"];
+
+        for (const string& name : fileNames) {
+            if (!projects.contains(name))
+                remove(name);
+        }
+
+        fileNames.clear();
+
+        for (const auto& [name, value] : projects.items()) {
+            fileNames.insert(name);
+            if (!value.is_object() || !value.contains("project_file") || !value["project_file"].is_string())
+                continue;
+
+            string projectFile = value["project_file"].get<string>();
+            const ProjectRecord* existing = findByName(name);
+            if (existing && existing->projectFile == projectFile)
+                continue;
+
+            if (!add(name, projectFile))
+                cf_Sink::logger->warn(std::format("Skipping project \"{}\": {} is already registered.", name, projectFile));
+        }
+    }
+
+    json ProjectRegistry::exportJson() {
+        json document;
+        document["projects"] = json::object();
+
+        fileNames.clear();
+        for (const ProjectRecord& record : recent) {
+            document["projects"][record.name] = { {"project_file", record.projectFile} };
+            fileNames.insert(record.name);
+        }
+
+        return document;
+    }
+
+    bool ProjectRegistry::applyAdd(const string& name, const string& projectFile) {
+        auto existing = byName.find(name);
+        if (existing != byName.end()) {
+            std::list<ProjectRecord>::iterator node = existing->second;
+            if (node->projectFile != projectFile) {
+                byPath.erase(node->projectFile);
+                node->projectFile = projectFile;
+                node->label = formatLabel(name, projectFile);
+                node->validType = std::string_view(projectFile).ends_with(".voltproj");
+                byPath[projectFile] = node;
+            }
+
+            recent.splice(recent.begin(), recent, node);
+            ++generation;
+            return true;
+        }
+
+        recent.push_front({ name, projectFile, formatLabel(name, projectFile), std::string_view(projectFile).ends_with(".voltproj") });
+        byName.emplace(name, recent.begin());
+        byPath[projectFile] = recent.begin();
+        ++generation;
+        return true;
+    }
+
+    bool ProjectRegistry::applyRemove(const string& name) {
+        auto existing = byName.find(name);
+        if (existing == byName.end())
+            return false;
+
+        std::list<ProjectRecord>::iterator node = existing->second;
+        byPath.erase(node->projectFile);
+        byName.erase(existing);
+        recent.erase(node);
+        ++generation;
+        return true;
+    }
+
+    bool ProjectRegistry::applyTouch(const string& name) {
+        auto existing = byName.find(name);
+        if (existing == byName.end())
+            return false;
+
+        recent.splice(recent.begin(), recent, existing->second);
+        ++generation;
+        return true;
+    }
+
+    bool ProjectRegistry::replay(std::span<const uint8_t> bytes, size_t& validLength) {
+        validLength = 0;
+
+        // Too short to even hold the header: a fresh or never-finished file.
+        if (bytes.size() < sizeof(FileHeader))
+            return true;
+
+        FileHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version)
+            return false;
+
+        size_t offset = sizeof(FileHeader);
+        validLength = offset;
+
+        while (offset + sizeof(RecordHeader) <= bytes.size()) {
+            RecordHeader record;
+            std::memcpy(&record, bytes.data() + offset, sizeof(record));
+
+            size_t payload = paddedSize(size_t(record.nameSize) + record.pathSize);
+            if (payload > bytes.size() - offset - sizeof(RecordHeader))
+                break;
+
+            const char* text = reinterpret_cast<const char*>(bytes.data() + offset + sizeof(RecordHeader));
+            std::string_view name(text, record.nameSize);
+            std::string_view path(text + record.nameSize, record.pathSize);
+
+            if (checksumRecord(record.type, name, path) != record.checksum)
+                break;
+
+            switch (static_cast<RecordType>(record.type)) {
+            case RecordType::Add:
+                applyAdd(string(name), string(path));
+                break;
+            case RecordType::Remove:
+                applyRemove(string(name));
+                break;
+            case RecordType::Touch:
+                applyTouch(string(name));
+                break;
+            default:
+                // Unknown record type: treat like corruption and stop here.
+                return true;
+            }
+
+            offset += sizeof(RecordHeader) + payload;
+            validLength = offset;
+            ++logRecords;
+        }
+
+        return true;
+    }
+
+    bool ProjectRegistry::append(RecordType type, const string& name, const string& projectFile) {
+        if (!appendStream.is_open())
+            return false;
+
+        writeRecord(appendStream, type, name, projectFile);
+        appendStream.flush();
+        ++logRecords;
+
+        if (!appendStream) {
+            cf_Sink::logger->error(std::format("Failed to append to project registry: {}", filePath.string()));
+            return false;
+        }
+
+        return compactIfNeeded();
+    }
+
+    void ProjectRegistry::writeRecord(std::ostream& stream, RecordType type, const string& name, const string& projectFile) {
+        RecordHeader record{};
+        record.type = static_cast<uint32_t>(type);
+        record.nameSize = static_cast<uint32_t>(name.size());
+        record.pathSize = static_cast<uint32_t>(projectFile.size());
+        record.checksum = checksumRecord(record.type, name, projectFile);
+
+        static constexpr char zeros[8] = {};
+        size_t payload = name.size() + projectFile.size();
+
+        stream.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        stream.write(name.data(), name.size());
+        stream.write(projectFile.data(), projectFile.size());
+        stream.write(zeros, paddedSize(payload) - payload);
+    }
+
+    bool ProjectRegistry::compactIfNeeded() {
+        if (logRecords < CompactionMinimum || logRecords < recent.size() * CompactionRatio)
+            return true;
+
+        appendStream.close();
+        bool rewritten = rewrite();
+
+        appendStream.open(filePath, std::ios::out | std::ios::binary | std::ios::app);
+        return rewritten && appendStream.is_open();
+    }
+
+    bool ProjectRegistry::rewrite() {
+        VOLT_PROFILE_SCOPE("ProjectRegistry::rewrite");
+
+        std::filesystem::path tempPath = filePath;
+        tempPath += ".tmp";
+
+        {
+            std::ofstream out(tempPath, std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!out.is_open()) {
+                cf_Sink::logger->error(std::format("Could not write project registry: {}", tempPath.string()));
+                return false;
+            }
+
+            FileHeader header{};
+            std::memcpy(header.magic, Magic, sizeof(Magic));
+            header.version = Version;
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+            // Oldest first, so replaying the adds rebuilds the same recent order.
+            for (auto it = recent.rbegin(); it != recent.rend(); ++it)
+                writeRecord(out, RecordType::Add, it->name, it->projectFile);
+
+            if (!out) {
+                cf_Sink::logger->error(std::format("Could not write project registry: {}", tempPath.string()));
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tempPath, filePath, ec);
+        if (ec) {
+            cf_Sink::logger->error(std::format("Could not replace project registry {}: {}", filePath.string(), ec.message()));
+            return false;
+        }
+
+        logRecords = recent.size();
+        return true;
+    }
+
+}
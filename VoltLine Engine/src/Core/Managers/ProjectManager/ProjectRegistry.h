@@ -0,0 +1,130 @@
+#pragma once
+
+#include "pch.h"
+
+#include <cstdint>
+#include <list>
+#include <span>
+#include <unordered_set>
+
+#include "nlohmann/json.hpp"
+
+namespace ProjectManager {
+
+    using json = nlohmann::json;
+
+    struct ProjectRecord {
+        string name;
+        string projectFile;
+        string label;       // "name: \"path\"", formatted once when the record is added
+        bool validType;     // ends with .voltproj
+    };
+
+    // Registry of every project known to the hub, persisted as an append-only log
+    // (projects.vlreg). Opening maps the log and replays it; after that every change
+    // is a single record appended to the end of the file, so registering, removing
+    // or opening a project costs the same with ten entries as with a hundred thousand.
+    //
+    // Records live in a most-recently-opened list indexed by name and by path;
+    // pointers to records stay valid until that record is removed.
+    //
+    // projects.json is still understood: it seeds a new registry and can be
+    // imported/exported for anyone editing it by hand.
+    class ProjectRegistry {
+    public:
+        ProjectRegistry() = default;
+        ~ProjectRegistry();
+
+        ProjectRegistry(const ProjectRegistry&) = delete;
+        ProjectRegistry& operator=(const ProjectRegistry&) = delete;
+
+        // Loads (or creates) the registry file. A torn record at the end of the log,
+        // e.g. from a crash mid-append, is dropped and the file truncated to the last
+        // good record.
+        bool open(const std::filesystem::path& path);
+        void close();
+
+        bool isOpen() const { return appendStream.is_open(); }
+        const std::filesystem::path& getPath() const { return filePath; }
+
+        // Adds a project, or points an existing name at a new file. Fails if the file
+        // is already registered under a different name.
+        bool add(const string& name, const string& projectFile);
+        bool remove(const string& name);
+        // Moves a project to the front of the recently opened list.
+        bool touch(const string& name);
+
+        const ProjectRecord* findByName(const string& name) const;
+        const ProjectRecord* findByPath(const string& projectFile) const;
+
+        // Most recently opened (or added) first.
+        const std::list<ProjectRecord>& getRecent() const { return recent; }
+        size_t size() const { return recent.size(); }
+
+        // Bumped on every change, like SettingsStore::getGeneration.
+        uint64_t getGeneration() const { return generation; }
+
+        // Merges a projects.json document into the registry: new names are added and
+        // changed paths updated. A name is only removed if the file had it the last
+        // time it was exported or imported and the user has since deleted it; projects
+        // created or discovered after that are not in the file, and must survive it.
+        void importJson(const json& document);
+        json exportJson();
+
+    private:
+        enum class RecordType : uint32_t {
+            Add = 1,
+            Remove = 2,
+            Touch = 3,
+        };
+
+        // On-disk layout, little endian:
+        //   FileHeader, then RecordHeader + name + path (padded to 8 bytes) repeated.
+        struct FileHeader {
+            char magic[4];
+            uint32_t version;
+            uint64_t reserved;
+        };
+
+        struct RecordHeader {
+            uint32_t type;
+            uint32_t nameSize;
+            uint32_t pathSize;
+            uint32_t checksum;
+        };
+
+        static constexpr char Magic[4] = { 'V', 'L', 'P', 'R' };
+        static constexpr uint32_t Version = 1;
+
+        // The log is rewritten once dead records (removals, renames, touches)
+        // outnumber live ones by this factor, keeping replay time proportional to
+        // the number of projects.
+        static constexpr size_t CompactionRatio = 4;
+        static constexpr size_t CompactionMinimum = 1024;
+
+        std::filesystem::path filePath;
+        std::ofstream appendStream;
+
+        std::list<ProjectRecord> recent;
+        std::unordered_map<string, std::list<ProjectRecord>::iterator> byName;
+        std::unordered_map<string, std::list<ProjectRecord>::iterator> byPath;
+
+        uint64_t generation = 0;
+        size_t logRecords = 0;
+
+        // Names projects.json held as of the last exportJson() or importJson().
+        std::unordered_set<string> fileNames;
+
+        // In-memory operations shared by replay and the public API.
+        bool applyAdd(const string& name, const string& projectFile);
+        bool applyRemove(const string& name);
+        bool applyTouch(const string& name);
+
+        bool replay(std::span<const uint8_t> bytes, size_t& validLength);
+        bool append(RecordType type, const string& name, const string& projectFile);
+        static void writeRecord(std::ostream& stream, RecordType type, const string& name, const string& projectFile);
+        bool compactIfNeeded();
+        bool rewrite();
+    };
+
+}
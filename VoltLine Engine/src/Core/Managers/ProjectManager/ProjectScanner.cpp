@@ -0,0 +1,514 @@
+#include "ProjectScanner.h"
+
+#include "Core/FileSystem/AtomicFile.h"
+#include "Core/FileSystem/MappedFile.h"
+#include "Core/Profiler/Profiler.h"
+#include "Core/Logging/HubLogger.h"
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#elif defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#endif
+
+namespace ProjectManager {
+
+    namespace {
+
+        void appendValue(string& out, const void* data, size_t size) {
+            out.append(static_cast<const char*>(data), size);
+        }
+
+        void appendString(string& out, std::string_view text) {
+            uint32_t size = static_cast<uint32_t>(text.size());
+            appendValue(out, &size, sizeof(size));
+            out.append(text);
+        }
+
+        // Bounds-checked reads over the mapped cache file.
+        struct CacheReader {
+            std::span<const uint8_t> bytes;
+            size_t offset = 0;
+
+            template<typename T>
+            bool read(T& value) {
+                if (bytes.size() - offset < sizeof(T))
+                    return false;
+                std::memcpy(&value, bytes.data() + offset, sizeof(T));
+                offset += sizeof(T);
+                return true;
+            }
+
+            bool readString(string& text) {
+                uint32_t size = 0;
+                if (!read(size) || bytes.size() - offset < size)
+                    return false;
+                text.assign(reinterpret_cast<const char*>(bytes.data() + offset), size);
+                offset += size;
+                return true;
+            }
+
+            bool readStrings(std::vector<string>& texts) {
+                uint32_t count = 0;
+                if (!read(count) || count > bytes.size() - offset)
+                    return false;
+                texts.resize(count);
+                for (string& text : texts) {
+                    if (!readString(text))
+                        return false;
+                }
+                return true;
+            }
+        };
+
+    }
+
+    ProjectScanner::~ProjectScanner() {
+        shutdown();
+    }
+
+    void ProjectScanner::open(const std::filesystem::path& path) {
+        VOLT_PROFILE_SCOPE("ProjectScanner::open");
+
+        cachePath = path;
+        cancelled.store(false);
+
+        if (readCache()) {
+            projects = collectProjects();
+            ++generation;
+        }
+    }
+
+    void ProjectScanner::shutdown() {
+        cancelled.store(true);
+        EngineManager::jobSystem().wait(scanJob);
+        stopWatching();
+    }
+
+    void ProjectScanner::setRoots(std::vector<std::filesystem::path> newRoots) {
+        // A crawl of the old roots is useless now; stop it before touching the watches.
+        cancelled.store(true);
+        EngineManager::jobSystem().wait(scanJob);
+        cancelled.store(false);
+        {
+            std::lock_guard<std::mutex> lock(resultMutex);
+            finishedScan.reset();
+        }
+
+        stopWatching();
+        roots = std::move(newRoots);
+        startWatching();
+
+        changedDirectories.clear();
+        fullScanRequested = true;
+    }
+
+    bool ProjectScanner::poll() {
+        bool changed = false;
+
+        std::optional<ScanResult> result;
+        {
+            std::lock_guard<std::mutex> lock(resultMutex);
+            result.swap(finishedScan);
+        }
+
+        if (result) {
+            cf_Sink::logger->info(std::format("Project scan: {} directories read, {} unchanged, {} projects found in {:.1f} ms",
+                result->directoriesRead, result->directoriesReused, result->projects.size(), result->milliseconds));
+
+            if (result->projects != projects) {
+                projects = std::move(result->projects);
+                ++generation;
+                changed = true;
+            }
+        }
+
+        readChangeNotifications();
+
+        if (isScanning() || roots.empty())
+            return changed;
+
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (now - lastChange < SettleDelay)
+            return changed;
+
+        if (!hasChangeNotifications() && now - lastScan >= RescanInterval)
+            fullScanRequested = true;
+
+        if (fullScanRequested) {
+            std::vector<string> directories;
+            for (const std::filesystem::path& root : roots)
+                directories.push_back(root.generic_string());
+
+            fullScanRequested = false;
+            changedDirectories.clear();
+            startScan(true, std::move(directories));
+        }
+        else if (!changedDirectories.empty()) {
+            std::vector<string> directories(changedDirectories.begin(), changedDirectories.end());
+            changedDirectories.clear();
+            startScan(false, std::move(directories));
+        }
+
+        return changed;
+    }
+
+    void ProjectScanner::startScan(bool full, std::vector<string> directories) {
+        lastScan = std::chrono::steady_clock::now();
+
+        EngineManager::jobSystem().run([this, full, directories = std::move(directories)]() mutable {
+            Crawl crawl;
+            crawl.full = full;
+            runScan(crawl, std::move(directories));
+        }, &scanJob);
+    }
+
+    void ProjectScanner::runScan(Crawl& crawl, std::vector<string> directories) {
+        VOLT_PROFILE_SCOPE("ProjectScanner::scan");
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        EngineManager::JobSystem& jobs = EngineManager::jobSystem();
+
+        // Roots are checked against the cache like everything else; directories
+        // reported as changed are always re-read, whatever their mtime says.
+        for (string& directory : directories) {
+            jobs.run([this, &crawl, directory = std::move(directory)]() {
+                crawlDirectory(crawl, directory, !crawl.full);
+            }, &crawl.jobs);
+        }
+        jobs.wait(crawl.jobs);
+
+        if (cancelled.load())
+            return;
+
+        mergeCrawl(crawl);
+
+        ScanResult result;
+        result.projects = collectProjects();
+        result.directoriesRead = crawl.directoriesRead.load();
+        result.directoriesReused = crawl.directoriesReused.load();
+        result.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        if (result.directoriesRead > 0 || !crawl.vanished.empty())
+            writeCache();
+
+        {
+            std::lock_guard<std::mutex> lock(resultMutex);
+            finishedScan = std::move(result);
+        }
+
+        if (onScanFinished)
+            onScanFinished();
+    }
+
+    void ProjectScanner::crawlDirectory(Crawl& crawl, const string& directory, bool forceRead) {
+        if (cancelled.load(std::memory_order_relaxed))
+            return;
+
+        std::error_code ec;
+        std::filesystem::path path(directory);
+
+        // Stat before reading: a change made while we read shows up as a newer mtime next time.
+        std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(path, ec);
+        if (ec || !std::filesystem::is_directory(path, ec)) {
+            std::lock_guard<std::mutex> lock(crawl.mutex);
+            crawl.vanished.push_back(directory);
+            return;
+        }
+
+        // Nothing writes the cache until every job of the crawl is done.
+        auto cached = cache.find(directory);
+        bool known = cached != cache.end();
+
+        DirectoryEntry entry;
+        int64_t stamp = writeTime.time_since_epoch().count();
+
+        if (known && !forceRead && cached->second.writeTime == stamp) {
+            entry = cached->second;
+            crawl.directoriesReused.fetch_add(1, std::memory_order_relaxed);
+        }
+        else {
+            for (std::filesystem::directory_iterator it(path, std::filesystem::directory_options::skip_permission_denied, ec), end; !ec && it != end; it.increment(ec)) {
+                const std::filesystem::directory_entry& item = *it;
+                string name = item.path().filename().string();
+
+                // Its own error code, so a failure on one entry doesn't end the listing.
+                std::error_code entryEc;
+
+                // Links are never followed: a link back up the tree would crawl forever.
+                if (item.is_symlink(entryEc) || entryEc)
+                    continue;
+
+                if (item.is_directory(entryEc)) {
+                    if (!name.starts_with('.'))
+                        entry.subdirectories.push_back(std::move(name));
+                }
+                else if (item.path().extension() == ".voltproj") {
+                    entry.projectFiles.push_back(std::move(name));
+                }
+            }
+
+            crawl.directoriesRead.fetch_add(1, std::memory_order_relaxed);
+
+            if (ec) {
+                // The listing is partial: use what was read, but leave writeTime at 0 so the
+                // next crawl reads the directory again, and don't take missing
+                // subdirectories for deleted ones.
+                cf_Sink::logger->warn(std::format("Could not finish reading {}: {}", directory, ec.message()));
+            }
+            else {
+                entry.writeTime = stamp;
+
+                if (known) {
+                    std::lock_guard<std::mutex> lock(crawl.mutex);
+                    for (const string& previous : cached->second.subdirectories) {
+                        if (std::find(entry.subdirectories.begin(), entry.subdirectories.end(), previous) == entry.subdirectories.end())
+                            crawl.vanished.push_back(directory + '/' + previous);
+                    }
+                }
+            }
+        }
+
+        watchDirectory(directory);
+
+        // A full crawl visits everything; a changed-directory crawl only descends into
+        // directories it hasn't seen, the others report their own changes.
+        EngineManager::JobSystem& jobs = EngineManager::jobSystem();
+        for (const string& name : entry.subdirectories) {
+            string child = directory + '/' + name;
+            if (!crawl.full && cache.contains(child))
+                continue;
+
+            jobs.run([this, &crawl, child = std::move(child)]() { crawlDirectory(crawl, child, false); }, &crawl.jobs);
+        }
+
+        std::lock_guard<std::mutex> lock(crawl.mutex);
+        crawl.visited.emplace_back(directory, std::move(entry));
+    }
+
+    void ProjectScanner::mergeCrawl(Crawl& crawl) {
+        // A full crawl saw every directory that still exists under the roots; anything
+        // else in the cache (old roots, deleted folders) goes.
+        if (crawl.full) {
+            DirectoryCache fresh;
+            for (auto& [directory, entry] : crawl.visited)
+                fresh.insert_or_assign(std::move(directory), std::move(entry));
+            cache.swap(fresh);
+            return;
+        }
+
+        for (const string& directory : crawl.vanished) {
+            cache.erase(directory);
+
+            string prefix = directory + '/';
+            for (auto it = cache.lower_bound(prefix); it != cache.end() && it->first.starts_with(prefix);)
+                it = cache.erase(it);
+        }
+
+        for (auto& [directory, entry] : crawl.visited)
+            cache.insert_or_assign(std::move(directory), std::move(entry));
+    }
+
+    std::vector<DiscoveredProject> ProjectScanner::collectProjects() const {
+        std::vector<DiscoveredProject> found;
+
+        for (const auto& [directory, entry] : cache) {
+            for (const string& projectFile : entry.projectFiles) {
+                std::filesystem::path filePath = std::filesystem::path(directory) / projectFile;
+                found.push_back({ filePath.stem().string(), filePath.make_preferred().string() });
+            }
+        }
+
+        return found;
+    }
+
+    // Cache layout, little endian:
+    //   "VLSC", uint32 version, uint64 directory count, then per directory:
+    //   path, int64 mtime, sub-directory names, project file names.
+    //   Strings are uint32 length + bytes, lists are uint32 count + strings.
+    bool ProjectScanner::readCache() {
+        std::error_code ec;
+        if (cachePath.empty() || !std::filesystem::exists(cachePath, ec))
+            return false;
+
+        FileSystem::MappedFile file;
+        if (!file.open(cachePath))
+            return false;
+
+        CacheReader reader{ file.bytes() };
+
+        char magic[4] = {};
+        uint32_t version = 0;
+        uint64_t count = 0;
+        if (!reader.read(magic) || std::memcmp(magic, CacheMagic, sizeof(magic)) != 0 || !reader.read(version) || version != CacheVersion || !reader.read(count)) {
+            cf_Sink::logger->warn(std::format("Ignoring unreadable project scan cache: {}", cachePath.string()));
+            return false;
+        }
+
+        DirectoryCache loaded;
+        for (uint64_t i = 0; i < count; ++i) {
+            string directory;
+            DirectoryEntry entry;
+            if (!reader.readString(directory) || !reader.read(entry.writeTime) || !reader.readStrings(entry.subdirectories) || !reader.readStrings(entry.projectFiles)) {
+                cf_Sink::logger->warn(std::format("Ignoring damaged project scan cache: {}", cachePath.string()));
+                return false;
+            }
+
+            loaded.emplace_hint(loaded.end(), std::move(directory), std::move(entry));
+        }
+
+        cache.swap(loaded);
+        return true;
+    }
+
+    void ProjectScanner::writeCache() const {
+        if (cachePath.empty())
+            return;
+
+        string out;
+        appendValue(out, CacheMagic, sizeof(CacheMagic));
+        appendValue(out, &CacheVersion, sizeof(CacheVersion));
+        uint64_t count = cache.size();
+        appendValue(out, &count, sizeof(count));
+
+        for (const auto& [directory, entry] : cache) {
+            appendString(out, directory);
+            appendValue(out, &entry.writeTime, sizeof(entry.writeTime));
+
+            for (const std::vector<string>* names : { &entry.subdirectories, &entry.projectFiles }) {
+                uint32_t nameCount = static_cast<uint32_t>(names->size());
+                appendValue(out, &nameCount, sizeof(nameCount));
+                for (const string& name : *names)
+                    appendString(out, name);
+            }
+        }
+
+        string error;
+        if (!FileSystem::writeFileAtomically(cachePath, out, error))
+            cf_Sink::logger->warn(std::format("Could not write project scan cache {}: {}", cachePath.string(), error));
+    }
+
+    void ProjectScanner::startWatching() {
+        watchesExhausted.store(false);
+
+#ifdef __linux__
+        // Watches are added per directory as the crawl visits them.
+        inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (inotifyFd < 0)
+            cf_Sink::logger->warn(std::format("inotify unavailable; project roots will be rescanned every {}s", RescanInterval.count()));
+#elif defined(_WIN32)
+        for (const std::filesystem::path& root : roots) {
+            HANDLE handle = FindFirstChangeNotificationW(root.c_str(), TRUE, FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME);
+            if (handle != INVALID_HANDLE_VALUE)
+                changeHandles.push_back(handle);
+        }
+#endif
+    }
+
+    void ProjectScanner::stopWatching() {
+        std::lock_guard<std::mutex> lock(watchMutex);
+
+#ifdef __linux__
+        if (inotifyFd >= 0)
+            close(inotifyFd);
+        inotifyFd = -1;
+        watchedByDescriptor.clear();
+        watchedPaths.clear();
+#elif defined(_WIN32)
+        for (void* handle : changeHandles)
+            FindCloseChangeNotification(handle);
+        changeHandles.clear();
+#endif
+    }
+
+    void ProjectScanner::watchDirectory(const string& directory) {
+#ifdef __linux__
+        if (watchesExhausted.load(std::memory_order_relaxed))
+            return;
+
+        std::lock_guard<std::mutex> lock(watchMutex);
+        if (inotifyFd < 0 || watchedPaths.contains(directory))
+            return;
+
+        int descriptor = inotify_add_watch(inotifyFd, directory.c_str(), IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR);
+        if (descriptor < 0) {
+            if (errno == ENOSPC && !watchesExhausted.exchange(true)) {
+                cf_Sink::logger->warn(std::format("Ran out of inotify watches after {} directories; project roots will be rescanned every {}s instead "
+                    "(raise fs.inotify.max_user_watches to watch them all)", watchedPaths.size(), RescanInterval.count()));
+            }
+            return;
+        }
+
+        watchedByDescriptor[descriptor] = directory;
+        watchedPaths.insert(directory);
+#else
+        (void)directory;
+#endif
+    }
+
+    bool ProjectScanner::hasChangeNotifications() const {
+#ifdef __linux__
+        return inotifyFd >= 0 && !watchesExhausted.load();
+#elif defined(_WIN32)
+        return !changeHandles.empty();
+#else
+        return false;
+#endif
+    }
+
+    void ProjectScanner::readChangeNotifications() {
+#ifdef __linux__
+        if (inotifyFd < 0)
+            return;
+
+        alignas(inotify_event) char buffer[4096];
+        ssize_t length;
+        while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0) {
+            std::lock_guard<std::mutex> lock(watchMutex);
+
+            for (char* ptr = buffer; ptr < buffer + length;) {
+                auto* event = reinterpret_cast<inotify_event*>(ptr);
+                ptr += sizeof(inotify_event) + event->len;
+
+                if (event->mask & IN_Q_OVERFLOW) {
+                    fullScanRequested = true;
+                    lastChange = std::chrono::steady_clock::now();
+                    continue;
+                }
+
+                auto watched = watchedByDescriptor.find(event->wd);
+                if (watched == watchedByDescriptor.end())
+                    continue;
+
+                if (event->mask & IN_IGNORED) {
+                    watchedPaths.erase(watched->second);
+                    watchedByDescriptor.erase(watched);
+                    continue;
+                }
+
+                // Build output and the like churn constantly; only folders and project files matter.
+                bool relevant = (event->mask & IN_ISDIR) || (event->len > 0 && std::string_view(event->name).ends_with(".voltproj"));
+                if (relevant) {
+                    changedDirectories.insert(watched->second);
+                    lastChange = std::chrono::steady_clock::now();
+                }
+            }
+        }
+#elif defined(_WIN32)
+        for (void* handle : changeHandles) {
+            if (WaitForSingleObject(handle, 0) == WAIT_OBJECT_0) {
+                // These don't say what changed; the mtime cache keeps the rescan cheap.
+                fullScanRequested = true;
+                lastChange = std::chrono::steady_clock::now();
+                FindNextChangeNotification(handle);
+            }
+        }
+#endif
+    }
+
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "pch.h"
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <unordered_set>
+
+#include "Core/Managers/EngineManager/EngineManager.h"
+
+namespace ProjectManager {
+
+    struct DiscoveredProject {
+        string name;        // file name without .voltproj
+        string projectFile;
+
+        bool operator==(const DiscoveredProject&) const = default;
+    };
+
+    // Finds .voltproj files under the configured project roots without touching the
+    // UI thread. Crawls run as jobs on the engine's job system, one job per
+    // directory, so a drive with tens of thousands of folders is read in parallel.
+    //
+    // Every directory seen is cached with its modification time, sub-directories and
+    // project files (and persisted, so the next hub start is incremental too). A
+    // rescan only re-reads directories whose mtime changed. After the first crawl,
+    // changes come from inotify on Linux and change notifications on Windows;
+    // elsewhere, or once the inotify watch limit is hit, it falls back to a periodic
+    // mtime-only rescan.
+    //
+    // Everything except the crawl itself happens on the main thread through poll().
+    class ProjectScanner {
+    public:
+        ProjectScanner() = default;
+        ~ProjectScanner();
+
+        ProjectScanner(const ProjectScanner&) = delete;
+        ProjectScanner& operator=(const ProjectScanner&) = delete;
+
+        // Loads the cache from a previous run and publishes what it found, so the
+        // project list is filled before the first crawl finishes.
+        void open(const std::filesystem::path& cachePath);
+        // Waits for a running crawl and stops watching. Safe to call twice.
+        void shutdown();
+
+        // Replaces the directories to crawl and starts a full (incremental) scan.
+        void setRoots(std::vector<std::filesystem::path> roots);
+        const std::vector<std::filesystem::path>& getRoots() const { return roots; }
+
+        // Main thread, once per frame: picks up change notifications, starts a crawl
+        // when something changed and publishes finished ones. Returns true when the
+        // project list changed.
+        bool poll();
+        // Queues a full scan on the next poll().
+        void rescan() { fullScanRequested = true; }
+
+        bool isScanning() const { return !scanJob.done(); }
+
+        // Called from a worker thread when a crawl finishes, e.g. to wake an idle main loop.
+        void setScanFinishedCallback(std::function<void()> callback) { onScanFinished = std::move(callback); }
+
+        const std::vector<DiscoveredProject>& getProjects() const { return projects; }
+        // Bumped whenever getProjects() changes.
+        uint64_t getGeneration() const { return generation; }
+
+    private:
+        struct DirectoryEntry {
+            int64_t writeTime = 0;
+            std::vector<string> subdirectories;
+            std::vector<string> projectFiles;
+        };
+
+        // Keyed by generic path string, so a directory's subtree is one contiguous range.
+        using DirectoryCache = std::map<string, DirectoryEntry>;
+
+        // State shared by the jobs of one crawl.
+        struct Crawl {
+            bool full = false;
+            EngineManager::JobCounter jobs;
+            std::mutex mutex;
+            std::vector<std::pair<string, DirectoryEntry>> visited;
+            std::vector<string> vanished;
+            std::atomic<size_t> directoriesRead{ 0 };
+            std::atomic<size_t> directoriesReused{ 0 };
+        };
+
+        struct ScanResult {
+            std::vector<DiscoveredProject> projects;
+            size_t directoriesRead = 0;
+            size_t directoriesReused = 0;
+            double milliseconds = 0.0;
+        };
+
+        static constexpr uint32_t CacheVersion = 1;
+        static constexpr char CacheMagic[4] = { 'V', 'L', 'S', 'C' };
+
+        // Events usually come in bursts (a checkout, an unzip); wait for them to settle.
+        static constexpr std::chrono::milliseconds SettleDelay{ 200 };
+        // Used when change notifications aren't available.
+        static constexpr std::chrono::seconds RescanInterval{ 30 };
+
+        std::filesystem::path cachePath;
+        std::vector<std::filesystem::path> roots;
+
+        // Main thread only.
+        std::vector<DiscoveredProject> projects;
+        uint64_t generation = 0;
+        bool fullScanRequested = false;
+        std::unordered_set<string> changedDirectories;
+        std::chrono::steady_clock::time_point lastChange{};
+        std::chrono::steady_clock::time_point lastScan{};
+
+        // Owned by the running crawl while there is one, by the main thread otherwise.
+        DirectoryCache cache;
+
+        EngineManager::JobCounter scanJob;
+        std::atomic<bool> cancelled{ false };
+        std::mutex resultMutex;
+        std::optional<ScanResult> finishedScan;
+        std::function<void()> onScanFinished;
+
+        std::mutex watchMutex;
+        std::atomic<bool> watchesExhausted{ false };
+#ifdef __linux__
+        int inotifyFd = -1;
+        std::unordered_map<int, string> watchedByDescriptor;
+        std::unordered_set<string> watchedPaths;
+#elif defined(_WIN32)
+        std::vector<void*> changeHandles;
+#endif
+
+        void startScan(bool full, std::vector<string> directories);
+        void runScan(Crawl& crawl, std::vector<string> directories);
+        void crawlDirectory(Crawl& crawl, const string& directory, bool forceRead);
+        void mergeCrawl(Crawl& crawl);
+        std::vector<DiscoveredProject> collectProjects() const;
+
+        bool readCache();
+        void writeCache() const;
+
+        void startWatching();
+        void stopWatching();
+        void watchDirectory(const string& directory);
+        bool hasChangeNotifications() const;
+        void readChangeNotifications();
+    };
+
+}
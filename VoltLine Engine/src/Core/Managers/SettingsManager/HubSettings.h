@@ -0,0 +1,89 @@
+#pragma once
+
+#include "pch.h"
+
+#include <optional>
+
+#include "Core/Managers/SettingsManager/SettingsSchema.h"
+
+namespace SettingsManager {
+
+    // hub_settings.json, parsed once per load (see SettingsSchema.h). Member
+    // defaults are what the hub uses when a key is missing or has the wrong type.
+
+    struct EngineSettings {
+        string engineVersion;
+        string logFileDir = "logs/voltline_hub.log";
+        string preferredEditorWin = "notepad.exe";
+        int logMaxFileSizeMb = 5;
+        int logMaxFiles = 3;
+        bool asyncLogging = true;
+        int logQueueSize = 8192;
+        string logOverflowPolicy = "block";
+    };
+
+    struct DebugSettings {
+        bool logging = true;
+        bool enableDebugMode = false;
+        bool showFps = false;
+    };
+
+    struct RenderSettings {
+        int maxFps = 0;
+        bool vsync = false;
+        bool idleMode = true;
+        std::vector<string> renderers;
+    };
+
+    struct HubSettings {
+        EngineSettings engine;
+        DebugSettings debugging;
+        RenderSettings render;
+        // Action name -> key combination, e.g. { "CloseApp", "CTRL+Q" }.
+        std::vector<std::pair<string, string>> keybinds;
+        // Unset means "use the default projects directory".
+        std::optional<std::vector<string>> projectRoots;
+    };
+
+    template<> struct Schema<EngineSettings> {
+        static constexpr auto fields = std::make_tuple(
+            field("engine_version", &EngineSettings::engineVersion),
+            field("engine_log_file_dir", &EngineSettings::logFileDir),
+            field("preferred_editor_win", &EngineSettings::preferredEditorWin),
+            field("log_max_file_size_mb", &EngineSettings::logMaxFileSizeMb),
+            field("log_max_files", &EngineSettings::logMaxFiles),
+            field("async_logging", &EngineSettings::asyncLogging),
+            field("log_queue_size", &EngineSettings::logQueueSize),
+            field("log_overflow_policy", &EngineSettings::logOverflowPolicy));
+    };
+
+    template<> struct Schema<DebugSettings> {
+        static constexpr auto fields = std::make_tuple(
+            field("logging", &DebugSettings::logging),
+            field("enable_debug_mode", &DebugSettings::enableDebugMode),
+            field("show_fps", &DebugSettings::showFps));
+    };
+
+    template<> struct Schema<RenderSettings> {
+        static constexpr auto fields = std::make_tuple(
+            field("max_fps", &RenderSettings::maxFps),
+            field("vsync", &RenderSettings::vsync),
+            field("idle_mode", &RenderSettings::idleMode),
+            field("renderers", &RenderSettings::renderers));
+    };
+
+    template<> struct Schema<HubSettings> {
+        static constexpr auto fields = std::make_tuple(
+            field("engine_settings", &HubSettings::engine),
+            field("debugging", &HubSettings::debugging),
+            field("render_settings", &HubSettings::render),
+            field("keybinds", &HubSettings::keybinds),
+            field("project_roots", &HubSettings::projectRoots));
+    };
+
+    // The plugin host validates "plugins" itself, entry by entry.
+    template<> struct IgnoredKeys<HubSettings> {
+        static constexpr std::array<std::string_view, 1> keys{ "plugins" };
+    };
+
+}
@@ -0,0 +1,232 @@
+#pragma once
+
+#include "pch.h"
+
+#include "nlohmann/json.hpp"
+
+#include "Core/FileSystem/VirtualFileSystem.h"
+#include "Core/Profiler/Profiler.h"
+#include "Core/Logging/HubLogger.h"
+#include "Core/Managers/SettingsManager/SettingsWriter.h"
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
+namespace SettingsManager {
+
+    using json = nlohmann::json;
+
+    // Resolves a hub data file through the "hub" mount: the working directory first,
+    // then the build output directory.
+    inline std::filesystem::path resolveHubFile(const std::string& fileName) {
+        return FileSystem::vfs().resolve("hub://" + fileName);
+    }
+
+    inline bool readWholeFile(const std::filesystem::path& filePath, string& out) {
+        std::ifstream file(filePath, std::ios::in | std::ios::binary);
+        if (!file.is_open())
+            return false;
+
+        file.seekg(0, std::ios::end);
+        std::streamoff size = file.tellg();
+        file.seekg(0, std::ios::beg);
+
+        out.resize(size > 0 ? static_cast<size_t>(size) : 0);
+        if (size > 0)
+            file.read(out.data(), size);
+
+        return static_cast<bool>(file) || file.eof();
+    }
+
+    // Parses a JSON file once and keeps the document in memory, falling back to
+    // hub://defaults/<fileName> while the file doesn't exist. The file is only
+    // re-read when it actually changed on disk (inotify on Linux, throttled mtime
+    // checks elsewhere), so hot paths like key callbacks never touch the disk.
+    // A save that doesn't parse (an editor half-way through writing, a typo) is
+    // logged and otherwise ignored: the last good document stays.
+    //
+    // References returned by get() stay valid until the next poll() or update().
+    class SettingsStore {
+    public:
+        explicit SettingsStore(const std::string& fileName)
+            : fileName(fileName), filePath(resolveHubFile(fileName)) {
+            load();
+            startWatching();
+        }
+
+        ~SettingsStore() {
+#ifdef __linux__
+            if (watchFd >= 0)
+                close(watchFd);
+#endif
+        }
+
+        SettingsStore(const SettingsStore&) = delete;
+        SettingsStore& operator=(const SettingsStore&) = delete;
+
+        const json& get() const { return document; }
+        const std::filesystem::path& getPath() const { return filePath; }
+
+        // Bumped every time the cached document changes, so callers holding derived
+        // state (UI toggles, compiled key bindings, ...) know when to rebuild it.
+        uint64_t getGeneration() const { return generation; }
+
+        // Cheap enough to call once per frame. Returns true if the document was reloaded.
+        bool poll() {
+            if (awaitingWrite) {
+                // Don't reload half-way through our own save; once it lands, what is
+                // on disk is what we already hold.
+                if (settingsWriter().isPending(filePath))
+                    return false;
+
+                awaitingWrite = false;
+                loadedStamp = currentStamp();
+            }
+
+            if (!changeSignalled())
+                return false;
+
+            if (currentStamp() == loadedStamp)
+                return false;
+
+            load();
+            return true;
+        }
+
+        // Replaces the cached document after the hub wrote it itself, without
+        // re-reading the file we just produced.
+        void update(const json& j) {
+            document = j;
+            loadedStamp = currentStamp();
+            ++generation;
+        }
+
+        // update() plus a write to disk on the settings writer thread.
+        void save(const json& j) {
+            update(j);
+            settingsWriter().submit(filePath, j);
+            awaitingWrite = true;
+        }
+
+    private:
+        struct FileStamp {
+            std::filesystem::file_time_type writeTime{};
+            uintmax_t size = 0;
+
+            bool operator==(const FileStamp&) const = default;
+        };
+
+        string fileName;
+        std::filesystem::path filePath;
+        json document;
+        FileStamp loadedStamp;
+        uint64_t generation = 0;
+        bool awaitingWrite = false;
+
+        std::chrono::steady_clock::time_point lastCheck{};
+        static constexpr std::chrono::milliseconds checkInterval{ 250 };
+
+#ifdef __linux__
+        int watchFd = -1;
+#endif
+
+        FileStamp currentStamp() const {
+            FileStamp stamp;
+            std::error_code ec;
+            stamp.writeTime = std::filesystem::last_write_time(filePath, ec);
+            stamp.size = std::filesystem::file_size(filePath, ec);
+            return stamp;
+        }
+
+        void load() {
+            VOLT_PROFILE_SCOPE("SettingsStore::load");
+
+            string text;
+            loadedStamp = currentStamp();
+
+            // Until the user saves their own copy, the shipped defaults (usually a
+            // view into hub.vpak) stand in for the file.
+            std::optional<FileSystem::AssetData> defaults;
+            std::string_view source;
+            if (readWholeFile(filePath, text))
+                source = text;
+            else if ((defaults = FileSystem::vfs().read("hub://defaults/" + fileName)))
+                source = defaults->text();
+
+            json parsed;
+            if (!source.empty()) {
+                try {
+                    parsed = json::parse(source);
+                }
+                catch (const std::exception& e) {
+                    cf_Sink::logger->error(std::format("Could not parse {}: {}", filePath.string(), e.what()));
+
+                    // Nothing good loaded yet: start from an empty document, as for a missing file.
+                    if (generation > 0)
+                        return;
+                }
+            }
+
+            document = std::move(parsed);
+            ++generation;
+        }
+
+        void startWatching() {
+#ifdef __linux__
+            // Watch the directory rather than the file: editors usually save by
+            // writing a temp file and renaming it over the original.
+            watchFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (watchFd < 0)
+                return;
+
+            std::filesystem::path directory = filePath.has_parent_path() ? filePath.parent_path() : std::filesystem::path(".");
+            if (inotify_add_watch(watchFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0) {
+                close(watchFd);
+                watchFd = -1;
+            }
+#endif
+        }
+
+        bool changeSignalled() {
+#ifdef __linux__
+            if (watchFd >= 0) {
+                alignas(inotify_event) char buffer[4096];
+                bool matched = false;
+                string name = filePath.filename().string();
+
+                ssize_t length;
+                while ((length = read(watchFd, buffer, sizeof(buffer))) > 0) {
+                    for (char* ptr = buffer; ptr < buffer + length;) {
+                        auto* event = reinterpret_cast<inotify_event*>(ptr);
+                        if (event->len > 0 && name == event->name)
+                            matched = true;
+                        ptr += sizeof(inotify_event) + event->len;
+                    }
+                }
+
+                return matched;
+            }
+#endif
+            auto now = std::chrono::steady_clock::now();
+            if (now - lastCheck < checkInterval)
+                return false;
+
+            lastCheck = now;
+            return true;
+        }
+    };
+
+    inline SettingsStore& hubSettings() {
+        static SettingsStore store("hub_settings.json");
+        return store;
+    }
+
+    inline SettingsStore& projectsFile() {
+        static SettingsStore store("projects.json");
+        return store;
+    }
+
+}
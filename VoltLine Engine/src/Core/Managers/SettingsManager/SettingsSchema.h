@@ -0,0 +1,281 @@
+#pragma once
+
+#include "pch.h"
+
+#include <array>
+#include <limits>
+#include <optional>
+#include <tuple>
+#include <utility>
+
+#include "nlohmann/json.hpp"
+
+namespace SettingsManager {
+
+    // Declarative JSON <-> struct mapping for settings files. A struct opts in by
+    // specializing Schema with a tuple of (key, member pointer) fields:
+    //
+    //   template<> struct Schema<RenderSettings> {
+    //       static constexpr auto fields = std::make_tuple(
+    //           field("max_fps", &RenderSettings::maxFps),
+    //           field("vsync", &RenderSettings::vsync));
+    //   };
+    //
+    // parseSettings() fills the struct in one pass over the document. A missing key
+    // keeps the member's default; a key of the wrong type, or an integer the member
+    // can't hold, keeps the default too and is reported, as is any key the schema
+    // doesn't declare. Nothing throws, so a hand-edited file can't take the hub
+    // down, and nothing looks keys up later: the parsed struct is read with plain
+    // member access.
+    //
+    // Supported member types: bool, integers, floating point, string, std::vector
+    // and std::optional of those, ordered string maps (as vectors of pairs), and
+    // any struct with a Schema of its own.
+
+    template<typename T>
+    struct Schema;
+
+    template<typename Struct, typename T>
+    struct Field {
+        std::string_view key;
+        T Struct::* member;
+    };
+
+    template<typename Struct, typename T>
+    constexpr Field<Struct, T> field(std::string_view key, T Struct::* member) {
+        return { key, member };
+    }
+
+    // Keys a schema leaves to someone else (e.g. "plugins", read by the plugin host):
+    // accepted without being parsed or reported.
+    template<typename T>
+    struct IgnoredKeys {
+        static constexpr std::array<std::string_view, 0> keys{};
+    };
+
+    struct SchemaReport {
+        std::vector<string> errors;     // wrong types: the default was used instead
+        std::vector<string> warnings;   // unknown keys
+
+        bool ok() const { return errors.empty(); }
+    };
+
+    namespace Detail {
+
+        template<typename T>
+        concept HasSchema = requires { Schema<T>::fields; };
+
+        template<typename T>
+        struct IsVector : std::false_type {};
+        template<typename T>
+        struct IsVector<std::vector<T>> : std::true_type {};
+
+        template<typename T>
+        struct IsOptional : std::false_type {};
+        template<typename T>
+        struct IsOptional<std::optional<T>> : std::true_type {};
+
+        // "render_settings" + "max_fps" -> "render_settings.max_fps"
+        inline string join(std::string_view path, std::string_view key) {
+            return path.empty() ? string(key) : std::format("{}.{}", path, key);
+        }
+
+        template<typename T>
+        string typeName() {
+            if constexpr (IsOptional<T>::value) return typeName<typename T::value_type>();
+            else if constexpr (std::is_same_v<T, bool>) return "a boolean";
+            else if constexpr (std::is_integral_v<T>) return std::format("an integer from {} to {}", std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+            else if constexpr (std::is_floating_point_v<T>) return "a number";
+            else if constexpr (std::is_same_v<T, string>) return "a string";
+            else if constexpr (IsVector<T>::value) return "an array";
+            else return "an object";
+        }
+
+        template<typename T>
+        bool read(const nlohmann::json& value, T& out, std::string_view path, SchemaReport& report);
+
+        template<typename Struct, typename T>
+        bool readField(const string& key, const nlohmann::json& value, Struct& out, const Field<Struct, T>& field, std::string_view path, SchemaReport& report);
+
+        template<typename T>
+        bool readObject(const nlohmann::json& object, T& out, std::string_view path, SchemaReport& report) {
+            if (!object.is_object())
+                return false;
+
+            for (const auto& [key, value] : object.items()) {
+                bool known = false;
+                std::apply([&](const auto&... fields) {
+                    ((known = known || readField(key, value, out, fields, path, report)), ...);
+                }, Schema<T>::fields);
+
+                for (std::string_view ignored : IgnoredKeys<T>::keys)
+                    known = known || key == ignored;
+
+                if (!known)
+                    report.warnings.push_back(std::format("unknown setting {}", join(path, key)));
+            }
+            return true;
+        }
+
+        template<typename Struct, typename T>
+        bool readField(const string& key, const nlohmann::json& value, Struct& out, const Field<Struct, T>& field, std::string_view path, SchemaReport& report) {
+            if (key != field.key)
+                return false;
+
+            string fieldPath = join(path, field.key);
+            T parsed{};
+            if (read(value, parsed, fieldPath, report))
+                out.*field.member = std::move(parsed);
+            else
+                report.errors.push_back(std::format("{} should be {}; using the default", fieldPath, typeName<T>()));
+            return true;
+        }
+
+        template<typename T>
+        bool read(const nlohmann::json& value, T& out, std::string_view path, SchemaReport& report) {
+            if constexpr (std::is_same_v<T, bool>) {
+                if (!value.is_boolean())
+                    return false;
+                out = value.get<bool>();
+                return true;
+            }
+            else if constexpr (std::is_integral_v<T>) {
+                if (!value.is_number_integer())
+                    return false;
+                // get<T>() would silently wrap a value that doesn't fit.
+                if (value.is_number_unsigned() ? !std::in_range<T>(value.get<uint64_t>()) : !std::in_range<T>(value.get<int64_t>()))
+                    return false;
+                out = value.get<T>();
+                return true;
+            }
+            else if constexpr (std::is_floating_point_v<T>) {
+                if (!value.is_number())
+                    return false;
+                out = value.get<T>();
+                return true;
+            }
+            else if constexpr (std::is_same_v<T, string>) {
+                if (!value.is_string())
+                    return false;
+                out = value.get_ref<const string&>();
+                return true;
+            }
+            else if constexpr (IsOptional<T>::value) {
+                typename T::value_type parsed{};
+                if (!read(value, parsed, path, report))
+                    return false;
+                out = std::move(parsed);
+                return true;
+            }
+            else if constexpr (std::is_same_v<T, std::vector<std::pair<string, string>>>) {
+                if (!value.is_object())
+                    return false;
+                for (const auto& [key, item] : value.items()) {
+                    if (item.is_string())
+                        out.emplace_back(key, item.template get_ref<const string&>());
+                    else
+                        report.errors.push_back(std::format("{} should be a string; ignored", join(path, key)));
+                }
+                return true;
+            }
+            else if constexpr (IsVector<T>::value) {
+                if (!value.is_array())
+                    return false;
+                for (size_t i = 0; i < value.size(); ++i) {
+                    typename T::value_type item{};
+                    if (read(value[i], item, std::format("{}[{}]", path, i), report))
+                        out.push_back(std::move(item));
+                    else
+                        report.errors.push_back(std::format("{}[{}] should be {}; ignored", path, i, typeName<typename T::value_type>()));
+                }
+                return true;
+            }
+            else {
+                static_assert(HasSchema<T>, "settings member type has no Schema");
+                return readObject(value, out, path, report);
+            }
+        }
+
+        template<typename T>
+        nlohmann::json write(const T& value);
+
+        template<typename Struct, typename T>
+        void writeField(const Struct& value, const Field<Struct, T>& field, nlohmann::json& object);
+
+        template<typename T>
+        void writeObject(const T& value, nlohmann::json& object) {
+            std::apply([&](const auto&... fields) {
+                (writeField(value, fields, object), ...);
+            }, Schema<T>::fields);
+        }
+
+        template<typename Struct, typename T>
+        void writeField(const Struct& value, const Field<Struct, T>& field, nlohmann::json& object) {
+            const T& member = value.*field.member;
+            if constexpr (IsOptional<T>::value) {
+                if (!member) {
+                    object.erase(string(field.key));
+                    return;
+                }
+            }
+
+            nlohmann::json& target = object[string(field.key)];
+            if constexpr (HasSchema<T>) {
+                // Merged, so keys a nested schema doesn't own survive.
+                if (!target.is_object())
+                    target = nlohmann::json::object();
+                writeObject(member, target);
+            }
+            else {
+                target = write(member);
+            }
+        }
+
+        template<typename T>
+        nlohmann::json write(const T& value) {
+            if constexpr (IsOptional<T>::value) {
+                return write(*value);
+            }
+            else if constexpr (std::is_same_v<T, std::vector<std::pair<string, string>>>) {
+                nlohmann::json object = nlohmann::json::object();
+                for (const auto& [key, item] : value)
+                    object[key] = item;
+                return object;
+            }
+            else if constexpr (IsVector<T>::value) {
+                nlohmann::json array = nlohmann::json::array();
+                for (const auto& item : value)
+                    array.push_back(write(item));
+                return array;
+            }
+            else if constexpr (HasSchema<T>) {
+                nlohmann::json object = nlohmann::json::object();
+                writeObject(value, object);
+                return object;
+            }
+            else {
+                return nlohmann::json(value);
+            }
+        }
+
+    }
+
+    // Parses a whole settings document into T, starting from T's defaults.
+    template<typename T>
+    T parseSettings(const nlohmann::json& document, SchemaReport& report) {
+        T settings{};
+        if (!document.is_null() && !Detail::readObject(document, settings, {}, report))
+            report.errors.push_back("settings file is not a JSON object; using the defaults");
+        return settings;
+    }
+
+    // Writes every schema field of settings into document, leaving keys the schema
+    // doesn't declare (ignored keys, unknown keys) as they were.
+    template<typename T>
+    void writeSettings(const T& settings, nlohmann::json& document) {
+        if (!document.is_object())
+            document = nlohmann::json::object();
+        Detail::writeObject(settings, document);
+    }
+
+}
@@ -0,0 +1,125 @@
+#include "SettingsWriter.h"
+
+#include "Core/FileSystem/AtomicFile.h"
+#include "Core/Profiler/Profiler.h"
+
+namespace SettingsManager {
+
+    SettingsWriter::SettingsWriter(std::chrono::milliseconds debounce)
+        : debounce(debounce), worker(&SettingsWriter::run, this) {
+    }
+
+    SettingsWriter::~SettingsWriter() {
+        shutdown();
+    }
+
+    void SettingsWriter::submit(const std::filesystem::path& path, json document) {
+        Clock::time_point now = Clock::now();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            auto [it, inserted] = pending.try_emplace(path);
+            it->second.document = std::move(document);
+            it->second.lastQueued = now;
+            if (inserted)
+                it->second.firstQueued = now;
+        }
+
+        wake.notify_one();
+    }
+
+    bool SettingsWriter::isPending(const std::filesystem::path& path) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return pending.contains(path) || inFlight == path;
+    }
+
+    void SettingsWriter::flush() {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (pending.empty() && inFlight.empty())
+            return;
+
+        flushing = true;
+        wake.notify_one();
+        idle.wait(lock, [&] { return pending.empty() && inFlight.empty(); });
+        flushing = false;
+    }
+
+    std::vector<WriteFailure> SettingsWriter::takeFailures() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return std::exchange(failures, {});
+    }
+
+    void SettingsWriter::shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+
+        wake.notify_one();
+        if (worker.joinable())
+            worker.join();
+    }
+
+    void SettingsWriter::run() {
+        VOLT_PROFILE_THREAD("Settings Writer");
+
+        std::unique_lock<std::mutex> lock(mutex);
+
+        while (true) {
+            if (pending.empty()) {
+                if (stopping)
+                    break;
+
+                wake.wait(lock, [&] { return stopping || !pending.empty(); });
+                continue;
+            }
+
+            // Pick the file whose quiet period ends first.
+            Clock::time_point now = Clock::now();
+            auto next = pending.end();
+            Clock::time_point nextDue = Clock::time_point::max();
+
+            for (auto it = pending.begin(); it != pending.end(); ++it) {
+                Clock::time_point due = std::min(it->second.lastQueued + debounce, it->second.firstQueued + MaxDelay);
+                if (flushing || stopping)
+                    due = now;
+
+                if (due < nextDue) {
+                    nextDue = due;
+                    next = it;
+                }
+            }
+
+            if (nextDue > now) {
+                wake.wait_until(lock, nextDue);
+                continue;
+            }
+
+            std::filesystem::path path = next->first;
+            json document = std::move(next->second.document);
+            pending.erase(next);
+            inFlight = path;
+
+            lock.unlock();
+
+            string error;
+            bool written;
+            {
+                VOLT_PROFILE_SCOPE("SettingsWriter::write");
+                written = FileSystem::writeFileAtomically(path, document.dump(4), error);
+            }
+
+            lock.lock();
+
+            inFlight.clear();
+            if (!written)
+                failures.push_back({ path, error });
+
+            idle.notify_all();
+        }
+
+        idle.notify_all();
+    }
+
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "pch.h"
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+
+#include "nlohmann/json.hpp"
+
+namespace SettingsManager {
+
+    using json = nlohmann::json;
+
+    struct WriteFailure {
+        std::filesystem::path path;
+        string message;
+    };
+
+    // Persists JSON documents on a background thread so the UI never waits on the
+    // disk. Documents submitted for the same file within the debounce window are
+    // coalesced and only the latest one is written, via FileSystem::writeFileAtomically.
+    // Failures are queued for the UI to pick up with takeFailures().
+    class SettingsWriter {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit SettingsWriter(std::chrono::milliseconds debounce = std::chrono::milliseconds(250));
+        ~SettingsWriter();
+
+        SettingsWriter(const SettingsWriter&) = delete;
+        SettingsWriter& operator=(const SettingsWriter&) = delete;
+
+        void submit(const std::filesystem::path& path, json document);
+
+        // True while a document for path is waiting or being written.
+        bool isPending(const std::filesystem::path& path) const;
+
+        // Writes everything queued right away and waits for it, e.g. before the
+        // file is handed to an external editor.
+        void flush();
+
+        std::vector<WriteFailure> takeFailures();
+
+        // Flushes and stops the worker. Called again by the destructor.
+        void shutdown();
+
+    private:
+        struct PendingWrite {
+            json document;
+            Clock::time_point firstQueued;
+            Clock::time_point lastQueued;
+        };
+
+        // A stream of edits (dragging a slider, mashing a checkbox) still reaches
+        // the disk at least this often.
+        static constexpr std::chrono::milliseconds MaxDelay{ 1000 };
+
+        std::chrono::milliseconds debounce;
+
+        mutable std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable idle;
+
+        std::map<std::filesystem::path, PendingWrite> pending;
+        std::filesystem::path inFlight;
+        std::vector<WriteFailure> failures;
+
+        bool flushing = false;
+        bool stopping = false;
+        std::thread worker;
+
+        void run();
+    };
+
+    inline SettingsWriter& settingsWriter() {
+        static SettingsWriter writer;
+        return writer;
+    }
+
+}
@@ -0,0 +1,432 @@
+#include "PluginHost.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+
+#include "Core/Logging/HubLogger.h"
+#include "Core/Profiler/Profiler.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+namespace Plugins {
+
+    namespace {
+
+        Plugin& pluginFrom(VoltPluginContext* context) {
+            // The context handed to a plugin is the address of its Plugin.
+            return *reinterpret_cast<Plugin*>(context);
+        }
+
+        VoltPluginContext* contextFor(Plugin& plugin) {
+            return reinterpret_cast<VoltPluginContext*>(&plugin);
+        }
+
+        void hostLog(VoltPluginContext* context, VoltLogLevel level, const char* message) {
+            const string& name = pluginFrom(context).name;
+            switch (level) {
+            case VOLT_LOG_DEBUG: cf_Sink::logger->debug(std::format("[{}] {}", name, message)); break;
+            case VOLT_LOG_INFO: cf_Sink::logger->info(std::format("[{}] {}", name, message)); break;
+            case VOLT_LOG_WARN: cf_Sink::logger->warn(std::format("[{}] {}", name, message)); break;
+            default: cf_Sink::logger->error(std::format("[{}] {}", name, message)); break;
+            }
+        }
+
+        void* hostAllocate(VoltPluginContext* context, size_t size) {
+            void* pointer = std::malloc(size);
+            if (!pointer)
+                return nullptr;
+
+            Plugin& plugin = pluginFrom(context);
+            int64_t now = plugin.allocatedBytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) + static_cast<int64_t>(size);
+            int64_t peak = plugin.peakAllocatedBytes.load(std::memory_order_relaxed);
+            while (now > peak && !plugin.peakAllocatedBytes.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {}
+
+            return pointer;
+        }
+
+        void hostDeallocate(VoltPluginContext* context, void* pointer, size_t size) {
+            if (!pointer)
+                return;
+
+            std::free(pointer);
+            pluginFrom(context).allocatedBytes.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+        }
+
+        const VoltHostApi HostApi = {
+            VOLT_PLUGIN_API_VERSION,
+            sizeof(VoltHostApi),
+            hostLog,
+            hostAllocate,
+            hostDeallocate,
+        };
+
+        void* openLibrary(const std::filesystem::path& file, string& error) {
+#ifdef _WIN32
+            HMODULE module = LoadLibraryW(file.c_str());
+            if (!module)
+                error = std::format("LoadLibrary failed with error {}", GetLastError());
+            return module;
+#else
+            // RTLD_LAZY: the plugin's own imports are bound on first call too.
+            void* handle = dlopen(file.c_str(), RTLD_LAZY | RTLD_LOCAL);
+            if (!handle)
+                error = dlerror();
+            return handle;
+#endif
+        }
+
+        void* findSymbol(void* library, const char* name) {
+#ifdef _WIN32
+            return reinterpret_cast<void*>(GetProcAddress(static_cast<HMODULE>(library), name));
+#else
+            return dlsym(library, name);
+#endif
+        }
+
+        void closeLibrary(void* library) {
+#ifdef _WIN32
+            FreeLibrary(static_cast<HMODULE>(library));
+#else
+            dlclose(library);
+#endif
+        }
+
+        std::optional<PluginType> typeFromName(string name) {
+            std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+            if (name == "core")
+                return PluginType::Core;
+            if (name == "external")
+                return PluginType::External;
+            return std::nullopt;
+        }
+
+        double millisecondsSince(std::chrono::steady_clock::time_point start) {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        // 2.4 MB, 12.0 KB, 512 B: formatted as "{:.{}f} {}" with value, precision, unit.
+        struct ByteSize {
+            double value;
+            int precision;
+            const char* unit;
+        };
+
+        ByteSize scaleBytes(int64_t bytes) {
+            if (bytes >= 1024 * 1024)
+                return { bytes / (1024.0 * 1024.0), 1, "MB" };
+            if (bytes >= 1024)
+                return { bytes / 1024.0, 1, "KB" };
+            return { static_cast<double>(bytes), 0, "B" };
+        }
+
+    }
+
+    const char* stateName(PluginState state) {
+        switch (state) {
+        case PluginState::Unloaded: return "Not loaded";
+        case PluginState::Loading: return "Loading";
+        case PluginState::Ready: return "Ready";
+        case PluginState::Failed: return "Failed";
+        case PluginState::Disabled: return "Disabled";
+        }
+        return "Unknown";
+    }
+
+    std::string_view describeStatus(const Plugin& plugin, std::span<char> buffer) {
+        PluginState state = plugin.state.load(std::memory_order_acquire);
+
+        if (state == PluginState::Failed) {
+            auto result = std::format_to_n(buffer.data(), buffer.size(), "Failed: {}", plugin.error);
+            return { buffer.data(), static_cast<size_t>(result.out - buffer.data()) };
+        }
+
+        if (state != PluginState::Ready)
+            return stateName(state);
+
+        ByteSize image = scaleBytes(static_cast<int64_t>(plugin.imageBytes));
+        ByteSize allocated = scaleBytes(plugin.allocatedBytes.load());
+        ByteSize peak = scaleBytes(plugin.peakAllocatedBytes.load());
+
+        auto result = std::format_to_n(buffer.data(), buffer.size(),
+            "Ready (load {:.1f} ms, init {:.1f} ms, image {:.{}f} {}, allocated {:.{}f} {}, peak {:.{}f} {})",
+            plugin.loadMilliseconds, plugin.initMilliseconds, image.value, image.precision, image.unit,
+            allocated.value, allocated.precision, allocated.unit, peak.value, peak.precision, peak.unit);
+        return { buffer.data(), static_cast<size_t>(result.out - buffer.data()) };
+    }
+
+    string describeStatus(const Plugin& plugin) {
+        std::array<char, 512> buffer;
+        return string(describeStatus(plugin, buffer));
+    }
+
+    PluginHost::~PluginHost() {
+        shutdown();
+    }
+
+    void PluginHost::configure(const json& settings) {
+        if (!settings.contains("plugins") || !settings["plugins"].is_object())
+            return;
+
+        for (const auto& [name, value] : settings["plugins"].items()) {
+            bool enabled = value.is_object() && value.contains("enabled")
+                && (value["enabled"].is_boolean() ? value["enabled"].get<bool>() : value["enabled"].is_number() && value["enabled"].get<int>() != 0);
+
+            if (Plugin* existing = findMutable(name)) {
+                // Only flips between "disabled" and "not loaded yet"; a loaded plugin stays loaded.
+                PluginState expected = enabled ? PluginState::Disabled : PluginState::Unloaded;
+                existing->state.compare_exchange_strong(expected, enabled ? PluginState::Unloaded : PluginState::Disabled);
+                continue;
+            }
+
+            Plugin* added;
+            {
+                // Loads running on workers look plugins up by name.
+                std::lock_guard<std::mutex> lock(pluginsMutex);
+                added = &plugins.emplace_back();
+                added->name = name;
+                byName[name] = added;
+            }
+            Plugin& plugin = *added;
+
+            if (!value.is_object()) {
+                fail(plugin, "entry is not an object");
+                continue;
+            }
+
+            auto text = [&value](const char* key) {
+                return value.contains(key) && value[key].is_string() ? value[key].get<string>() : string();
+            };
+
+            std::optional<PluginType> type = typeFromName(text("type"));
+            if (!type) {
+                fail(plugin, std::format("invalid plugin type \"{}\" (expected core or external)", text("type")));
+                continue;
+            }
+
+            plugin.type = *type;
+            plugin.file = std::filesystem::path(text("location")) / text("primaryFile");
+            plugin.displayPath = plugin.file.string();
+
+            if (value.contains("dependencies") && value["dependencies"].is_array()) {
+                for (const json& dependency : value["dependencies"]) {
+                    if (dependency.is_string())
+                        plugin.dependencies.push_back(dependency.get<string>());
+                }
+            }
+
+            plugin.state.store(enabled ? PluginState::Unloaded : PluginState::Disabled);
+        }
+
+        markDependencyCycles();
+
+        if (coreStarted)
+            loadCorePlugins();
+    }
+
+    void PluginHost::loadCorePlugins() {
+        VOLT_PROFILE_SCOPE("PluginHost::loadCorePlugins");
+
+        coreStarted = true;
+
+        // A plugin still queued in an earlier graph may be added again; whichever
+        // load runs second finds it done.
+        EngineManager::JobGraph& graph = loadGraphs.emplace_back();
+        std::unordered_map<Plugin*, EngineManager::JobGraph::NodeId> nodes;
+        for (Plugin& plugin : plugins) {
+            if (plugin.type == PluginType::Core && plugin.state.load() == PluginState::Unloaded)
+                nodes[&plugin] = graph.add([this, &plugin]() { load(plugin); });
+        }
+
+        // Dependencies outside the graph (external plugins) are loaded by load() itself.
+        for (auto& [plugin, node] : nodes) {
+            for (const string& dependency : plugin->dependencies) {
+                auto dependencyNode = nodes.find(findMutable(dependency));
+                if (dependencyNode != nodes.end())
+                    graph.precede(dependencyNode->second, node);
+            }
+        }
+
+        if (!nodes.empty())
+            graph.run(EngineManager::jobSystem(), loadJobs);
+        else
+            loadGraphs.pop_back();
+    }
+
+    const VoltPluginApi* PluginHost::acquire(const string& name) {
+        Plugin* plugin = findMutable(name);
+        if (!plugin || !load(*plugin, false))
+            return nullptr;
+        return plugin->api;
+    }
+
+    void* PluginHost::getInterface(const string& name, const char* interfaceName) {
+        const VoltPluginApi* api = acquire(name);
+        return api && api->getInterface ? api->getInterface(interfaceName) : nullptr;
+    }
+
+    const Plugin* PluginHost::find(const string& name) const {
+        std::lock_guard<std::mutex> lock(pluginsMutex);
+        auto it = byName.find(name);
+        return it != byName.end() ? it->second : nullptr;
+    }
+
+    Plugin* PluginHost::findMutable(const string& name) {
+        std::lock_guard<std::mutex> lock(pluginsMutex);
+        auto it = byName.find(name);
+        return it != byName.end() ? it->second : nullptr;
+    }
+
+    void PluginHost::fail(Plugin& plugin, string error) {
+        cf_Sink::logger->error(std::format("Plugin {}: {}", plugin.name, error));
+        plugin.error = std::move(error);
+        plugin.state.store(PluginState::Failed, std::memory_order_release);
+    }
+
+    bool PluginHost::load(Plugin& plugin, bool wait) {
+        PluginState state = plugin.state.load(std::memory_order_acquire);
+        if (state == PluginState::Ready)
+            return true;
+        if (state == PluginState::Failed || state == PluginState::Disabled)
+            return false;
+
+        std::unique_lock<std::mutex> lock(plugin.loadMutex, std::defer_lock);
+        if (wait)
+            lock.lock();
+        else if (!lock.try_lock())
+            return false;
+
+        // Someone else may have finished it while we waited for the lock.
+        state = plugin.state.load(std::memory_order_acquire);
+        if (state != PluginState::Unloaded)
+            return state == PluginState::Ready;
+
+        VOLT_PROFILE_SCOPE("PluginHost::load");
+
+        // Cycles were ruled out in configure(), so this recursion terminates.
+        for (const string& dependencyName : plugin.dependencies) {
+            Plugin* dependency = findMutable(dependencyName);
+            if (!dependency) {
+                fail(plugin, std::format("unknown dependency {}", dependencyName));
+                return false;
+            }
+            if (!load(*dependency, wait)) {
+                // Not failed, just busy elsewhere: leave this one for a later attempt.
+                PluginState dependencyState = dependency->state.load(std::memory_order_acquire);
+                if (dependencyState != PluginState::Failed && dependencyState != PluginState::Disabled)
+                    return false;
+
+                fail(plugin, std::format("dependency {} is not available", dependencyName));
+                return false;
+            }
+        }
+
+        plugin.state.store(PluginState::Loading);
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        string error;
+        plugin.library = openLibrary(plugin.file, error);
+        if (!plugin.library) {
+            fail(plugin, std::format("could not load {}: {}", plugin.file.string(), error));
+            return false;
+        }
+
+        std::error_code ec;
+        plugin.imageBytes = std::filesystem::file_size(plugin.file, ec);
+
+        auto entry = reinterpret_cast<VoltPluginEntry>(findSymbol(plugin.library, VOLT_PLUGIN_ENTRY_NAME));
+        const VoltPluginApi* api = entry ? entry() : nullptr;
+
+        if (!api || api->apiVersion != VOLT_PLUGIN_API_VERSION || api->structSize < sizeof(VoltPluginApi) || !api->initialize) {
+            closeLibrary(plugin.library);
+            plugin.library = nullptr;
+            fail(plugin, !entry ? string("no " VOLT_PLUGIN_ENTRY_NAME " export") : std::format("built against an incompatible plugin API (version {})", api ? api->apiVersion : 0));
+            return false;
+        }
+
+        plugin.loadMilliseconds = millisecondsSince(start);
+
+        start = std::chrono::steady_clock::now();
+        int result = api->initialize(&HostApi, contextFor(plugin));
+        plugin.initMilliseconds = millisecondsSince(start);
+
+        if (result != 0) {
+            closeLibrary(plugin.library);
+            plugin.library = nullptr;
+            fail(plugin, std::format("initialize returned {}", result));
+            return false;
+        }
+
+        plugin.api = api;
+        {
+            std::lock_guard<std::mutex> orderLock(initOrderMutex);
+            initOrder.push_back(&plugin);
+        }
+        plugin.state.store(PluginState::Ready, std::memory_order_release);
+
+        double total = plugin.loadMilliseconds + plugin.initMilliseconds;
+        if (total > SlowPluginThreshold.count())
+            cf_Sink::logger->warn(std::format("Plugin {} is slow to start: {}", plugin.name, describeStatus(plugin)));
+        else
+            cf_Sink::logger->info(std::format("Plugin {}: {}", plugin.name, describeStatus(plugin)));
+
+        return true;
+    }
+
+    void PluginHost::markDependencyCycles() {
+        enum class Mark { None, Visiting, Done };
+        std::unordered_map<const Plugin*, Mark> marks;
+
+        std::function<bool(Plugin&)> visit = [&](Plugin& plugin) {
+            Mark& mark = marks[&plugin];
+            if (mark == Mark::Done)
+                return false;
+            if (mark == Mark::Visiting)
+                return true;
+
+            mark = Mark::Visiting;
+            bool cyclic = false;
+            for (const string& dependencyName : plugin.dependencies) {
+                if (Plugin* dependency = findMutable(dependencyName))
+                    cyclic |= visit(*dependency);
+            }
+            marks[&plugin] = Mark::Done;
+
+            if (cyclic && plugin.state.load() == PluginState::Unloaded)
+                fail(plugin, "dependency cycle");
+            return cyclic;
+        };
+
+        for (Plugin& plugin : plugins)
+            visit(plugin);
+    }
+
+    void PluginHost::shutdown() {
+        EngineManager::jobSystem().wait(loadJobs);
+        loadGraphs.clear();
+        coreStarted = false;
+
+        std::lock_guard<std::mutex> lock(initOrderMutex);
+        for (auto it = initOrder.rbegin(); it != initOrder.rend(); ++it) {
+            Plugin& plugin = **it;
+            if (plugin.api->shutdown)
+                plugin.api->shutdown();
+
+            closeLibrary(plugin.library);
+            plugin.library = nullptr;
+            plugin.api = nullptr;
+            plugin.state.store(PluginState::Unloaded);
+        }
+        initOrder.clear();
+    }
+
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "pch.h"
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <span>
+
+#include "nlohmann/json.hpp"
+
+#include "Core/Plugins/VoltPlugin.h"
+#include "Core/Managers/EngineManager/EngineManager.h"
+
+namespace Plugins {
+
+    using json = nlohmann::json;
+
+    enum class PluginType {
+        Core,
+        External,
+    };
+
+    enum class PluginState {
+        Unloaded,
+        Loading,
+        Ready,
+        Failed,
+        Disabled,
+    };
+
+    const char* stateName(PluginState state);
+
+    // One "plugins" entry from hub_settings.json and what became of it.
+    struct Plugin {
+        string name;
+        PluginType type = PluginType::External;
+        std::filesystem::path file;
+        string displayPath;         // file.string(), kept for the settings panel
+        std::vector<string> dependencies;
+
+        std::atomic<PluginState> state{ PluginState::Unloaded };
+        string error;               // set before state becomes Failed
+
+        void* library = nullptr;
+        const VoltPluginApi* api = nullptr;
+
+        // Filled in by the load; readable once state is Ready or Failed.
+        double loadMilliseconds = 0.0;
+        double initMilliseconds = 0.0;
+        uint64_t imageBytes = 0;
+
+        // Memory the plugin took through VoltHostApi::allocate.
+        std::atomic<int64_t> allocatedBytes{ 0 };
+        std::atomic<int64_t> peakAllocatedBytes{ 0 };
+
+        std::mutex loadMutex;
+    };
+
+    // Loads hub plugins through the C ABI in VoltPlugin.h.
+    //
+    // Nothing is loaded when the configuration is read. Core plugins start loading
+    // right after, as a job graph on the engine's job system: plugins that don't
+    // depend on each other load and initialize in parallel, and none of it blocks
+    // the main loop. Core plugins a later configure() adds or enables get a graph
+    // of their own. External plugins are only loaded on first acquire().
+    //
+    // Every plugin's load and init time and its allocations through the host API
+    // are recorded, and anything slower than SlowPluginThreshold is logged.
+    // Configuration problems (unknown type, missing dependency, cycles) mark the
+    // plugin as failed instead of throwing.
+    class PluginHost {
+    public:
+        static constexpr std::chrono::milliseconds SlowPluginThreshold{ 100 };
+
+        PluginHost() = default;
+        ~PluginHost();
+
+        PluginHost(const PluginHost&) = delete;
+        PluginHost& operator=(const PluginHost&) = delete;
+
+        // Reads the "plugins" object of hub_settings.json. Plugins already known
+        // keep their state, so applying the settings again never reloads anything.
+        // Once loadCorePlugins() has run, new or newly enabled core plugins start
+        // loading in the background straight away.
+        void configure(const json& settings);
+
+        // Starts loading every enabled core plugin in the background.
+        void loadCorePlugins();
+
+        // Loads the plugin (and its dependencies) on the calling thread if needed.
+        // Returns null if it is disabled or failed to load, and also, without
+        // waiting, while another thread is loading it or one of its dependencies:
+        // its state then still reads Unloaded or Loading, so try again later.
+        const VoltPluginApi* acquire(const string& name);
+        // Shorthand for acquire(name)->getInterface(interfaceName).
+        void* getInterface(const string& name, const char* interfaceName);
+
+        const Plugin* find(const string& name) const;
+        const std::deque<Plugin>& getPlugins() const { return plugins; }
+
+        // Waits for background loads, then shuts plugins down in reverse order of initialization.
+        void shutdown();
+
+    private:
+        // Only the main thread adds plugins; the mutex covers lookups from loading workers.
+        mutable std::mutex pluginsMutex;
+        std::deque<Plugin> plugins;
+        std::unordered_map<string, Plugin*> byName;
+
+        // One graph per loadCorePlugins() call; a deque because running jobs point into them.
+        std::deque<EngineManager::JobGraph> loadGraphs;
+        EngineManager::JobCounter loadJobs;
+        bool coreStarted = false;
+
+        std::mutex initOrderMutex;
+        std::vector<Plugin*> initOrder;
+
+        Plugin* findMutable(const string& name);
+        // With wait false, gives up (returning false, leaving the plugin as it was)
+        // instead of blocking on a load already running on another thread.
+        bool load(Plugin& plugin, bool wait = true);
+        void fail(Plugin& plugin, string error);
+        void markDependencyCycles();
+    };
+
+    // "Ready (load 3.1 ms, init 12.0 ms, 2.4 MB)" and the like. The span overload
+    // formats into buffer (truncating) and allocates nothing, for the settings panel.
+    string describeStatus(const Plugin& plugin);
+    std::string_view describeStatus(const Plugin& plugin, std::span<char> buffer);
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+// The C ABI between the hub and its plugins. Plugins include only this header,
+// so it deliberately doesn't pull in pch.h or anything C++.
+//
+// A plugin is a shared library exporting one function, voltPluginEntry, that
+// returns a pointer to a static VoltPluginApi. The hub checks apiVersion, then
+// calls initialize once (possibly on a worker thread, in parallel with plugins
+// it doesn't depend on) and shutdown once before unloading it.
+//
+// Structs only ever grow at the end; structSize says how much of one the other
+// side knows about.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VOLT_PLUGIN_API_VERSION 1u
+#define VOLT_PLUGIN_ENTRY_NAME "voltPluginEntry"
+
+#if defined(_WIN32)
+#define VOLT_PLUGIN_EXPORT __declspec(dllexport)
+#else
+#define VOLT_PLUGIN_EXPORT __attribute__((visibility("default")))
+#endif
+
+typedef enum VoltLogLevel {
+    VOLT_LOG_DEBUG = 0,
+    VOLT_LOG_INFO = 1,
+    VOLT_LOG_WARN = 2,
+    VOLT_LOG_ERROR = 3,
+} VoltLogLevel;
+
+// Identifies the calling plugin to the host; opaque to plugins.
+typedef struct VoltPluginContext VoltPluginContext;
+
+// Services the hub offers a plugin. Valid from initialize until shutdown returns.
+typedef struct VoltHostApi {
+    uint32_t apiVersion;
+    uint32_t structSize;
+
+    void (*log)(VoltPluginContext* context, VoltLogLevel level, const char* message);
+
+    // Memory from these is charged to the plugin in the hub's plugin statistics.
+    void* (*allocate)(VoltPluginContext* context, size_t size);
+    void (*deallocate)(VoltPluginContext* context, void* pointer, size_t size);
+} VoltHostApi;
+
+typedef struct VoltPluginApi {
+    uint32_t apiVersion;        // VOLT_PLUGIN_API_VERSION the plugin was built against
+    uint32_t structSize;        // sizeof(VoltPluginApi)
+    const char* name;
+    const char* version;
+
+    // Returns 0 on success. Must not throw or longjmp out.
+    int (*initialize)(const VoltHostApi* host, VoltPluginContext* context);
+    void (*shutdown)(void);
+
+    // Looks up an interface the plugin implements by name; NULL if it has none.
+    void* (*getInterface)(const char* name);
+} VoltPluginApi;
+
+typedef const VoltPluginApi* (*VoltPluginEntry)(void);
+
+#ifdef __cplusplus
+}
+#endif
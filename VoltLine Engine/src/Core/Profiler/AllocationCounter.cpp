@@ -0,0 +1,69 @@
+#include "AllocationCounter.h"
+
+#include <new>
+
+#if VOLT_COUNT_ALLOCATIONS
+
+namespace {
+
+    // Plain integers: a thread_local with a constructor could itself allocate.
+    thread_local uint64_t allocationCount = 0;
+    thread_local uint64_t allocationBytes = 0;
+
+    void* countedAllocate(std::size_t size) noexcept {
+        if (size == 0)
+            size = 1;
+
+        void* pointer = std::malloc(size);
+        if (pointer) {
+            ++allocationCount;
+            allocationBytes += size;
+        }
+        return pointer;
+    }
+
+    void* countedAllocateOrThrow(std::size_t size) {
+        for (;;) {
+            if (void* pointer = countedAllocate(size))
+                return pointer;
+
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+                throw std::bad_alloc();
+            handler();
+        }
+    }
+
+}
+
+namespace Profiler {
+
+    AllocationStats threadAllocations() {
+        return { allocationCount, allocationBytes };
+    }
+
+}
+
+void* operator new(std::size_t size) { return countedAllocateOrThrow(size); }
+void* operator new[](std::size_t size) { return countedAllocateOrThrow(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedAllocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedAllocate(size); }
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+
+#else
+
+namespace Profiler {
+
+    AllocationStats threadAllocations() {
+        return {};
+    }
+
+}
+
+#endif
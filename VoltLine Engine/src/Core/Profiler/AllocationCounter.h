@@ -0,0 +1,30 @@
+#pragma once
+
+#include "pch.h"
+
+// ----- Allocation counting ----- //
+//
+// Builds with VOLT_COUNT_ALLOCATIONS=1 (Debug) replace the global operator
+// new/delete (AllocationCounter.cpp) to count heap allocations per thread, a
+// thread-local increment per allocation; headless runs and the frame profiler use
+// it to report allocations per frame. Otherwise the allocator is left alone and
+// the counts stay zero.
+
+#ifndef VOLT_COUNT_ALLOCATIONS
+#define VOLT_COUNT_ALLOCATIONS 0
+#endif
+
+namespace Profiler {
+
+    inline constexpr bool AllocationCountingEnabled = VOLT_COUNT_ALLOCATIONS != 0;
+
+    struct AllocationStats {
+        uint64_t count = 0;
+        uint64_t bytes = 0;
+    };
+
+    // Allocations made through operator new by the calling thread since it started.
+    // Always zero unless AllocationCountingEnabled.
+    AllocationStats threadAllocations();
+
+}
@@ -0,0 +1,150 @@
+#include "Profiler.h"
+
+#include <iomanip>
+
+namespace Profiler {
+
+    Session& Session::get() {
+        static Session session;
+        return session;
+    }
+
+    Session::~Session() {
+        // exit() is used to quit the hub, so this is where most sessions get flushed.
+        end();
+    }
+
+    void Session::begin(const string& name, const string& outputPath) {
+        if (isActive())
+            end();
+
+        std::lock_guard<std::mutex> lock(registryMutex);
+
+        for (auto& buffer : threadBuffers) {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            buffer->events.clear();
+            buffer->dropped = 0;
+        }
+
+        sessionName = name;
+        this->outputPath = outputPath;
+        origin = std::chrono::steady_clock::now();
+        active.store(true, std::memory_order_release);
+    }
+
+    void Session::end() {
+        if (!active.exchange(false, std::memory_order_acq_rel))
+            return;
+
+        writeTrace();
+    }
+
+    ThreadBuffer& Session::currentThreadBuffer() {
+        // The session shares ownership so events survive the thread that recorded them.
+        thread_local std::shared_ptr<ThreadBuffer> buffer;
+
+        if (!buffer) {
+            buffer = std::make_shared<ThreadBuffer>();
+            buffer->events.reserve(4096);
+
+            std::lock_guard<std::mutex> lock(registryMutex);
+            buffer->threadId = nextThreadId++;
+            threadBuffers.push_back(buffer);
+        }
+
+        return *buffer;
+    }
+
+    void Session::record(const char* name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point finish) {
+        if (!isActive())
+            return;
+
+        ThreadBuffer& buffer = currentThreadBuffer();
+
+        // Only contended while a trace is being written.
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+
+        if (buffer.events.size() >= MaxEventsPerThread) {
+            ++buffer.dropped;
+            return;
+        }
+
+        buffer.events.push_back({
+            name,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(start - origin).count(),
+            std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start).count()
+        });
+    }
+
+    void Session::setThreadName(const string& name) {
+        ThreadBuffer& buffer = currentThreadBuffer();
+
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        buffer.threadName = name;
+    }
+
+    static void writeEscaped(std::ostream& out, std::string_view text) {
+        for (char c : text) {
+            switch (c) {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\t': out << "\\t"; break;
+            default: out << c; break;
+            }
+        }
+    }
+
+    void Session::writeTrace() {
+        std::ofstream out(outputPath, std::ios::out | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Profiler: could not open trace file " << outputPath << std::endl;
+            return;
+        }
+
+        // Microseconds with nanosecond precision.
+        out << std::fixed << std::setprecision(3);
+
+        std::lock_guard<std::mutex> lock(registryMutex);
+
+        out << "{\"otherData\":{\"session\":\"";
+        writeEscaped(out, sessionName);
+        out << "\"},\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        bool first = true;
+        auto separator = [&]() {
+            if (!first)
+                out << ',';
+            first = false;
+        };
+
+        for (auto& buffer : threadBuffers) {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+
+            if (!buffer->threadName.empty()) {
+                separator();
+                out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->threadId << ",\"args\":{\"name\":\"";
+                writeEscaped(out, buffer->threadName);
+                out << "\"}}";
+            }
+
+            for (const TraceEvent& event : buffer->events) {
+                separator();
+                out << "{\"name\":\"";
+                writeEscaped(out, event.name);
+                out << "\",\"cat\":\"hub\",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->threadId
+                    << ",\"ts\":" << event.startNs / 1000.0
+                    << ",\"dur\":" << event.durationNs / 1000.0 << '}';
+            }
+
+            if (buffer->dropped > 0)
+                std::cerr << "Profiler: dropped " << buffer->dropped << " events on thread " << buffer->threadId << std::endl;
+
+            buffer->events.clear();
+            buffer->dropped = 0;
+        }
+
+        out << "]}\n";
+    }
+
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "pch.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+// ----- Scoped profiling ----- //
+//
+// VOLT_PROFILE_SCOPE("name") records how long the enclosing scope took into a buffer
+// owned by the calling thread. Nothing is recorded unless a session is running, and
+// when VOLT_PROFILE is not defined to 1 the macros compile to nothing at all.
+// Sessions are written out as Chrome trace-event JSON (chrome://tracing, ui.perfetto.dev).
+//
+// Names must be string literals (or otherwise outlive the session): only the pointer is stored.
+
+namespace Profiler {
+
+    struct TraceEvent {
+        const char* name;
+        int64_t startNs;
+        int64_t durationNs;
+    };
+
+    struct ThreadBuffer {
+        std::mutex mutex;
+        std::vector<TraceEvent> events;
+        string threadName;
+        uint32_t threadId = 0;
+        uint64_t dropped = 0;
+    };
+
+    class Session {
+    public:
+        static Session& get();
+
+        ~Session();
+
+        // Starts recording; the trace is written to outputPath when the session ends.
+        void begin(const string& name, const string& outputPath);
+        void end();
+
+        bool isActive() const { return active.load(std::memory_order_relaxed); }
+
+        void record(const char* name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point finish);
+        void setThreadName(const string& name);
+
+    private:
+        std::atomic<bool> active{ false };
+        std::mutex registryMutex;
+        std::vector<std::shared_ptr<ThreadBuffer>> threadBuffers;
+        uint32_t nextThreadId = 1;
+
+        string sessionName;
+        string outputPath;
+        std::chrono::steady_clock::time_point origin;
+
+        // Per-thread cap so a forgotten session can't eat all memory.
+        static constexpr size_t MaxEventsPerThread = 1 << 20;
+
+        ThreadBuffer& currentThreadBuffer();
+        void writeTrace();
+    };
+
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(const char* name)
+            : name(name), recording(Session::get().isActive()) {
+            if (recording)
+                start = std::chrono::steady_clock::now();
+        }
+
+        ~ScopedTimer() {
+            if (recording)
+                Session::get().record(name, start, std::chrono::steady_clock::now());
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        const char* name;
+        bool recording;
+        std::chrono::steady_clock::time_point start;
+    };
+
+}
+
+#ifndef VOLT_PROFILE
+#define VOLT_PROFILE 0
+#endif
+
+#if VOLT_PROFILE
+    #define VOLT_PROFILE_CONCAT_INNER(a, b) a##b
+    #define VOLT_PROFILE_CONCAT(a, b) VOLT_PROFILE_CONCAT_INNER(a, b)
+
+    #if defined(_MSC_VER)
+        #define VOLT_PROFILE_FUNC_SIG __FUNCSIG__
+    #else
+        #define VOLT_PROFILE_FUNC_SIG __PRETTY_FUNCTION__
+    #endif
+
+    #define VOLT_PROFILE_BEGIN_SESSION(name, outputPath) ::Profiler::Session::get().begin(name, outputPath)
+    #define VOLT_PROFILE_END_SESSION() ::Profiler::Session::get().end()
+    #define VOLT_PROFILE_SCOPE(name) ::Profiler::ScopedTimer VOLT_PROFILE_CONCAT(voltProfileScope, __LINE__)(name)
+    #define VOLT_PROFILE_FUNCTION() VOLT_PROFILE_SCOPE(VOLT_PROFILE_FUNC_SIG)
+    #define VOLT_PROFILE_THREAD(name) ::Profiler::Session::get().setThreadName(name)
+#else
+    #define VOLT_PROFILE_BEGIN_SESSION(name, outputPath) ((void)0)
+    #define VOLT_PROFILE_END_SESSION() ((void)0)
+    #define VOLT_PROFILE_SCOPE(name) ((void)0)
+    #define VOLT_PROFILE_FUNCTION() ((void)0)
+    #define VOLT_PROFILE_THREAD(name) ((void)0)
+#endif
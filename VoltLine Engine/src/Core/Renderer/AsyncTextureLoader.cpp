@@ -0,0 +1,237 @@
+#include "AsyncTextureLoader.h"
+
+#include <algorithm>
+
+#include "Core/FileSystem/VirtualFileSystem.h"
+#include "Core/Profiler/Profiler.h"
+#include "Core/Logging/HubLogger.h"
+
+namespace Renderer {
+
+    AsyncTextureLoader::~AsyncTextureLoader() {
+        // Decodes that haven't started yet return right away; wait for the rest.
+        stopping.store(true);
+        EngineManager::jobSystem().wait(decodeJobs);
+    }
+
+    TextureHandle AsyncTextureLoader::request(const string& filePath, bool generateMipmaps) {
+        return enqueue(filePath, generateMipmaps, false);
+    }
+
+    TextureHandle AsyncTextureLoader::requestAtlased(const string& filePath) {
+        return enqueue(filePath, true, true);
+    }
+
+    TextureHandle AsyncTextureLoader::enqueue(const string& filePath, bool generateMipmaps, bool atlased) {
+        TextureHandle handle = static_cast<TextureHandle>(slots.size());
+
+        TextureSlot& slot = slots.emplace_back();
+        slot.filePath = filePath;
+        slot.generateMipmaps = generateMipmaps;
+        slot.atlased = atlased;
+        ++pendingCount;
+
+        EngineManager::jobSystem().run([this, handle, filePath]() { decode(handle, filePath); }, &decodeJobs);
+
+        return handle;
+    }
+
+    void AsyncTextureLoader::decode(TextureHandle handle, const string& filePath) {
+        if (stopping.load())
+            return;
+
+        // Pack entries decode straight out of the mapping; loose files are mapped too.
+        DecodedImage image;
+        if (std::optional<FileSystem::AssetData> encoded = FileSystem::vfs().read(filePath))
+            image = decodeImage(encoded->bytes());
+        else
+            image.error = std::format("could not read {}", filePath);
+
+        {
+            std::lock_guard<std::mutex> lock(resultMutex);
+            decodedResults.push_back({ handle, std::move(image) });
+        }
+
+        if (onDecoded)
+            onDecoded();
+    }
+
+    void AsyncTextureLoader::createPlaceholder() {
+        // 2x2 neutral grey, matches the hub's button colour.
+        const unsigned char pixels[2 * 2 * 4] = {
+            77, 77, 77, 255,   77, 77, 77, 255,
+            77, 77, 77, 255,   77, 77, 77, 255,
+        };
+
+        glGenTextures(1, &placeholderTexture);
+        glBindTexture(GL_TEXTURE_2D, placeholderTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 2, 2, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    void AsyncTextureLoader::processUploads(size_t uploadBudgetBytes) {
+        if (placeholderTexture == 0)
+            createPlaceholder();
+
+        {
+            std::lock_guard<std::mutex> lock(resultMutex);
+            for (DecodeResult& result : decodedResults)
+                uploadBacklog.push_back(std::move(result));
+            decodedResults.clear();
+        }
+
+        if (uploadBacklog.empty())
+            return;
+
+        VOLT_PROFILE_SCOPE("AsyncTextureLoader::processUploads");
+
+        size_t uploaded = 0;
+        size_t consumed = 0;
+
+        for (; consumed < uploadBacklog.size(); ++consumed) {
+            DecodeResult& result = uploadBacklog[consumed];
+            size_t bytes = result.image.pixels.size();
+
+            if (consumed > 0 && uploaded + bytes > uploadBudgetBytes)
+                break;
+
+            TextureSlot& slot = slots[result.handle];
+            --pendingCount;
+
+            if (!result.image.valid()) {
+                slot.failed = true;
+                cf_Sink::logger->error(std::format("Failed to load texture: {} ({})", slot.filePath, result.image.error));
+                continue;
+            }
+
+            upload(slot, result.image);
+            uploaded += bytes;
+        }
+
+        uploadBacklog.erase(uploadBacklog.begin(), uploadBacklog.begin() + consumed);
+
+        atlas.finalizeUploads();
+
+        if (pendingCount == 0) {
+            AtlasMemoryStats stats = atlas.getMemoryStats();
+            if (stats.pageCount > 0)
+                cf_Sink::logger->info(std::format("Texture atlas: {} page(s), {:.1f} MiB, {:.0f}% occupied", stats.pageCount, stats.textureBytes / (1024.0 * 1024.0), stats.occupancy() * 100.0f));
+        }
+    }
+
+    void AsyncTextureLoader::upload(TextureSlot& slot, const DecodedImage& image) {
+        VOLT_PROFILE_SCOPE("AsyncTextureLoader::upload");
+
+        size_t size = image.pixels.size();
+
+        if (uploadBuffer == 0)
+            glGenBuffers(1, &uploadBuffer);
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, uploadBuffer);
+
+        // Orphan the previous storage so we never wait on a transfer still in flight.
+        if (size > uploadBufferSize)
+            uploadBufferSize = size;
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, uploadBufferSize, nullptr, GL_STREAM_DRAW);
+
+        void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        if (mapped) {
+            std::memcpy(mapped, image.pixels.data(), size);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        }
+        else {
+            // Mapping failed: fall back to a plain client-memory upload.
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+
+        // With a PBO bound, the pixel pointer is an offset into the buffer.
+        const unsigned char* source = mapped ? nullptr : image.pixels.data();
+
+        if (slot.atlased && atlas.fits(image.width, image.height)) {
+            atlas.add(source, image.width, image.height, slot.region);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+            slot.width = image.width;
+            slot.height = image.height;
+            slot.ready = true;
+            return;
+        }
+
+        slot.atlased = false;
+
+        glGenTextures(1, &slot.texture);
+        glBindTexture(GL_TEXTURE_2D, slot.texture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, image.width, image.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, source);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        if (slot.generateMipmaps)
+            glGenerateMipmap(GL_TEXTURE_2D);
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, slot.generateMipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        slot.width = image.width;
+        slot.height = image.height;
+        slot.ready = true;
+    }
+
+    bool AsyncTextureLoader::isReady(TextureHandle handle) const {
+        return handle < slots.size() && slots[handle].ready;
+    }
+
+    GLuint AsyncTextureLoader::getTexture(TextureHandle handle) const {
+        if (handle < slots.size() && slots[handle].ready)
+            return slots[handle].atlased ? atlas.getTexture(slots[handle].region) : slots[handle].texture;
+
+        return placeholderTexture;
+    }
+
+    TextureView AsyncTextureLoader::getView(TextureHandle handle) const {
+        TextureView view;
+        view.id = getImTextureID(handle);
+
+        if (handle < slots.size() && slots[handle].ready && slots[handle].atlased) {
+            atlas.getUVs(slots[handle].region, view.uv0, view.uv1);
+        }
+
+        return view;
+    }
+
+    int AsyncTextureLoader::getWidth(TextureHandle handle) const {
+        return handle < slots.size() ? slots[handle].width : 0;
+    }
+
+    int AsyncTextureLoader::getHeight(TextureHandle handle) const {
+        return handle < slots.size() ? slots[handle].height : 0;
+    }
+
+    void AsyncTextureLoader::shutdown() {
+        for (TextureSlot& slot : slots) {
+            // Atlas pages are owned by the atlas.
+            if (slot.texture != 0 && !slot.atlased)
+                glDeleteTextures(1, &slot.texture);
+            slot.texture = 0;
+            slot.ready = false;
+        }
+
+        if (placeholderTexture != 0)
+            glDeleteTextures(1, &placeholderTexture);
+        if (uploadBuffer != 0)
+            glDeleteBuffers(1, &uploadBuffer);
+
+        atlas.shutdown();
+
+        placeholderTexture = 0;
+        uploadBuffer = 0;
+        uploadBufferSize = 0;
+    }
+
+}
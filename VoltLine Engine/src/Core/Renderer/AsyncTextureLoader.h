@@ -0,0 +1,110 @@
+#pragma once
+
+#include "pch.h"
+
+#include <atomic>
+#include <mutex>
+
+#include "imgui.h"
+
+#include "Core/Renderer/ImageDecode.h"
+#include "Core/Renderer/TextureAtlas.h"
+#include "Core/Managers/EngineManager/EngineManager.h"
+
+namespace Renderer {
+
+    using TextureHandle = uint32_t;
+    inline constexpr TextureHandle InvalidTexture = UINT32_MAX;
+
+    // What a widget needs to draw an image: the texture and the sub-rectangle to sample.
+    struct TextureView {
+        ImTextureID id = 0;
+        ImVec2 uv0{ 0.0f, 0.0f };
+        ImVec2 uv1{ 1.0f, 1.0f };
+    };
+
+    // Loads textures without blocking the GL thread: files (plain or virtual paths,
+    // read through FileSystem::vfs()) are decoded as jobs on the engine's job
+    // system, then uploaded through a pixel buffer object by processUploads(),
+    // which the main loop calls once per frame. Until a texture has been uploaded
+    // its handle resolves to a small placeholder, so widgets can be drawn right away.
+    class AsyncTextureLoader {
+    public:
+        AsyncTextureLoader() = default;
+        ~AsyncTextureLoader();
+
+        AsyncTextureLoader(const AsyncTextureLoader&) = delete;
+        AsyncTextureLoader& operator=(const AsyncTextureLoader&) = delete;
+
+        // Called from a job whenever a decode finishes; used to wake an idle main loop.
+        void setDecodedCallback(std::function<void()> callback) { onDecoded = std::move(callback); }
+
+        TextureHandle request(const string& filePath, bool generateMipmaps = true);
+
+        // Like request(), but packs the image into a shared atlas page instead of
+        // giving it a texture of its own. Falls back to a standalone texture if the
+        // image is too big for a page.
+        TextureHandle requestAtlased(const string& filePath);
+
+        // GL thread only. Uploads finished decodes, at most uploadBudgetBytes per call
+        // (always at least one texture, so large images can't starve).
+        void processUploads(size_t uploadBudgetBytes = 16 * 1024 * 1024);
+
+        bool isReady(TextureHandle handle) const;
+        bool hasPending() const { return pendingCount > 0; }
+
+        GLuint getTexture(TextureHandle handle) const;
+        ImTextureID getImTextureID(TextureHandle handle) const { return (ImTextureID)(intptr_t)getTexture(handle); }
+        TextureView getView(TextureHandle handle) const;
+
+        AtlasMemoryStats getAtlasMemoryStats() const { return atlas.getMemoryStats(); }
+
+        int getWidth(TextureHandle handle) const;
+        int getHeight(TextureHandle handle) const;
+
+        // GL thread only, while the context is still current.
+        void shutdown();
+
+    private:
+        struct TextureSlot {
+            string filePath;
+            GLuint texture = 0;
+            int width = 0;
+            int height = 0;
+            bool generateMipmaps = true;
+            bool atlased = false;
+            AtlasRegion region;
+            bool ready = false;
+            bool failed = false;
+        };
+
+        struct DecodeResult {
+            TextureHandle handle;
+            DecodedImage image;
+        };
+
+        std::vector<TextureSlot> slots;
+        size_t pendingCount = 0;
+
+        TextureAtlas atlas;
+
+        GLuint placeholderTexture = 0;
+        GLuint uploadBuffer = 0;
+        size_t uploadBufferSize = 0;
+
+        EngineManager::JobCounter decodeJobs;
+        std::atomic<bool> stopping{ false };
+
+        std::mutex resultMutex;
+        std::vector<DecodeResult> decodedResults;
+        std::vector<DecodeResult> uploadBacklog;
+
+        std::function<void()> onDecoded;
+
+        void decode(TextureHandle handle, const string& filePath);
+        void createPlaceholder();
+        TextureHandle enqueue(const string& filePath, bool generateMipmaps, bool atlased);
+        void upload(TextureSlot& slot, const DecodedImage& image);
+    };
+
+}
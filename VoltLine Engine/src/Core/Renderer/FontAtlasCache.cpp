@@ -0,0 +1,251 @@
+#include "FontAtlasCache.h"
+
+#include "Core/Profiler/Profiler.h"
+
+namespace Renderer {
+
+    namespace {
+
+        constexpr uint32_t CacheMagic = 0x43464c56; // "VLFC"
+        constexpr uint32_t CacheVersion = 1;
+
+        struct CachedGlyph {
+            uint32_t codepoint;
+            float advanceX;
+            float x0, y0, x1, y1;
+            float u0, v0, u1, v1;
+        };
+
+        struct FnvHash {
+            uint64_t value = 0xcbf29ce484222325ull;
+
+            void add(const void* data, size_t size) {
+                const unsigned char* bytes = static_cast<const unsigned char*>(data);
+                for (size_t i = 0; i < size; ++i) {
+                    value ^= bytes[i];
+                    value *= 0x100000001b3ull;
+                }
+            }
+
+            template <typename T>
+            void add(const T& value) { add(&value, sizeof(T)); }
+        };
+
+        template <typename T>
+        void writeValue(std::ofstream& out, const T& value) {
+            out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        template <typename T>
+        bool readValue(std::ifstream& in, T& value) {
+            return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+        }
+
+    }
+
+    FontAtlasCache::FontAtlasCache(std::filesystem::path cacheDirectory)
+        : cacheDirectory(std::move(cacheDirectory)) {
+    }
+
+    uint64_t FontAtlasCache::computeKey(std::span<const FontRequest> requests, const ImFontConfig& config) const {
+        FnvHash hash;
+        hash.add(fontData.data(), fontData.size());
+        hash.add(CacheVersion);
+        hash.add(static_cast<uint32_t>(IMGUI_VERSION_NUM));
+        hash.add(config.OversampleH);
+        hash.add(config.OversampleV);
+        hash.add(config.PixelSnapH);
+
+        for (const FontRequest& request : requests) {
+            hash.add(request.sizePixels);
+
+            if (request.glyphRanges) {
+                for (const ImWchar* range = request.glyphRanges; *range; ++range)
+                    hash.add(*range);
+            }
+            hash.add(static_cast<ImWchar>(0));
+        }
+
+        return hash.value;
+    }
+
+    std::filesystem::path FontAtlasCache::cacheFilePath() const {
+        return cacheDirectory / std::format("{:016x}.vlfc", cacheKey);
+    }
+
+    bool FontAtlasCache::load(ImFontAtlas* atlas, FileSystem::AssetData font, std::span<const FontRequest> requests) {
+        VOLT_PROFILE_SCOPE("FontAtlasCache::load");
+
+        if (font.size() == 0)
+            return false;
+
+        fontData = std::move(font);
+
+        // The hub's fonts are plain UI text at fixed sizes: 1x oversampling and pixel
+        // snapping keep glyphs crisp and halve the atlas compared to the defaults.
+        ImFontConfig config;
+        config.FontDataOwnedByAtlas = false;
+        config.OversampleH = 1;
+        config.OversampleV = 1;
+        config.PixelSnapH = true;
+
+        // ImGui takes a non-const pointer, but only reads the data when it doesn't own it.
+        void* ttf = const_cast<uint8_t*>(fontData.data());
+        for (const FontRequest& request : requests) {
+            *request.target = atlas->AddFontFromMemoryTTF(ttf, static_cast<int>(fontData.size()), request.sizePixels, &config, request.glyphRanges);
+        }
+
+        cacheKey = computeKey(requests, config);
+        cacheHit = restore(atlas);
+
+        if (!cacheHit) {
+            VOLT_PROFILE_SCOPE("FontAtlasCache::bake");
+
+            atlas->Build();
+            store(atlas);
+        }
+
+        return true;
+    }
+
+    bool FontAtlasCache::restore(ImFontAtlas* atlas) {
+        VOLT_PROFILE_SCOPE("FontAtlasCache::restore");
+
+        std::ifstream in(cacheFilePath(), std::ios::in | std::ios::binary);
+        if (!in.is_open())
+            return false;
+
+        uint32_t magic = 0, version = 0;
+        uint64_t key = 0;
+        int32_t width = 0, height = 0;
+        ImVec2 whitePixel, uvScale;
+        uint32_t lineCount = 0, fontCount = 0;
+
+        if (!readValue(in, magic) || magic != CacheMagic || !readValue(in, version) || version != CacheVersion)
+            return false;
+        if (!readValue(in, key) || key != cacheKey)
+            return false;
+        if (!readValue(in, width) || !readValue(in, height) || width <= 0 || height <= 0)
+            return false;
+        if (!readValue(in, whitePixel) || !readValue(in, uvScale))
+            return false;
+
+        ImVec4 lines[IM_ARRAYSIZE(atlas->TexUvLines)];
+        if (!readValue(in, lineCount) || lineCount != IM_ARRAYSIZE(atlas->TexUvLines))
+            return false;
+        if (!in.read(reinterpret_cast<char*>(lines), sizeof(lines)))
+            return false;
+
+        if (!readValue(in, fontCount) || fontCount != static_cast<uint32_t>(atlas->Fonts.Size))
+            return false;
+
+        struct CachedFont {
+            float fontSize, ascent, descent;
+            std::vector<CachedGlyph> glyphs;
+        };
+
+        std::vector<CachedFont> fonts(fontCount);
+        for (CachedFont& font : fonts) {
+            uint32_t glyphCount = 0;
+            if (!readValue(in, font.fontSize) || !readValue(in, font.ascent) || !readValue(in, font.descent) || !readValue(in, glyphCount))
+                return false;
+
+            font.glyphs.resize(glyphCount);
+            if (!in.read(reinterpret_cast<char*>(font.glyphs.data()), glyphCount * sizeof(CachedGlyph)))
+                return false;
+        }
+
+        size_t pixelCount = static_cast<size_t>(width) * height;
+        unsigned char* pixels = static_cast<unsigned char*>(IM_ALLOC(pixelCount));
+        if (!in.read(reinterpret_cast<char*>(pixels), pixelCount)) {
+            IM_FREE(pixels);
+            return false;
+        }
+
+        // Everything validated: install the baked atlas in place of ImFontAtlas::Build().
+        atlas->ClearTexData();
+        atlas->TexPixelsAlpha8 = pixels;
+        atlas->TexWidth = width;
+        atlas->TexHeight = height;
+        atlas->TexUvScale = uvScale;
+        atlas->TexUvWhitePixel = whitePixel;
+        std::copy(std::begin(lines), std::end(lines), std::begin(atlas->TexUvLines));
+
+        for (uint32_t i = 0; i < fontCount; ++i) {
+            ImFont* font = atlas->Fonts[i];
+            const CachedFont& cached = fonts[i];
+
+            font->ClearOutputData();
+            font->ContainerAtlas = atlas;
+            font->ConfigData = &atlas->ConfigData[i];
+            font->ConfigDataCount = 1;
+            font->FontSize = cached.fontSize;
+            font->Ascent = cached.ascent;
+            font->Descent = cached.descent;
+
+            // The stored glyphs already include the config's offsets/spacing, so add them without a config.
+            for (const CachedGlyph& glyph : cached.glyphs)
+                font->AddGlyph(nullptr, static_cast<ImWchar>(glyph.codepoint), glyph.x0, glyph.y0, glyph.x1, glyph.y1, glyph.u0, glyph.v0, glyph.u1, glyph.v1, glyph.advanceX);
+
+            font->BuildLookupTable();
+        }
+
+        atlas->TexReady = true;
+        return true;
+    }
+
+    void FontAtlasCache::store(const ImFontAtlas* atlas) const {
+        VOLT_PROFILE_SCOPE("FontAtlasCache::store");
+
+        if (!atlas->TexPixelsAlpha8)
+            return;
+
+        std::error_code ec;
+        std::filesystem::create_directories(cacheDirectory, ec);
+
+        // Write to a temp file first so a crash never leaves a truncated cache behind.
+        std::filesystem::path finalPath = cacheFilePath();
+        std::filesystem::path tempPath = finalPath;
+        tempPath += ".tmp";
+
+        {
+            std::ofstream out(tempPath, std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!out.is_open())
+                return;
+
+            writeValue(out, CacheMagic);
+            writeValue(out, CacheVersion);
+            writeValue(out, cacheKey);
+            writeValue(out, static_cast<int32_t>(atlas->TexWidth));
+            writeValue(out, static_cast<int32_t>(atlas->TexHeight));
+            writeValue(out, atlas->TexUvWhitePixel);
+            writeValue(out, atlas->TexUvScale);
+
+            writeValue(out, static_cast<uint32_t>(IM_ARRAYSIZE(atlas->TexUvLines)));
+            out.write(reinterpret_cast<const char*>(atlas->TexUvLines), sizeof(atlas->TexUvLines));
+
+            writeValue(out, static_cast<uint32_t>(atlas->Fonts.Size));
+            for (const ImFont* font : atlas->Fonts) {
+                writeValue(out, font->FontSize);
+                writeValue(out, font->Ascent);
+                writeValue(out, font->Descent);
+                writeValue(out, static_cast<uint32_t>(font->Glyphs.Size));
+
+                for (const ImFontGlyph& glyph : font->Glyphs) {
+                    CachedGlyph cached{ glyph.Codepoint, glyph.AdvanceX, glyph.X0, glyph.Y0, glyph.X1, glyph.Y1, glyph.U0, glyph.V0, glyph.U1, glyph.V1 };
+                    writeValue(out, cached);
+                }
+            }
+
+            out.write(reinterpret_cast<const char*>(atlas->TexPixelsAlpha8), static_cast<std::streamsize>(atlas->TexWidth) * atlas->TexHeight);
+
+            if (!out)
+                return;
+        }
+
+        std::filesystem::rename(tempPath, finalPath, ec);
+        if (ec)
+            std::filesystem::remove(tempPath, ec);
+    }
+
+}
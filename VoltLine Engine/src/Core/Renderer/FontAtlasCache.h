@@ -0,0 +1,50 @@
+#pragma once
+
+#include "pch.h"
+
+#include <span>
+
+#include "imgui.h"
+
+#include "Core/FileSystem/AssetPack.h"
+
+namespace Renderer {
+
+    struct FontRequest {
+        float sizePixels;
+        ImFont** target;
+        const ImWchar* glyphRanges = nullptr; // nullptr = ImGui's default Latin ranges
+    };
+
+    // Builds the hub's font atlas from a single TTF. The font bytes are used where
+    // they already are (a mapped file or pack entry, see FileSystem::vfs().read) and
+    // shared by every size, and the baked atlas (alpha8 pixels + glyph tables) is
+    // stored on disk, keyed by a hash of the font bytes, sizes, glyph ranges and
+    // ImGui version. Warm launches restore the atlas from that file instead of
+    // rasterizing anything.
+    //
+    // Must outlive the ImFontAtlas it fills: the atlas references fontData directly.
+    // So must the pack, if fontData is a view into one.
+    class FontAtlasCache {
+    public:
+        explicit FontAtlasCache(std::filesystem::path cacheDirectory = "cache/fonts");
+
+        bool load(ImFontAtlas* atlas, FileSystem::AssetData font, std::span<const FontRequest> requests);
+
+        bool wasCacheHit() const { return cacheHit; }
+        uint64_t getCacheKey() const { return cacheKey; }
+
+    private:
+        std::filesystem::path cacheDirectory;
+        FileSystem::AssetData fontData;
+        uint64_t cacheKey = 0;
+        bool cacheHit = false;
+
+        uint64_t computeKey(std::span<const FontRequest> requests, const ImFontConfig& config) const;
+        std::filesystem::path cacheFilePath() const;
+
+        bool restore(ImFontAtlas* atlas);
+        void store(const ImFontAtlas* atlas) const;
+    };
+
+}
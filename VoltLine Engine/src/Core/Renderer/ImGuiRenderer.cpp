@@ -0,0 +1,434 @@
+#include "ImGuiRenderer.h"
+
+#include <bit>
+
+#include "Core/Profiler/Profiler.h"
+#include "Core/Logging/HubLogger.h"
+
+// GL 4.4 names, in case the glad build predates them.
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+
+namespace Renderer {
+
+    namespace {
+
+        // Loaded by hand so the backend doesn't depend on glad being generated for 4.4.
+        using BufferStorageProc = void (APIENTRY*)(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+        BufferStorageProc bufferStorage = nullptr;
+
+        constexpr GLbitfield StorageFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        // Enough for the hub's busiest screens; larger frames grow the rings.
+        constexpr size_t InitialVertexCapacity = 32 * 1024;
+        constexpr size_t InitialIndexCapacity = 64 * 1024;
+
+        const char* const VertexShader = R"(#version 420 core
+layout(location = 0) in vec2 Position;
+layout(location = 1) in vec2 UV;
+layout(location = 2) in vec4 Color;
+uniform mat4 ProjMtx;
+out vec2 Frag_UV;
+out vec4 Frag_Color;
+void main() {
+    Frag_UV = UV;
+    Frag_Color = Color;
+    gl_Position = ProjMtx * vec4(Position, 0.0, 1.0);
+}
+)";
+
+        const char* const FragmentShader = R"(#version 420 core
+layout(binding = 0) uniform sampler2D Texture;
+in vec2 Frag_UV;
+in vec4 Frag_Color;
+layout(location = 0) out vec4 Out_Color;
+void main() {
+    Out_Color = Frag_Color * texture(Texture, Frag_UV);
+}
+)";
+
+        GLuint compileShader(GLenum type, const char* source, string& error) {
+            GLuint shader = glCreateShader(type);
+            glShaderSource(shader, 1, &source, nullptr);
+            glCompileShader(shader);
+
+            GLint status = GL_FALSE;
+            glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+            if (status == GL_TRUE)
+                return shader;
+
+            char log[512] = {};
+            glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+            error = std::format("{} shader: {}", type == GL_VERTEX_SHADER ? "vertex" : "fragment", log);
+            glDeleteShader(shader);
+            return 0;
+        }
+
+        using ScissorRect = std::array<GLint, 4>;
+
+        // ImGui clip rectangle -> glScissor arguments; false if nothing of it is visible.
+        bool scissorFor(const ImDrawCmd& command, const ImDrawData* drawData, int framebufferHeight, ScissorRect& out) {
+            ImVec2 offset = drawData->DisplayPos;
+            ImVec2 scale = drawData->FramebufferScale;
+
+            float minX = (command.ClipRect.x - offset.x) * scale.x;
+            float minY = (command.ClipRect.y - offset.y) * scale.y;
+            float maxX = (command.ClipRect.z - offset.x) * scale.x;
+            float maxY = (command.ClipRect.w - offset.y) * scale.y;
+            if (maxX <= minX || maxY <= minY)
+                return false;
+
+            out = { static_cast<GLint>(minX), static_cast<GLint>(framebufferHeight - maxY), static_cast<GLint>(maxX - minX), static_cast<GLint>(maxY - minY) };
+            return true;
+        }
+
+    }
+
+    UiRenderStats describeStockRender(const ImDrawData* drawData) {
+        UiRenderStats stats;
+        int framebufferHeight = static_cast<int>(drawData->DisplaySize.y * drawData->FramebufferScale.y);
+
+        for (const ImDrawList* list : drawData->CmdLists) {
+            stats.uploadBytes += list->VtxBuffer.Size * sizeof(ImDrawVert) + list->IdxBuffer.Size * sizeof(ImDrawIdx);
+
+            for (const ImDrawCmd& command : list->CmdBuffer) {
+                ScissorRect scissor;
+                if (command.UserCallback || !scissorFor(command, drawData, framebufferHeight, scissor))
+                    continue;
+
+                ++stats.commands;
+                ++stats.drawCalls;
+                ++stats.textureBinds;
+                ++stats.scissorChanges;
+            }
+        }
+        return stats;
+    }
+
+    ImGuiRenderer::~ImGuiRenderer() {
+        shutdown();
+    }
+
+    bool ImGuiRenderer::init(string& error) {
+        VOLT_PROFILE_SCOPE("ImGuiRenderer::init");
+
+        GLint major = 0, minor = 0;
+        glGetIntegerv(GL_MAJOR_VERSION, &major);
+        glGetIntegerv(GL_MINOR_VERSION, &minor);
+
+        bool hasStorage = major > 4 || (major == 4 && minor >= 4) || glfwExtensionSupported("GL_ARB_buffer_storage");
+        bufferStorage = hasStorage ? reinterpret_cast<BufferStorageProc>(glfwGetProcAddress("glBufferStorage")) : nullptr;
+        if (!bufferStorage) {
+            error = std::format("OpenGL {}.{} has no glBufferStorage", major, minor);
+            return false;
+        }
+
+        GLuint vertexShader = compileShader(GL_VERTEX_SHADER, VertexShader, error);
+        GLuint fragmentShader = vertexShader ? compileShader(GL_FRAGMENT_SHADER, FragmentShader, error) : 0;
+        if (!fragmentShader) {
+            glDeleteShader(vertexShader);
+            return false;
+        }
+
+        program = glCreateProgram();
+        glAttachShader(program, vertexShader);
+        glAttachShader(program, fragmentShader);
+        glLinkProgram(program);
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+
+        GLint linked = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (linked != GL_TRUE) {
+            char log[512] = {};
+            glGetProgramInfoLog(program, sizeof(log), nullptr, log);
+            error = std::format("shader link: {}", log);
+            shutdown();
+            return false;
+        }
+        projectionLocation = glGetUniformLocation(program, "ProjMtx");
+
+        glGenVertexArrays(1, &vertexArray);
+        if (!createBuffers(InitialVertexCapacity, InitialIndexCapacity, error)) {
+            shutdown();
+            return false;
+        }
+
+        ImGuiIO& io = ImGui::GetIO();
+
+        unsigned char* pixels = nullptr;
+        int width = 0, height = 0;
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+        glGenTextures(1, &fontTexture);
+        glBindTexture(GL_TEXTURE_2D, fontTexture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        io.Fonts->SetTexID((ImTextureID)(intptr_t)fontTexture);
+
+        io.BackendRendererName = "voltline_gl4_streaming";
+        // Commands may use VtxOffset: indices are rebased on upload anyway.
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+
+        initialized = true;
+        return true;
+    }
+
+    void ImGuiRenderer::shutdown() {
+        // Nothing to release once the context is gone (glfwTerminate took it with it).
+        if (!glfwGetCurrentContext())
+            return;
+
+        destroyBuffers();
+
+        if (vertexArray)
+            glDeleteVertexArrays(1, &vertexArray);
+        if (program)
+            glDeleteProgram(program);
+        if (fontTexture)
+            glDeleteTextures(1, &fontTexture);
+        vertexArray = 0;
+        program = 0;
+        fontTexture = 0;
+
+        if (initialized && ImGui::GetCurrentContext()) {
+            ImGuiIO& io = ImGui::GetIO();
+            io.Fonts->SetTexID(0);
+            io.BackendRendererName = nullptr;
+            io.BackendFlags &= ~ImGuiBackendFlags_RendererHasVtxOffset;
+        }
+        initialized = false;
+    }
+
+    bool ImGuiRenderer::createBuffers(size_t vertexCapacity, size_t indexCapacity, string& error) {
+        destroyBuffers();
+
+        auto create = [&](Ring& ring, GLenum target, size_t capacity, size_t elementSize) {
+            ring.capacity = capacity;
+            size_t bytes = capacity * elementSize * FrameCount;
+
+            glGenBuffers(1, &ring.buffer);
+            glBindBuffer(target, ring.buffer);
+            bufferStorage(target, static_cast<GLsizeiptr>(bytes), nullptr, StorageFlags);
+            ring.mapped = static_cast<uint8_t*>(glMapBufferRange(target, 0, static_cast<GLsizeiptr>(bytes), StorageFlags));
+            return ring.mapped != nullptr;
+        };
+
+        // The element buffer binding is VAO state, so it is made with the VAO bound.
+        glBindVertexArray(vertexArray);
+        bool mapped = create(vertices, GL_ARRAY_BUFFER, vertexCapacity, sizeof(ImDrawVert))
+            && create(indices, GL_ELEMENT_ARRAY_BUFFER, indexCapacity, sizeof(uint32_t));
+
+        if (mapped) {
+            // Attributes point at the start of the buffer; regions are selected with the base vertex.
+            glEnableVertexAttribArray(0);
+            glEnableVertexAttribArray(1);
+            glEnableVertexAttribArray(2);
+            glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), reinterpret_cast<void*>(offsetof(ImDrawVert, pos)));
+            glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), reinterpret_cast<void*>(offsetof(ImDrawVert, uv)));
+            glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), reinterpret_cast<void*>(offsetof(ImDrawVert, col)));
+        }
+
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        if (!mapped) {
+            error = "could not map the streaming buffers";
+            destroyBuffers();
+            return false;
+        }
+
+        region = 0;
+        return true;
+    }
+
+    void ImGuiRenderer::destroyBuffers() {
+        // Deleting a buffer unmaps it, but the GPU may still be reading it.
+        for (int i = 0; i < FrameCount; ++i)
+            waitForRegion(i);
+
+        for (Ring* ring : { &vertices, &indices }) {
+            if (ring->buffer)
+                glDeleteBuffers(1, &ring->buffer);
+            *ring = Ring{};
+        }
+    }
+
+    void ImGuiRenderer::waitForRegion(int index) {
+        GLsync& fence = fences[index];
+        if (!fence)
+            return;
+
+        if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED) {
+            VOLT_PROFILE_SCOPE("ImGuiRenderer::waitForGpu");
+            ++fenceWaits;
+            while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000) == GL_TIMEOUT_EXPIRED) {
+            }
+        }
+
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    void ImGuiRenderer::setupState(const ImDrawData* drawData, int framebufferWidth, int framebufferHeight) {
+        glEnable(GL_BLEND);
+        glBlendEquation(GL_FUNC_ADD);
+        glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        glDisable(GL_CULL_FACE);
+        glDisable(GL_DEPTH_TEST);
+        glDisable(GL_STENCIL_TEST);
+        glEnable(GL_SCISSOR_TEST);
+        glViewport(0, 0, framebufferWidth, framebufferHeight);
+
+        float left = drawData->DisplayPos.x;
+        float right = drawData->DisplayPos.x + drawData->DisplaySize.x;
+        float top = drawData->DisplayPos.y;
+        float bottom = drawData->DisplayPos.y + drawData->DisplaySize.y;
+        const float projection[16] = {
+            2.0f / (right - left), 0.0f, 0.0f, 0.0f,
+            0.0f, 2.0f / (top - bottom), 0.0f, 0.0f,
+            0.0f, 0.0f, -1.0f, 0.0f,
+            (right + left) / (left - right), (top + bottom) / (bottom - top), 0.0f, 1.0f,
+        };
+
+        glUseProgram(program);
+        glUniformMatrix4fv(projectionLocation, 1, GL_FALSE, projection);
+        glActiveTexture(GL_TEXTURE0);
+        glBindVertexArray(vertexArray);
+    }
+
+    void ImGuiRenderer::render(const ImDrawData* drawData) {
+        VOLT_PROFILE_SCOPE("ImGuiRenderer::render");
+
+        UiRenderStats stats;
+        int framebufferWidth = static_cast<int>(drawData->DisplaySize.x * drawData->FramebufferScale.x);
+        int framebufferHeight = static_cast<int>(drawData->DisplaySize.y * drawData->FramebufferScale.y);
+        if (!initialized || framebufferWidth <= 0 || framebufferHeight <= 0 || drawData->TotalVtxCount == 0) {
+            lastFrame = stats;
+            return;
+        }
+
+        size_t vertexCount = static_cast<size_t>(drawData->TotalVtxCount);
+        size_t indexCount = static_cast<size_t>(drawData->TotalIdxCount);
+        if (vertexCount > vertices.capacity || indexCount > indices.capacity) {
+            string error;
+            if (!createBuffers(std::bit_ceil(std::max(vertexCount, vertices.capacity)), std::bit_ceil(std::max(indexCount, indices.capacity)), error)) {
+                cf_Sink::logger->error(std::format("UI renderer: {}", error));
+                lastFrame = stats;
+                return;
+            }
+        }
+
+        waitForRegion(region);
+
+        ImDrawVert* vertexOut = reinterpret_cast<ImDrawVert*>(vertices.mapped) + region * vertices.capacity;
+        uint32_t* indexOut = reinterpret_cast<uint32_t*>(indices.mapped) + region * indices.capacity;
+        GLint baseVertex = static_cast<GLint>(region * vertices.capacity);
+        size_t indexBase = region * indices.capacity;
+
+        setupState(drawData, framebufferWidth, framebufferHeight);
+
+        struct Batch {
+            GLuint texture = 0;
+            ScissorRect scissor{};
+            uint32_t first = 0;
+            uint32_t count = 0;
+        };
+
+        Batch pending;
+        // Unknown until this frame sets them (a callback may change them behind our back too).
+        GLuint boundTexture = 0;
+        bool textureKnown = false;
+        ScissorRect scissor{ -1, -1, -1, -1 };
+
+        auto flush = [&]() {
+            if (pending.count == 0)
+                return;
+
+            if (!textureKnown || pending.texture != boundTexture) {
+                glBindTexture(GL_TEXTURE_2D, pending.texture);
+                boundTexture = pending.texture;
+                textureKnown = true;
+                ++stats.textureBinds;
+            }
+            if (pending.scissor != scissor) {
+                glScissor(pending.scissor[0], pending.scissor[1], pending.scissor[2], pending.scissor[3]);
+                scissor = pending.scissor;
+                ++stats.scissorChanges;
+            }
+
+            glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(pending.count), GL_UNSIGNED_INT,
+                reinterpret_cast<void*>((indexBase + pending.first) * sizeof(uint32_t)), baseVertex);
+            ++stats.drawCalls;
+            pending.count = 0;
+        };
+
+        uint32_t writtenVertices = 0;
+        uint32_t writtenIndices = 0;
+
+        for (const ImDrawList* list : drawData->CmdLists) {
+            std::memcpy(vertexOut + writtenVertices, list->VtxBuffer.Data, list->VtxBuffer.Size * sizeof(ImDrawVert));
+
+            for (const ImDrawCmd& command : list->CmdBuffer) {
+                if (command.UserCallback) {
+                    flush();
+                    if (command.UserCallback == ImDrawCallback_ResetRenderState)
+                        setupState(drawData, framebufferWidth, framebufferHeight);
+                    else
+                        command.UserCallback(list, &command);
+
+                    textureKnown = false;
+                    scissor = { -1, -1, -1, -1 };
+                    continue;
+                }
+
+                ScissorRect commandScissor;
+                if (!scissorFor(command, drawData, framebufferHeight, commandScissor))
+                    continue;
+                ++stats.commands;
+
+                // Only drawn commands are written, so a batch's indices are always contiguous.
+                const ImDrawIdx* source = list->IdxBuffer.Data + command.IdxOffset;
+                uint32_t rebase = writtenVertices + command.VtxOffset;
+                uint32_t* out = indexOut + writtenIndices;
+                for (unsigned int i = 0; i < command.ElemCount; ++i)
+                    out[i] = rebase + source[i];
+
+                GLuint texture = static_cast<GLuint>((intptr_t)command.GetTexID());
+                if (texture != pending.texture || commandScissor != pending.scissor) {
+                    flush();
+                    pending.texture = texture;
+                    pending.scissor = commandScissor;
+                }
+                if (pending.count == 0)
+                    pending.first = writtenIndices;
+
+                pending.count += command.ElemCount;
+                writtenIndices += command.ElemCount;
+            }
+
+            writtenVertices += static_cast<uint32_t>(list->VtxBuffer.Size);
+        }
+        flush();
+
+        fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        region = (region + 1) % FrameCount;
+
+        // The scissor test would clip next frame's glClear.
+        glDisable(GL_SCISSOR_TEST);
+        glBindVertexArray(0);
+
+        stats.uploadBytes = writtenVertices * sizeof(ImDrawVert) + writtenIndices * sizeof(uint32_t);
+        lastFrame = stats;
+    }
+
+}
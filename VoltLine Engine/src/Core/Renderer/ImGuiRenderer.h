@@ -0,0 +1,89 @@
+#pragma once
+
+#include "pch.h"
+
+#include <array>
+
+#include "imgui.h"
+
+namespace Renderer {
+
+    // What drawing one frame of ImGui cost, for comparing UI renderer backends.
+    struct UiRenderStats {
+        int commands = 0;           // draw commands ImGui submitted (callbacks and fully clipped ones excluded)
+        int drawCalls = 0;          // glDraw* calls actually issued
+        int textureBinds = 0;
+        int scissorChanges = 0;
+        size_t uploadBytes = 0;     // vertex and index bytes written for the GPU
+    };
+
+    // What the stock imgui_impl_opengl3 backend does with the same draw data: one
+    // draw, texture bind and scissor per command, 16-bit indices re-specified with
+    // glBufferData per draw list.
+    UiRenderStats describeStockRender(const ImDrawData* drawData);
+
+    // ImGui renderer backend for GL 4.4 (or ARB_buffer_storage), replacing
+    // imgui_impl_opengl3 on the hub's own context.
+    //
+    // Vertices and indices stream through two persistently mapped buffers, split
+    // into FrameCount regions used round robin; a fence per region keeps the CPU
+    // from writing over data the GPU hasn't drawn yet, so nothing is re-specified
+    // and nothing is mapped per frame. Indices are written as 32-bit and rebased
+    // onto the whole frame's vertices, which lets consecutive commands with the
+    // same texture and clip rectangle merge into one draw even across draw lists.
+    // Commands are never reordered: ImGui's order is the blending order.
+    //
+    // GL state is set up once per frame rather than saved and restored around it:
+    // the hub draws nothing else. Afterwards the scissor test (which would clip the
+    // next glClear) is switched off and the VAO unbound; the rest is left as set.
+    class ImGuiRenderer {
+    public:
+        static constexpr int FrameCount = 3;
+
+        ImGuiRenderer() = default;
+        ~ImGuiRenderer();
+
+        ImGuiRenderer(const ImGuiRenderer&) = delete;
+        ImGuiRenderer& operator=(const ImGuiRenderer&) = delete;
+
+        // Needs the GL context current and ImGui's fonts built. Returns false, with
+        // error set and nothing left behind, when the context can't run this backend;
+        // the hub then falls back to imgui_impl_opengl3.
+        bool init(string& error);
+        void shutdown();
+
+        void render(const ImDrawData* drawData);
+
+        const UiRenderStats& getLastFrameStats() const { return lastFrame; }
+        // Times render() had to wait for the GPU to release a region, since init().
+        uint64_t getFenceWaits() const { return fenceWaits; }
+
+    private:
+        // One buffer of FrameCount regions, each holding capacity elements.
+        struct Ring {
+            GLuint buffer = 0;
+            uint8_t* mapped = nullptr;
+            size_t capacity = 0;
+        };
+
+        bool initialized = false;
+        GLuint program = 0;
+        GLint projectionLocation = -1;
+        GLuint vertexArray = 0;
+        GLuint fontTexture = 0;
+
+        Ring vertices;
+        Ring indices;
+        std::array<GLsync, FrameCount> fences{};
+        int region = 0;
+
+        UiRenderStats lastFrame;
+        uint64_t fenceWaits = 0;
+
+        bool createBuffers(size_t vertexCapacity, size_t indexCapacity, string& error);
+        void destroyBuffers();
+        void waitForRegion(int index);
+        void setupState(const ImDrawData* drawData, int framebufferWidth, int framebufferHeight);
+    };
+
+}
@@ -0,0 +1,49 @@
+#include "ImageDecode.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#include "Core/Profiler/Profiler.h"
+
+namespace Renderer {
+
+    namespace {
+
+        DecodedImage takePixels(DecodedImage image, unsigned char* data) {
+            if (!data) {
+                image.error = stbi_failure_reason() ? stbi_failure_reason() : "unknown error";
+                return image;
+            }
+
+            image.pixels.assign(data, data + static_cast<size_t>(image.width) * image.height * 4);
+            stbi_image_free(data);
+
+            return image;
+        }
+
+    }
+
+    DecodedImage decodeImage(const string& filePath) {
+        VOLT_PROFILE_SCOPE("decodeImage");
+
+        DecodedImage image;
+        int channels = 0;
+        unsigned char* data = stbi_load(filePath.c_str(), &image.width, &image.height, &channels, 4);
+        return takePixels(std::move(image), data);
+    }
+
+    DecodedImage decodeImage(std::span<const uint8_t> encoded) {
+        VOLT_PROFILE_SCOPE("decodeImage");
+
+        DecodedImage image;
+        if (encoded.size() > INT_MAX) {
+            image.error = "image is too large";
+            return image;
+        }
+
+        int channels = 0;
+        unsigned char* data = stbi_load_from_memory(encoded.data(), static_cast<int>(encoded.size()), &image.width, &image.height, &channels, 4);
+        return takePixels(std::move(image), data);
+    }
+
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "pch.h"
+
+#include <span>
+
+namespace Renderer {
+
+    struct DecodedImage {
+        std::vector<unsigned char> pixels; // always RGBA8
+        int width = 0;
+        int height = 0;
+        string error;
+
+        bool valid() const { return !pixels.empty(); }
+    };
+
+    // Decodes an image file into RGBA8 pixels. Safe to call from any thread.
+    DecodedImage decodeImage(const string& filePath);
+    // Decodes an encoded image (PNG, JPEG, ...) already in memory, e.g. a pack entry.
+    DecodedImage decodeImage(std::span<const uint8_t> encoded);
+
+}
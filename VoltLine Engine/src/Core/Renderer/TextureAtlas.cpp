@@ -0,0 +1,310 @@
+#include "TextureAtlas.h"
+
+#include <algorithm>
+#include <bit>
+#include <climits>
+
+#include "Core/Profiler/Profiler.h"
+
+namespace Renderer {
+
+    // ----- AtlasPacker ----- //
+
+    AtlasPacker::AtlasPacker(int width, int height)
+        : width(width), height(height) {
+        reset();
+    }
+
+    void AtlasPacker::grow(int newWidth, int newHeight) {
+        if (newWidth > width) {
+            SkylineNode& last = skyline.back();
+            if (last.y == 0)
+                last.width += newWidth - width;
+            else
+                skyline.push_back({ width, 0, newWidth - width });
+        }
+
+        width = std::max(width, newWidth);
+        height = std::max(height, newHeight);
+    }
+
+    void AtlasPacker::reset() {
+        skyline.clear();
+        skyline.push_back({ 0, 0, width });
+        usedArea = 0;
+    }
+
+    int AtlasPacker::fitAt(size_t index, int rectWidth, int rectHeight) const {
+        int x = skyline[index].x;
+        if (x + rectWidth > width)
+            return -1;
+
+        int y = 0;
+        int remaining = rectWidth;
+
+        for (size_t i = index; remaining > 0; ++i) {
+            if (i >= skyline.size())
+                return -1;
+
+            y = std::max(y, skyline[i].y);
+            if (y + rectHeight > height)
+                return -1;
+
+            remaining -= skyline[i].width;
+        }
+
+        return y;
+    }
+
+    bool AtlasPacker::pack(int rectWidth, int rectHeight, AtlasRect& out) {
+        int bestY = INT_MAX;
+        int bestWidth = INT_MAX;
+        size_t bestIndex = SIZE_MAX;
+
+        for (size_t i = 0; i < skyline.size(); ++i) {
+            int y = fitAt(i, rectWidth, rectHeight);
+            if (y < 0)
+                continue;
+
+            // Lowest resulting top edge first, then the tightest segment.
+            if (y + rectHeight < bestY || (y + rectHeight == bestY && skyline[i].width < bestWidth)) {
+                bestY = y + rectHeight;
+                bestWidth = skyline[i].width;
+                bestIndex = i;
+                out = { skyline[i].x, y, rectWidth, rectHeight };
+            }
+        }
+
+        if (bestIndex == SIZE_MAX)
+            return false;
+
+        addLevel(bestIndex, out);
+        usedArea += static_cast<uint64_t>(rectWidth) * rectHeight;
+        return true;
+    }
+
+    void AtlasPacker::addLevel(size_t index, const AtlasRect& rect) {
+        skyline.insert(skyline.begin() + index, { rect.x, rect.y + rect.height, rect.width });
+
+        // Trim or remove the segments now covered by the new one.
+        for (size_t i = index + 1; i < skyline.size();) {
+            const SkylineNode& previous = skyline[i - 1];
+            int previousEnd = previous.x + previous.width;
+
+            if (skyline[i].x >= previousEnd)
+                break;
+
+            int shrink = previousEnd - skyline[i].x;
+            skyline[i].x += shrink;
+            skyline[i].width -= shrink;
+
+            if (skyline[i].width > 0)
+                break;
+
+            skyline.erase(skyline.begin() + i);
+        }
+
+        // Merge neighbours at the same height.
+        for (size_t i = 0; i + 1 < skyline.size();) {
+            if (skyline[i].y == skyline[i + 1].y) {
+                skyline[i].width += skyline[i + 1].width;
+                skyline.erase(skyline.begin() + i + 1);
+            }
+            else {
+                ++i;
+            }
+        }
+    }
+
+    // ----- TextureAtlas ----- //
+
+    TextureAtlas::TextureAtlas(int maxPageSize)
+        : maxPageSize(maxPageSize) {
+    }
+
+    TextureAtlas::~TextureAtlas() {
+        shutdown();
+    }
+
+    bool TextureAtlas::fits(int width, int height) const {
+        return width + Padding * 2 <= maxPageSize && height + Padding * 2 <= maxPageSize;
+    }
+
+    GLuint TextureAtlas::getTexture(const AtlasRegion& region) const {
+        if (region.page < 0 || region.page >= static_cast<int>(pages.size()))
+            return 0;
+
+        return pages[region.page].texture;
+    }
+
+    void TextureAtlas::getUVs(const AtlasRegion& region, ImVec2& uv0, ImVec2& uv1) const {
+        if (region.page < 0 || region.page >= static_cast<int>(pages.size()))
+            return;
+
+        float inverseSize = 1.0f / pages[region.page].size;
+        uv0 = ImVec2(region.rect.x * inverseSize, region.rect.y * inverseSize);
+        uv1 = ImVec2((region.rect.x + region.rect.width) * inverseSize, (region.rect.y + region.rect.height) * inverseSize);
+    }
+
+    size_t TextureAtlas::pageBytes(int size) {
+        size_t bytes = 0;
+        for (int level = 0; level <= MaxMipLevel; ++level, size /= 2)
+            bytes += static_cast<size_t>(size) * size * 4;
+
+        return bytes;
+    }
+
+    GLuint TextureAtlas::createPageTexture(int size) {
+        GLuint texture = 0;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+
+        // Allocate the full mip chain up front, cleared to transparent. The clear data is
+        // client memory, so step out of any upload PBO the caller has bound.
+        GLint boundUnpackBuffer = 0;
+        glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &boundUnpackBuffer);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        std::vector<unsigned char> clear(static_cast<size_t>(size) * size * 4, 0);
+        for (int level = 0, levelSize = size; level <= MaxMipLevel; ++level, levelSize /= 2)
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, levelSize, levelSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, clear.data());
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, boundUnpackBuffer);
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, MaxMipLevel);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        return texture;
+    }
+
+    TextureAtlas::Page& TextureAtlas::createPage(int size) {
+        VOLT_PROFILE_SCOPE("TextureAtlas::createPage");
+
+        return pages.emplace_back(Page{ createPageTexture(size), size, AtlasPacker(size, size), false });
+    }
+
+    bool TextureAtlas::growPage(Page& page, int paddedWidth, int paddedHeight, AtlasRect& rect) {
+        int size = page.size;
+        AtlasPacker packer = page.packer;
+
+        // Find the smallest doubling the rectangle fits in before touching the GPU.
+        do {
+            size *= 2;
+            if (size > maxPageSize)
+                return false;
+
+            packer.grow(size, size);
+        } while (!packer.pack(paddedWidth, paddedHeight, rect));
+
+        VOLT_PROFILE_SCOPE("TextureAtlas::growPage");
+
+        GLuint texture = createPageTexture(size);
+
+        // Copy level 0 across through a read framebuffer; the mips are rebuilt by finalizeUploads().
+        GLint boundReadFramebuffer = 0;
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &boundReadFramebuffer);
+
+        GLuint framebuffer = 0;
+        glGenFramebuffers(1, &framebuffer);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+        glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, page.texture, 0);
+
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, page.size, page.size);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, boundReadFramebuffer);
+        glDeleteFramebuffers(1, &framebuffer);
+        glDeleteTextures(1, &page.texture);
+
+        page.texture = texture;
+        page.size = size;
+        page.packer = packer;
+        page.dirty = true;
+        return true;
+    }
+
+    bool TextureAtlas::add(const unsigned char* pixels, int width, int height, AtlasRegion& region) {
+        if (!fits(width, height))
+            return false;
+
+        int paddedWidth = width + Padding * 2;
+        int paddedHeight = height + Padding * 2;
+
+        AtlasRect rect;
+        Page* target = nullptr;
+
+        for (Page& page : pages) {
+            if (page.packer.pack(paddedWidth, paddedHeight, rect)) {
+                target = &page;
+                break;
+            }
+        }
+
+        // Growing the newest page keeps everything on as few textures as possible.
+        if (!target && !pages.empty() && growPage(pages.back(), paddedWidth, paddedHeight, rect))
+            target = &pages.back();
+
+        if (!target) {
+            int size = std::max<int>(InitialPageSize, std::bit_ceil(static_cast<unsigned>(std::max(paddedWidth, paddedHeight))));
+            target = &createPage(std::min(size, maxPageSize));
+            target->packer.pack(paddedWidth, paddedHeight, rect);
+        }
+
+        glBindTexture(GL_TEXTURE_2D, target->texture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x + Padding, rect.y + Padding, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        target->dirty = true;
+
+        region.page = static_cast<int>(target - pages.data());
+        region.rect = { rect.x + Padding, rect.y + Padding, width, height };
+
+        return true;
+    }
+
+    void TextureAtlas::finalizeUploads() {
+        for (Page& page : pages) {
+            if (!page.dirty)
+                continue;
+
+            glBindTexture(GL_TEXTURE_2D, page.texture);
+            glGenerateMipmap(GL_TEXTURE_2D);
+            page.dirty = false;
+        }
+
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    AtlasMemoryStats TextureAtlas::getMemoryStats() const {
+        AtlasMemoryStats stats;
+        stats.pageCount = static_cast<int>(pages.size());
+
+        for (const Page& page : pages) {
+            stats.textureBytes += pageBytes(page.size);
+            stats.usedPixels += page.packer.getUsedArea();
+            stats.totalPixels += static_cast<uint64_t>(page.size) * page.size;
+        }
+
+        return stats;
+    }
+
+    void TextureAtlas::shutdown() {
+        if (glfwGetCurrentContext()) {
+            for (Page& page : pages) {
+                if (page.texture != 0)
+                    glDeleteTextures(1, &page.texture);
+            }
+        }
+
+        pages.clear();
+    }
+
+}
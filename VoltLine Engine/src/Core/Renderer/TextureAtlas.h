@@ -0,0 +1,121 @@
+#pragma once
+
+#include "pch.h"
+
+#include "imgui.h"
+
+namespace Renderer {
+
+    struct AtlasRect {
+        int x = 0;
+        int y = 0;
+        int width = 0;
+        int height = 0;
+    };
+
+    // Skyline bottom-left rectangle packer for a single page. CPU only.
+    class AtlasPacker {
+    public:
+        AtlasPacker(int width, int height);
+
+        // Returns false if the rectangle doesn't fit anywhere on the page.
+        bool pack(int width, int height, AtlasRect& out);
+
+        // Enlarges the page, keeping everything packed so far where it is.
+        void grow(int newWidth, int newHeight);
+
+        void reset();
+
+        int getWidth() const { return width; }
+        int getHeight() const { return height; }
+        uint64_t getUsedArea() const { return usedArea; }
+
+    private:
+        struct SkylineNode {
+            int x;
+            int y;
+            int width;
+        };
+
+        int width;
+        int height;
+        uint64_t usedArea = 0;
+        std::vector<SkylineNode> skyline;
+
+        int fitAt(size_t index, int rectWidth, int rectHeight) const;
+        void addLevel(size_t index, const AtlasRect& rect);
+    };
+
+    // Where an image lives in the atlas. Pages can grow (and so change texture and
+    // size) after the image was added, so resolve it through the atlas each time.
+    struct AtlasRegion {
+        int page = -1;
+        AtlasRect rect;     // the image itself, padding excluded
+    };
+
+    struct AtlasMemoryStats {
+        int pageCount = 0;
+        size_t textureBytes = 0;   // GPU memory, mip chain included
+        uint64_t usedPixels = 0;
+        uint64_t totalPixels = 0;
+
+        float occupancy() const { return totalPixels ? static_cast<float>(usedPixels) / totalPixels : 0.0f; }
+    };
+
+    // Packs UI images into shared RGBA8 atlas pages, so the hub's icons live in one
+    // texture instead of one each. Pages are sized to their content: a page starts
+    // at InitialPageSize (or the smallest power of two holding its first image) and
+    // doubles, copying what it already holds, when the next image doesn't fit, up to
+    // maxPageSize. Only then is another page started. GL thread only.
+    class TextureAtlas {
+    public:
+        static constexpr int InitialPageSize = 256;
+        static constexpr int MaxPageSize = 2048;
+
+        // The gutter keeps mip levels up to MaxMipLevel from bleeding into neighbours.
+        static constexpr int Padding = 8;
+        static constexpr int MaxMipLevel = 3;
+
+        explicit TextureAtlas(int maxPageSize = MaxPageSize);
+        ~TextureAtlas();
+
+        TextureAtlas(const TextureAtlas&) = delete;
+        TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+        // Uploads an RGBA8 image into the atlas. Returns false (leaving region untouched)
+        // when the image is too large to ever fit on a page. Like glTexSubImage2D, pixels
+        // is an offset into the bound GL_PIXEL_UNPACK_BUFFER if there is one.
+        bool add(const unsigned char* pixels, int width, int height, AtlasRegion& region);
+
+        // Rebuilds mipmaps of the pages touched since the last call. Call once after a batch of add()s.
+        void finalizeUploads();
+
+        bool fits(int width, int height) const;
+
+        GLuint getTexture(const AtlasRegion& region) const;
+        void getUVs(const AtlasRegion& region, ImVec2& uv0, ImVec2& uv1) const;
+
+        AtlasMemoryStats getMemoryStats() const;
+
+        // GL thread only, while the context is still current.
+        void shutdown();
+
+    private:
+        struct Page {
+            GLuint texture = 0;
+            int size = 0;
+            AtlasPacker packer;
+            bool dirty = false;
+        };
+
+        int maxPageSize;
+        std::vector<Page> pages;
+
+        Page& createPage(int size);
+        bool growPage(Page& page, int paddedWidth, int paddedHeight, AtlasRect& rect);
+
+        static GLuint createPageTexture(int size);
+        static size_t pageBytes(int size);
+    };
+
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "pch.h"
+
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <new>
+
+namespace Threading {
+
+    // Bounded multi-producer/multi-consumer queue (Dmitry Vyukov's design). Every
+    // slot carries a sequence number that tells producers and consumers whose turn
+    // it is, so pushing and popping are a single CAS on the shared index with no
+    // locks and no allocation after construction. Capacity is rounded up to a power
+    // of two. tryPush/tryPop never block; callers pick what to do when full or empty.
+    template<typename T>
+    class MPMCQueue {
+    public:
+        explicit MPMCQueue(size_t capacity)
+            : mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1),
+              cells(std::make_unique<Cell[]>(mask + 1)) {
+            for (size_t i = 0; i <= mask; ++i)
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        MPMCQueue(const MPMCQueue&) = delete;
+        MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+        template<typename U>
+        bool tryPush(U&& value) {
+            Cell* cell;
+            size_t position = enqueuePosition.load(std::memory_order_relaxed);
+
+            while (true) {
+                cell = &cells[position & mask];
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+                if (difference == 0) {
+                    if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (difference < 0) {
+                    return false; // full
+                }
+                else {
+                    position = enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+
+            cell->value = std::forward<U>(value);
+            cell->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool tryPop(T& out) {
+            Cell* cell;
+            size_t position = dequeuePosition.load(std::memory_order_relaxed);
+
+            while (true) {
+                cell = &cells[position & mask];
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+                if (difference == 0) {
+                    if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (difference < 0) {
+                    return false; // empty
+                }
+                else {
+                    position = dequeuePosition.load(std::memory_order_relaxed);
+                }
+            }
+
+            out = std::move(cell->value);
+            cell->sequence.store(position + mask + 1, std::memory_order_release);
+            return true;
+        }
+
+        size_t capacity() const { return mask + 1; }
+
+        // Only a snapshot; other threads may change it immediately.
+        size_t approximateSize() const {
+            size_t head = dequeuePosition.load(std::memory_order_relaxed);
+            size_t tail = enqueuePosition.load(std::memory_order_relaxed);
+            return tail > head ? tail - head : 0;
+        }
+
+    private:
+        static constexpr size_t CacheLine = 64;
+
+        struct Cell {
+            std::atomic<size_t> sequence;
+            T value;
+        };
+
+        const size_t mask;
+        std::unique_ptr<Cell[]> cells;
+
+        // Producers and consumers hammer different indices; keep them on separate lines.
+        alignas(CacheLine) std::atomic<size_t> enqueuePosition{ 0 };
+        alignas(CacheLine) std::atomic<size_t> dequeuePosition{ 0 };
+    };
+
+}
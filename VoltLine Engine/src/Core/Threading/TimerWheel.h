@@ -0,0 +1,113 @@
+#pragma once
+
+#include "pch.h"
+
+#include <optional>
+
+namespace Threading {
+
+    // Hashed timer wheel for delayed work on a single thread (the main loop).
+    // Scheduling and cancelling are O(1) on average; advance() only looks at the
+    // slots whose ticks have elapsed since the last call. Timers further out than
+    // one revolution simply stay in their slot until their round comes up.
+    //
+    // Not thread-safe: schedule, cancel and advance must all run on the owning thread.
+    class TimerWheel {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using Callback = std::function<void()>;
+        using TimerId = uint64_t;
+
+        static constexpr TimerId InvalidTimer = 0;
+
+        explicit TimerWheel(std::chrono::milliseconds tick = std::chrono::milliseconds(10), size_t slotCount = 256)
+            : tick(tick), slots(slotCount), origin(Clock::now()) {
+        }
+
+        TimerId schedule(std::chrono::milliseconds delay, Callback callback) {
+            // Measured from the real time rather than the last advance() and rounded
+            // up, so a timer never fires early.
+            Clock::duration due = Clock::now() - origin + std::max(delay, std::chrono::milliseconds(0));
+            uint64_t dueTick = std::max<uint64_t>((due + tick - Clock::duration(1)) / tick, currentTick + 1);
+
+            // The slot index is folded into the id so cancel() knows where to look.
+            size_t slotIndex = dueTick % slots.size();
+            TimerId id = ++lastSequence * slots.size() + slotIndex;
+            slots[slotIndex].push_back({ id, dueTick, std::move(callback) });
+            ++activeCount;
+            return id;
+        }
+
+        bool cancel(TimerId id) {
+            if (id == InvalidTimer)
+                return false;
+
+            for (Timer& timer : slots[id % slots.size()]) {
+                if (timer.id == id && timer.callback) {
+                    timer.callback = nullptr;
+                    --activeCount;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Runs every timer that is due by now. Callbacks may schedule new timers.
+        void advance(Clock::time_point now = Clock::now()) {
+            uint64_t targetTick = static_cast<uint64_t>((now - origin) / tick);
+
+            while (currentTick < targetTick) {
+                ++currentTick;
+
+                if (activeCount == 0) {
+                    // Nothing pending: jump straight to the present.
+                    currentTick = targetTick;
+                    break;
+                }
+
+                std::vector<Timer>& slot = slots[currentTick % slots.size()];
+                if (slot.empty())
+                    continue;
+
+                // Move due timers out first; their callbacks may push into this slot.
+                std::vector<Timer> due;
+                for (size_t i = 0; i < slot.size();) {
+                    if (slot[i].dueTick <= currentTick) {
+                        due.push_back(std::move(slot[i]));
+                        slot[i] = std::move(slot.back());
+                        slot.pop_back();
+                    }
+                    else {
+                        ++i;
+                    }
+                }
+
+                for (Timer& timer : due) {
+                    if (!timer.callback)
+                        continue;
+
+                    --activeCount;
+                    timer.callback();
+                }
+            }
+        }
+
+        bool empty() const { return activeCount == 0; }
+        size_t size() const { return activeCount; }
+
+    private:
+        struct Timer {
+            TimerId id;
+            uint64_t dueTick;
+            Callback callback;
+        };
+
+        std::chrono::milliseconds tick;
+        std::vector<std::vector<Timer>> slots;
+        Clock::time_point origin;
+        uint64_t currentTick = 0;
+        uint64_t lastSequence = 0;
+        size_t activeCount = 0;
+    };
+
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "pch.h"
+
+#include <atomic>
+#include <bit>
+#include <memory>
+
+namespace Threading {
+
+    // Fixed-capacity Chase-Lev deque (the C11 formulation by Lê et al.). The owning
+    // thread pushes and pops at the bottom like a stack, which keeps recently
+    // spawned, cache-hot work local; other threads steal the oldest entries from the
+    // top. Only steals and the owner's last-element pop contend, on a single CAS.
+    //
+    // T must be trivially copyable (the job system stores pointers).
+    template<typename T>
+    class WorkStealingDeque {
+    public:
+        explicit WorkStealingDeque(size_t capacity = 4096)
+            : mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1),
+              buffer(std::make_unique<std::atomic<T>[]>(mask + 1)) {
+        }
+
+        WorkStealingDeque(const WorkStealingDeque&) = delete;
+        WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+        // Owner only. False if the deque is full.
+        bool push(T value) {
+            int64_t b = bottom.load(std::memory_order_relaxed);
+            int64_t t = top.load(std::memory_order_acquire);
+            if (b - t > static_cast<int64_t>(mask))
+                return false;
+
+            buffer[b & mask].store(value, std::memory_order_relaxed);
+            // Publishes the job to thieves, who read bottom with acquire.
+            bottom.store(b + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Owner only.
+        bool pop(T& out) {
+            int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+            bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t t = top.load(std::memory_order_relaxed);
+
+            if (t > b) {
+                // Empty.
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return false;
+            }
+
+            out = buffer[b & mask].load(std::memory_order_relaxed);
+            if (t != b)
+                return true;
+
+            // Last element: race the thieves for it.
+            bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+
+        // Any thread.
+        bool steal(T& out) {
+            int64_t t = top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t b = bottom.load(std::memory_order_acquire);
+
+            if (t >= b)
+                return false;
+
+            T value = buffer[t & mask].load(std::memory_order_relaxed);
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return false;
+
+            out = value;
+            return true;
+        }
+
+        bool empty() const {
+            return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+        }
+
+    private:
+        static constexpr size_t CacheLine = 64;
+
+        const size_t mask;
+        std::unique_ptr<std::atomic<T>[]> buffer;
+
+        alignas(CacheLine) std::atomic<int64_t> top{ 0 };
+        alignas(CacheLine) std::atomic<int64_t> bottom{ 0 };
+    };
+
+}
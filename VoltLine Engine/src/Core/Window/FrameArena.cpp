@@ -0,0 +1,67 @@
+#include "FrameArena.h"
+
+#include <bit>
+
+namespace Window {
+
+    FrameArena::FrameArena(size_t blockSize)
+        : block(std::make_unique<char[]>(blockSize)), blockSize(blockSize) {
+    }
+
+    void* FrameArena::allocate(size_t size, size_t alignment) {
+        uintptr_t address = reinterpret_cast<uintptr_t>(current());
+        size_t padding = (alignment - address % alignment) % alignment;
+
+        if (padding + size > remaining()) {
+            // A fresh block is aligned for anything up to max_align_t.
+            char* memory = spill(size + alignment);
+            padding = (alignment - reinterpret_cast<uintptr_t>(memory) % alignment) % alignment;
+        }
+
+        char* memory = current() + padding;
+        used += padding + size;
+        return memory;
+    }
+
+    char* FrameArena::spill(size_t size) {
+        spilledBytes += used;
+        spillSize = std::max(size, blockSize);
+        spillCapacity += spillSize;
+        spills.push_back(std::make_unique<char[]>(spillSize));
+        used = 0;
+        return spills.back().get();
+    }
+
+    void FrameArena::countText(const Profiler::AllocationStats& before) {
+        ++textCalls;
+        textAllocations += Profiler::threadAllocations().count - before.count;
+    }
+
+    FrameArena::Stats FrameArena::getStats() const {
+        return { spilledBytes + used, blockSize + spillCapacity, textCalls, textAllocations };
+    }
+
+    void FrameArena::reset() {
+        lastFrame = getStats();
+
+        // This frame didn't fit: grow so the next one like it does, in one block.
+        if (!spills.empty()) {
+            blockSize = std::bit_ceil(lastFrame.bytesUsed + lastFrame.bytesUsed / 2);
+            block = std::make_unique<char[]>(blockSize);
+            spills.clear();
+            spillSize = 0;
+            spillCapacity = 0;
+        }
+
+        used = 0;
+        spilledBytes = 0;
+        textCalls = 0;
+        textAllocations = 0;
+    }
+
+    FrameArena& frameArena() {
+        static FrameArena arena;
+        return arena;
+    }
+
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "pch.h"
+
+#include <memory>
+
+#include "Core/Profiler/AllocationCounter.h"
+
+namespace Window {
+
+    // Linear allocator for memory that only has to live until the end of the frame,
+    // mostly the text of widget labels. allocate() bumps a pointer; reset(), once
+    // per frame, rewinds it. A frame that outgrows the block spills into extra
+    // blocks, and the next reset() replaces them all with one block big enough for
+    // that frame, so a steady-state frame makes no heap allocations at all.
+    //
+    // Main thread only, like the ImGui calls it feeds.
+    class FrameArena {
+    public:
+        static constexpr size_t DefaultBlockSize = 16 * 1024;
+
+        struct Stats {
+            size_t bytesUsed = 0;
+            size_t capacity = 0;
+            uint64_t textCalls = 0;
+            // Heap allocations made while formatting text: the arena growing, or a
+            // formatter that allocates. Zero in a steady-state frame, and always zero
+            // in builds that don't count allocations (see AllocationCounter.h).
+            uint64_t textAllocations = 0;
+        };
+
+        explicit FrameArena(size_t blockSize = DefaultBlockSize);
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        // std::format into the arena. The result is null terminated and valid until reset().
+        template<typename... Args>
+        const char* format(std::format_string<const Args&...> pattern, const Args&... args) {
+            Profiler::AllocationStats before = Profiler::threadAllocations();
+
+            char* text = current();
+            size_t available = remaining();
+            size_t size = static_cast<size_t>(std::format_to_n(text, available, pattern, args...).size);
+
+            // Didn't fit (with the terminator): format again into a block that is big enough.
+            if (size >= available) {
+                text = spill(size + 1);
+                std::format_to_n(text, size, pattern, args...);
+            }
+            text[size] = '\0';
+            used += size + 1;
+
+            countText(before);
+            return text;
+        }
+
+        // Starts the next frame. Everything handed out before is invalid afterwards.
+        void reset();
+
+        // What the current frame has used so far, and what the last finished frame used.
+        Stats getStats() const;
+        const Stats& getLastFrameStats() const { return lastFrame; }
+
+    private:
+        std::unique_ptr<char[]> block;
+        size_t blockSize = 0;
+        size_t used = 0;
+
+        // Spill blocks of this frame; used then counts into the last one.
+        std::vector<std::unique_ptr<char[]>> spills;
+        size_t spillSize = 0;
+        size_t spilledBytes = 0;
+        // Spill blocks differ in size, so their capacity is summed as they are made.
+        size_t spillCapacity = 0;
+
+        uint64_t textCalls = 0;
+        uint64_t textAllocations = 0;
+        Stats lastFrame;
+
+        char* current() { return (spills.empty() ? block.get() : spills.back().get()) + used; }
+        size_t remaining() const { return (spills.empty() ? blockSize : spillSize) - used; }
+        char* spill(size_t size);
+        void countText(const Profiler::AllocationStats& before);
+    };
+
+    // The main thread's frame arena; Window resets it at the end of every frame.
+    FrameArena& frameArena();
+
+    // Formats a widget label into the frame arena:
+    //   ImGui::TextUnformatted(frameText("Engine Version: {}", version));
+    template<typename... Args>
+    const char* frameText(std::format_string<const Args&...> pattern, const Args&... args) {
+        return frameArena().format(pattern, args...);
+    }
+
+}
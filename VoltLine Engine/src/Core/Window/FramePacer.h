@@ -0,0 +1,134 @@
+#pragma once
+
+#include "pch.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Window {
+
+    // Paces the hub's main loop. While there is input (or something on screen is
+    // animating) frames are capped at max_fps with a sleep+spin limiter; once the hub
+    // has been quiet for a short grace period it blocks in glfwWaitEventsTimeout so a
+    // background hub costs next to nothing.
+    class FramePacer {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        // 0 (or negative) disables the limiter.
+        void setMaxFps(int fps) {
+            framePeriod = fps > 0 ? std::chrono::duration<double>(1.0 / fps) : std::chrono::duration<double>(0.0);
+            nextFrame = Clock::now();
+        }
+
+        void setVsync(bool enabled) {
+            vsync = enabled;
+            glfwSwapInterval(enabled ? 1 : 0);
+        }
+
+        void setIdleMode(bool enabled) { idleMode = enabled; }
+
+        bool isVsync() const { return vsync; }
+        bool isIdle() const { return idle; }
+
+        // Called from input callbacks: keeps the loop awake for the grace period.
+        void markActivity() { lastActivity = Clock::now(); }
+
+        // Keeps the loop awake for a while, e.g. while a widget is being edited or
+        // something is animating.
+        void keepAwake(std::chrono::milliseconds duration = std::chrono::milliseconds(0)) {
+            Clock::time_point until = Clock::now() + duration;
+            if (until > awakeUntil)
+                awakeUntil = until;
+            markActivity();
+        }
+
+        // Replaces glfwPollEvents at the top of the frame.
+        void waitForEvents(GLFWwindow* window) {
+            Clock::time_point now = Clock::now();
+            bool quiet = now - lastActivity > activityGrace && now > awakeUntil;
+
+            idle = idleMode && quiet;
+
+            if (!idle) {
+                glfwPollEvents();
+                return;
+            }
+
+            bool background = !glfwGetWindowAttrib(window, GLFW_FOCUSED) || glfwGetWindowAttrib(window, GLFW_ICONIFIED);
+            glfwWaitEventsTimeout(background ? backgroundTimeout : focusedTimeout);
+
+            // The limiter schedule is meaningless after blocking; restart it.
+            nextFrame = Clock::now();
+        }
+
+        // Called right after glfwSwapBuffers.
+        void endFrame() {
+            if (framePeriod.count() <= 0.0 || idle)
+                return;
+
+            nextFrame += std::chrono::duration_cast<Clock::duration>(framePeriod);
+
+            Clock::time_point now = Clock::now();
+            if (nextFrame < now) {
+                // Missed the deadline (hitch, vsync, slow frame): don't try to catch up.
+                nextFrame = now;
+                return;
+            }
+
+            preciseSleepUntil(nextFrame);
+        }
+
+    private:
+        std::chrono::duration<double> framePeriod{ 0.0 };
+        Clock::time_point nextFrame = Clock::now();
+        Clock::time_point lastActivity = Clock::now();
+        Clock::time_point awakeUntil = Clock::now();
+
+        bool vsync = false;
+        bool idleMode = true;
+        bool idle = false;
+
+        // ImGui needs a few frames after the last input to settle hover/active states.
+        static constexpr std::chrono::milliseconds activityGrace{ 500 };
+        static constexpr double focusedTimeout = 0.5;
+        static constexpr double backgroundTimeout = 1.0;
+
+        // Running estimate of how long a 1 ms sleep really takes on this machine, so we
+        // know when to stop sleeping and start spinning.
+        double sleepEstimate = 5e-3;
+        double sleepMean = 5e-3;
+        double sleepM2 = 0.0;
+        int64_t sleepSamples = 1;
+
+        void preciseSleepUntil(Clock::time_point deadline) {
+            using seconds = std::chrono::duration<double>;
+
+            double remaining = seconds(deadline - Clock::now()).count();
+
+            while (remaining > sleepEstimate) {
+                Clock::time_point start = Clock::now();
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                double observed = seconds(Clock::now() - start).count();
+                remaining -= observed;
+
+                // Welford's online mean/variance, estimate = mean + one standard deviation.
+                ++sleepSamples;
+                double delta = observed - sleepMean;
+                sleepMean += delta / sleepSamples;
+                sleepM2 += delta * (observed - sleepMean);
+                sleepEstimate = sleepMean + std::sqrt(sleepM2 / (sleepSamples - 1));
+
+                // Keep adapting to changing system load instead of averaging forever.
+                if (sleepSamples > 1000) {
+                    sleepSamples = 1;
+                    sleepM2 = 0.0;
+                }
+            }
+
+            while (Clock::now() < deadline)
+                std::this_thread::yield();
+        }
+    };
+
+}
@@ -0,0 +1,247 @@
+#pragma once
+
+#include "pch.h"
+
+#include <algorithm>
+#include <array>
+
+#include "imgui.h"
+
+#include "Core/Profiler/AllocationCounter.h"
+#include "Core/Renderer/ImGuiRenderer.h"
+#include "Core/Window/FrameArena.h"
+
+namespace Window {
+
+    // Collects per-frame CPU and GPU times into a ring buffer and draws the
+    // "Show FPS" overlay. GPU times come from GL_TIME_ELAPSED queries that are only
+    // read back once the driver reports them available, a few frames later, so the
+    // profiler never stalls the pipeline waiting on the GPU.
+    class FrameProfiler {
+    public:
+        static constexpr int HistorySize = 240;
+        static constexpr int QueryCount = 4;
+
+        struct Stats {
+            float p50 = 0.0f;
+            float p95 = 0.0f;
+            float p99 = 0.0f;
+            float worst = 0.0f;
+            float average = 0.0f;
+        };
+
+        ~FrameProfiler() {
+            shutdown();
+        }
+
+        void setEnabled(bool enabled) {
+            if (enabled == this->enabled)
+                return;
+
+            this->enabled = enabled;
+            if (enabled) {
+                cpuCount = 0;
+                gpuCount = 0;
+            }
+
+            // Results of queries issued before the toggle are never read as fresh
+            // samples; the query objects are simply reused.
+            pending.fill(false);
+            writeQuery = 0;
+            readQuery = 0;
+        }
+
+        bool isEnabled() const { return enabled; }
+
+        // What the UI renderer did for the last frame, shown in the overlay.
+        void setUiRenderStats(const Renderer::UiRenderStats& stats) { uiStats = stats; }
+
+        // Marks the start of CPU work for a frame (right after events were processed).
+        void beginFrame() {
+            Clock::time_point now = Clock::now();
+
+            if (lastFrameStart != Clock::time_point{})
+                frameInterval = std::chrono::duration<float, std::milli>(now - lastFrameStart).count();
+
+            lastFrameStart = now;
+            cpuStart = now;
+
+            if (enabled)
+                collectGpuResults();
+        }
+
+        // Wraps the GL submission of the frame.
+        void beginGpu() {
+            if (!enabled)
+                return;
+
+            if (queries[0] == 0)
+                glGenQueries(QueryCount, queries.data());
+
+            // Every query is still in flight: skip GPU timing this frame instead of waiting.
+            if (pending[writeQuery]) {
+                gpuActive = false;
+                return;
+            }
+
+            glBeginQuery(GL_TIME_ELAPSED, queries[writeQuery]);
+            gpuActive = true;
+        }
+
+        void endGpu() {
+            if (!gpuActive)
+                return;
+
+            glEndQuery(GL_TIME_ELAPSED);
+            pending[writeQuery] = true;
+            writeQuery = (writeQuery + 1) % QueryCount;
+            gpuActive = false;
+        }
+
+        // Marks the end of CPU work for the frame (before the buffer swap, which may block on vsync).
+        void endFrame() {
+            if (!enabled)
+                return;
+
+            float cpuMs = std::chrono::duration<float, std::milli>(Clock::now() - cpuStart).count();
+            push(cpuTimes, cpuHead, cpuCount, cpuMs);
+        }
+
+        void drawOverlay(ImFont* font = nullptr) {
+            if (!enabled)
+                return;
+
+            Stats cpu = computeStats(cpuTimes, cpuCount);
+            Stats gpu = computeStats(gpuTimes, gpuCount);
+
+            const float padding = 10.0f;
+            ImGuiIO& io = ImGui::GetIO();
+            ImGui::SetNextWindowPos(ImVec2(io.DisplaySize.x - padding, padding), ImGuiCond_Always, ImVec2(1.0f, 0.0f));
+            ImGui::SetNextWindowBgAlpha(0.75f);
+
+            ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings
+                | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoInputs | ImGuiWindowFlags_NoMove;
+
+            if (ImGui::Begin("VoltLine FPS Overlay", nullptr, flags)) {
+                if (font)
+                    ImGui::PushFont(font);
+
+                float fps = frameInterval > 0.0f ? 1000.0f / frameInterval : 0.0f;
+                ImGui::TextUnformatted(frameText("{:.0f} FPS ({:.2f} ms)", fps, frameInterval));
+                ImGui::Separator();
+
+                ImGui::TextUnformatted(frameText("CPU  p50 {:.2f}  p95 {:.2f}  p99 {:.2f}  worst {:.2f} ms", cpu.p50, cpu.p95, cpu.p99, cpu.worst));
+                if (gpuCount > 0)
+                    ImGui::TextUnformatted(frameText("GPU  p50 {:.2f}  p95 {:.2f}  p99 {:.2f}  worst {:.2f} ms", gpu.p50, gpu.p95, gpu.p99, gpu.worst));
+                else
+                    ImGui::TextUnformatted("GPU  waiting for timer queries...");
+
+                ImGui::TextUnformatted(frameText("UI   {} draws for {} commands, {:.1f} KB uploaded", uiStats.drawCalls, uiStats.commands, uiStats.uploadBytes / 1024.0));
+
+                // Should read 0 allocations once the arena has sized itself.
+                const FrameArena::Stats& text = frameArena().getLastFrameStats();
+                if (Profiler::AllocationCountingEnabled)
+                    ImGui::TextUnformatted(frameText("Text {} labels, {} B, {} allocations", text.textCalls, text.bytesUsed, text.textAllocations));
+                else
+                    ImGui::TextUnformatted(frameText("Text {} labels, {} B", text.textCalls, text.bytesUsed));
+
+                // Unroll the ring buffer so the graph scrolls left to right.
+                int offset = cpuCount < HistorySize ? 0 : cpuHead;
+                ImGui::PlotLines("##CPU Frame Times", cpuTimes.data(), cpuCount, offset, "CPU frame time (ms)", 0.0f, std::max(cpu.worst, 16.7f), ImVec2(320, 60));
+
+                if (gpuCount > 0) {
+                    int gpuOffset = gpuCount < HistorySize ? 0 : gpuHead;
+                    ImGui::PlotLines("##GPU Frame Times", gpuTimes.data(), gpuCount, gpuOffset, "GPU frame time (ms)", 0.0f, std::max(gpu.worst, 16.7f), ImVec2(320, 60));
+                }
+
+                if (font)
+                    ImGui::PopFont();
+            }
+            ImGui::End();
+        }
+
+        Stats getCpuStats() const { return computeStats(cpuTimes, cpuCount); }
+        Stats getGpuStats() const { return computeStats(gpuTimes, gpuCount); }
+
+        // Must run while the GL context is still current.
+        void shutdown() {
+            if (queries[0] != 0 && glfwGetCurrentContext()) {
+                glDeleteQueries(QueryCount, queries.data());
+            }
+            queries.fill(0);
+            pending.fill(false);
+        }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        bool enabled = false;
+
+        Clock::time_point lastFrameStart{};
+        Clock::time_point cpuStart{};
+        float frameInterval = 0.0f;
+
+        std::array<float, HistorySize> cpuTimes{};
+        std::array<float, HistorySize> gpuTimes{};
+        int cpuHead = 0, cpuCount = 0;
+        int gpuHead = 0, gpuCount = 0;
+
+        std::array<GLuint, QueryCount> queries{};
+        std::array<bool, QueryCount> pending{};
+        int writeQuery = 0;
+        int readQuery = 0;
+        bool gpuActive = false;
+
+        Renderer::UiRenderStats uiStats;
+
+        static void push(std::array<float, HistorySize>& buffer, int& head, int& count, float value) {
+            buffer[head] = value;
+            head = (head + 1) % HistorySize;
+            count = std::min(count + 1, HistorySize);
+        }
+
+        // Reads back every query that has finished, oldest first, without blocking.
+        void collectGpuResults() {
+            while (pending[readQuery]) {
+                GLint available = 0;
+                glGetQueryObjectiv(queries[readQuery], GL_QUERY_RESULT_AVAILABLE, &available);
+                if (!available)
+                    break;
+
+                GLuint64 elapsedNs = 0;
+                glGetQueryObjectui64v(queries[readQuery], GL_QUERY_RESULT, &elapsedNs);
+                push(gpuTimes, gpuHead, gpuCount, static_cast<float>(elapsedNs / 1.0e6));
+
+                pending[readQuery] = false;
+                readQuery = (readQuery + 1) % QueryCount;
+            }
+        }
+
+        static Stats computeStats(const std::array<float, HistorySize>& buffer, int count) {
+            Stats stats;
+            if (count == 0)
+                return stats;
+
+            std::array<float, HistorySize> sorted;
+            std::copy_n(buffer.begin(), count, sorted.begin());
+            std::sort(sorted.begin(), sorted.begin() + count);
+
+            auto percentile = [&](float p) {
+                int index = std::clamp(static_cast<int>(p * (count - 1) + 0.5f), 0, count - 1);
+                return sorted[index];
+            };
+
+            float sum = 0.0f;
+            for (int i = 0; i < count; ++i)
+                sum += sorted[i];
+
+            stats.p50 = percentile(0.50f);
+            stats.p95 = percentile(0.95f);
+            stats.p99 = percentile(0.99f);
+            stats.worst = sorted[count - 1];
+            stats.average = sum / count;
+            return stats;
+        }
+    };
+
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "pch.h"
+
+#include <algorithm>
+
+#include "nlohmann/json.hpp"
+
+#include "Core/Profiler/AllocationCounter.h"
+#include "Core/Renderer/ImGuiRenderer.h"
+#include "Core/Window/FrameArena.h"
+
+namespace Window {
+
+    // `--headless`: run the hub without a visible window for a fixed number of
+    // frames, cycling through scripted screens, then write a timing report. Meant
+    // for CI and build nodes without a display.
+    struct HeadlessOptions {
+        bool enabled = false;
+        int frames = 300;
+        int framesPerScreen = 50;
+        // "project", "new_project" or "settings" (the settings popup over the projects screen).
+        std::vector<string> screens = { "project", "new_project", "settings" };
+        // A file rather than stdout, which the hub's console log shares.
+        string reportPath = "headless_report.json";
+    };
+
+    // Collects the numbers for a headless run: time to the first frame, then CPU
+    // time and main-thread allocations for every frame, overall and per screen.
+    // Allocations made formatting widget text are reported separately; endFrame()
+    // has to run before the frame arena is reset.
+    class HeadlessReport {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        void beginStartup() { startupStart = Clock::now(); }
+        void endStartup() { startupMs = millisecondsSince(startupStart); }
+
+        void beginFrame(const string& screen) {
+            currentScreen = screen;
+            frameStart = Clock::now();
+            frameAllocations = Profiler::threadAllocations();
+        }
+
+        // Called between beginFrame() and endFrame() when the frame was drawn.
+        void recordUiRender(const Renderer::UiRenderStats& stats) { uiRender = stats; }
+
+        void endFrame() {
+            Profiler::AllocationStats now = Profiler::threadAllocations();
+
+            Frame frame;
+            frame.uiDrawCalls = static_cast<double>(uiRender.drawCalls);
+            frame.uiUploadBytes = static_cast<double>(uiRender.uploadBytes);
+            uiRender = {};
+
+            frame.cpuMs = millisecondsSince(frameStart);
+            frame.allocations = static_cast<double>(now.count - frameAllocations.count);
+            frame.allocatedBytes = static_cast<double>(now.bytes - frameAllocations.bytes);
+
+            FrameArena::Stats text = frameArena().getStats();
+            frame.textAllocations = static_cast<double>(text.textAllocations);
+            frame.textBytes = static_cast<double>(text.bytesUsed);
+
+            if (frames.empty())
+                firstFrameMs = frame.cpuMs;
+
+            frames.push_back(frame);
+            byScreen[currentScreen].push_back(frame);
+        }
+
+        nlohmann::json toJson(const string& renderer, const string& uiRenderer) const {
+            nlohmann::json report;
+            report["renderer"] = renderer;
+            report["ui_renderer"] = uiRenderer;
+            report["frames"] = frames.size();
+            report["startup_ms"] = startupMs;
+            report["first_frame_ms"] = firstFrameMs;
+
+            // The first frame pays for lazy initialization; keep it out of the steady-state numbers.
+            std::vector<Frame> steady(frames.begin() + std::min<size_t>(1, frames.size()), frames.end());
+            describe(report, steady);
+
+            for (const auto& [screen, screenFrames] : byScreen)
+                describe(report["screens"][screen], screenFrames);
+
+            return report;
+        }
+
+    private:
+        struct Frame {
+            double cpuMs = 0.0;
+            double allocations = 0.0;
+            double allocatedBytes = 0.0;
+            double textAllocations = 0.0;
+            double textBytes = 0.0;
+            double uiDrawCalls = 0.0;
+            double uiUploadBytes = 0.0;
+        };
+
+        Clock::time_point startupStart{};
+        Clock::time_point frameStart{};
+        double startupMs = 0.0;
+        double firstFrameMs = 0.0;
+
+        string currentScreen;
+        Profiler::AllocationStats frameAllocations;
+        Renderer::UiRenderStats uiRender;
+        std::vector<Frame> frames;
+        std::map<string, std::vector<Frame>> byScreen;
+
+        static double millisecondsSince(Clock::time_point start) {
+            return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+
+        static nlohmann::json summarize(std::vector<double> values) {
+            nlohmann::json summary;
+            if (values.empty())
+                return summary;
+
+            std::sort(values.begin(), values.end());
+            auto at = [&](double p) { return values[static_cast<size_t>(p * (values.size() - 1) + 0.5)]; };
+
+            double sum = 0.0;
+            for (double value : values)
+                sum += value;
+
+            summary["mean"] = sum / values.size();
+            summary["p50"] = at(0.50);
+            summary["p95"] = at(0.95);
+            summary["p99"] = at(0.99);
+            summary["max"] = values.back();
+            return summary;
+        }
+
+        static void describe(nlohmann::json& out, const std::vector<Frame>& frames) {
+            std::vector<double> cpu, allocations, bytes, textAllocations, textBytes, uiDrawCalls, uiUploadBytes;
+            for (const Frame& frame : frames) {
+                cpu.push_back(frame.cpuMs);
+                allocations.push_back(frame.allocations);
+                bytes.push_back(frame.allocatedBytes);
+                textAllocations.push_back(frame.textAllocations);
+                textBytes.push_back(frame.textBytes);
+                uiDrawCalls.push_back(frame.uiDrawCalls);
+                uiUploadBytes.push_back(frame.uiUploadBytes);
+            }
+
+            out["frame_cpu_ms"] = summarize(std::move(cpu));
+            // Left out rather than reported as zeros when the build doesn't count them.
+            if (Profiler::AllocationCountingEnabled) {
+                out["allocations_per_frame"] = summarize(std::move(allocations));
+                out["allocated_bytes_per_frame"] = summarize(std::move(bytes));
+                out["text_allocations_per_frame"] = summarize(std::move(textAllocations));
+            }
+            out["text_bytes_per_frame"] = summarize(std::move(textBytes));
+            out["ui_draw_calls_per_frame"] = summarize(std::move(uiDrawCalls));
+            out["ui_upload_bytes_per_frame"] = summarize(std::move(uiUploadBytes));
+        }
+    };
+
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "pch.h"
+
+#include "Core/Threading/MPMCQueue.h"
+
+namespace Window {
+
+    struct InputEvent {
+        enum class Type : uint8_t {
+            Key,
+            MouseButton,
+        };
+
+        Type type;
+        int code;       // GLFW key or mouse button
+        int scancode;
+        int action;
+        int mods;
+    };
+
+    // GLFW callbacks only record what happened here; the main loop drains the queue
+    // once per frame and does the actual work, so no handler ever runs from inside
+    // glfwPollEvents (or from another thread). Lock-free, so pushing from a callback
+    // never blocks.
+    class InputQueue {
+    public:
+        static constexpr size_t Capacity = 1024;
+
+        void push(const InputEvent& event) {
+            if (!queue.tryPush(event))
+                dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        template<typename Handler>
+        void drain(Handler&& handler) {
+            InputEvent event;
+            while (queue.tryPop(event))
+                handler(event);
+        }
+
+        uint64_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+    private:
+        Threading::MPMCQueue<InputEvent> queue{ Capacity };
+        std::atomic<uint64_t> dropped{ 0 };
+    };
+
+}
@@ -1,76 +1,58 @@
 #include "Window.h"
 
-#define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"
-
 #include "Core/Managers/KeyBindingManager/KeyBindingManager.h"
 #include "Core/Managers/ItemManager/ItemManager.h"
 #include "Core/Managers/DirectoryManager/DirectoryManager.h"
+#include "Core/FileSystem/VirtualFileSystem.h"
+#include "Core/Managers/SettingsManager/SettingsManager.h"
+#include "Core/Managers/SettingsManager/HubSettings.h"
+#include "Core/Managers/EngineManager/EngineManager.h"
+#include "Core/Profiler/Profiler.h"
+#include "Core/Logging/HubLogger.h"
 
 using InputCallback = std::function<void()>;
 
 static bool canFocusOnSidePanelWindow = true;
 
-static bool fileExists(const string& filename)
-{
-    std::ifstream file(filename);
-    return file.good();
-}
-
-static string getFileContents(const char* filePath) {
-    std::ifstream file(filePath);
-
-    if (!file.is_open()) {
-        throw std::runtime_error("Could not open file: " + string(filePath));
-    }
-
-    string contents;
-    string line;
-
-    while (std::getline(file, line)) {
-        contents += line + '\n';
-    }
-
-    file.close();
+namespace cf_Sink {
+    std::shared_ptr<spdlog::logger> setupLogger() {
+        // Schema problems are logged by Window once this logger exists.
+        SettingsManager::SchemaReport report;
+        const SettingsManager::EngineSettings engineSettings = SettingsManager::parseSettings<SettingsManager::HubSettings>(SettingsManager::hubSettings().get(), report).engine;
 
-    return contents;
+        const std::string& logFilePath = engineSettings.logFileDir;
+        size_t maxFileSize = static_cast<size_t>(std::max(engineSettings.logMaxFileSizeMb, 1)) * 1024 * 1024;
+        size_t maxFiles = static_cast<size_t>(std::max(engineSettings.logMaxFiles, 1));
 
-}
+        std::shared_ptr<spdlog::logger> logger;
 
-std::string getLogFilePath() {
-    static json j;
-    static string hubSettingsPath = "bin/" + string(CURRENT_PLAT) + "-" + string(CURRENT_CONF) + "/VoltLine Engine/hub_settings.json";
-    static string jsonText;
+        if (engineSettings.asyncLogging) {
+            // Only the log writer thread touches these, so the single-threaded sinks are enough.
+            std::vector<spdlog::sink_ptr> sinks = {
+                std::make_shared<spdlog::sinks::stdout_color_sink_st>(),
+                std::make_shared<spdlog::sinks::rotating_file_sink_st>(logFilePath, maxFileSize, maxFiles, true)
+            };
 
-    if (fileExists("hub_settings.json")) {
-        jsonText = getFileContents("hub_settings.json");
-    }
-    else {
-        jsonText = getFileContents(hubSettingsPath.c_str());
-    }
+            // Set before the writer thread starts using the sinks.
+            for (const spdlog::sink_ptr& sink : sinks)
+                sink->set_pattern("%+");
 
-    try {
-        j = json::parse(jsonText);
-    }
-    catch (const std::exception& e) {
-        j = json();
-    }
-
-    return j["engine_settings"]["engine_log_file_dir"];
-}
+            Logging::AsyncSinkOptions options;
+            options.queueSize = static_cast<size_t>(std::max(engineSettings.logQueueSize, 1));
+            options.policy = Logging::overflowPolicyFromName(engineSettings.logOverflowPolicy).value_or(Logging::OverflowPolicy::Block);
 
-namespace cf_Sink {
-    std::shared_ptr<spdlog::logger> setupLogger() {
-        // Get the log file path
-        std::string logFilePath = getLogFilePath();
-
-        // Create the sinks
-        auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
-        auto file_sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(logFilePath, true);
+            logger = std::make_shared<spdlog::logger>("multi_sink_logger", std::make_shared<Logging::AsyncSink>(std::move(sinks), options));
+        }
+        else {
+            // Create the sinks
+            auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+            auto file_sink = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(logFilePath, maxFileSize, maxFiles, true);
 
-        // Create the logger
-        std::vector<spdlog::sink_ptr> sinks = { console_sink, file_sink };
-        auto logger = std::make_shared<spdlog::logger>("multi_sink_logger", sinks.begin(), sinks.end());
+            // Create the logger
+            std::vector<spdlog::sink_ptr> sinks = { console_sink, file_sink };
+            logger = std::make_shared<spdlog::logger>("multi_sink_logger", sinks.begin(), sinks.end());
+            logger->set_pattern("%+");
+        }
 
         // Set log level, etc.
         logger->set_level(spdlog::level::info);
@@ -78,85 +60,29 @@ namespace cf_Sink {
         return logger;
     }
 
-    // Static logger that is initialized using setupLogger
-    static std::shared_ptr<spdlog::logger> logger = setupLogger();
+    // Installed during static initialization, so the hub's own messages reach the log file from the start.
+    static const bool loggerInstalled = (setLogger(setupLogger()), true);
 }
 
 namespace Window {
 
-    static GLuint LoadTexture(const char* filename) {
-        GLuint textureID;
-        glGenTextures(1, &textureID);
-
-        glBindTexture(GL_TEXTURE_2D, textureID);
-
-        int width, height, nrChannels;
-        unsigned char* data = stbi_load(filename, &width, &height, &nrChannels, 0);
-        if (!data) {
-            cf_Sink::logger->error(std::format("Failed to load texture: {}", filename));
-            return 0;
-        }
+    bool setWindowIcon(GLFWwindow* window, std::string_view iconPath) {
+        Renderer::DecodedImage image;
+        if (std::optional<FileSystem::AssetData> encoded = FileSystem::vfs().read(iconPath))
+            image = Renderer::decodeImage(encoded->bytes());
 
-        GLenum format;
-        if (nrChannels == 1)
-            format = GL_RED;
-        else if (nrChannels == 3)
-            format = GL_RGB;
-        else if (nrChannels == 4)
-            format = GL_RGBA;
-        else {
-            cf_Sink::logger->error(std::format("Unsupported image format: {}", filename));
-            stbi_image_free(data);
-            return 0;
-        }
-
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        stbi_image_free(data);
-
-        glBindTexture(GL_TEXTURE_2D, 0);
-
-        return textureID;
-    }
-
-    static void saveFileContents(const char* str, const char* filePath) {
-        std::ofstream file(filePath, std::ios::out | std::ios::trunc);
-
-        if (!file.is_open()) {
-            throw std::ios_base::failure("Failed to open the file for writing.");
-        }
-
-        file << str;
-
-        if (!file) {
-            throw std::ios_base::failure("Failed to write to the file.");
-        }
-    }
-
-    bool setWindowIcon(GLFWwindow* window, const char* iconPath) {
-        int width, height, channels;
-        unsigned char* image = stbi_load(iconPath, &width, &height, &channels, 4);
-
-        if (!image) {
+        if (!image.valid()) {
             cf_Sink::logger->error(std::format("Failed to load icon file: {}'.", iconPath));
             return false;
         }
 
         GLFWimage icon;
-        icon.width = width;
-        icon.height = height;
-        icon.pixels = image;
+        icon.width = image.width;
+        icon.height = image.height;
+        icon.pixels = image.pixels.data();
 
         glfwSetWindowIcon(window, 1, &icon);
 
-        stbi_image_free(image);
-
         return true;
     }
 
@@ -180,237 +106,374 @@ namespace Window {
     }
 
     void Window::keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
-        static json j;
-        hubSettingsPath = "bin/" + string(CURRENT_PLAT) + "-" + string(CURRENT_CONF) + "/VoltLine Engine/hub_settings.json";
-        jsonText;
-
-        if (fileExists("hub_settings.json")) {
-            jsonText = getFileContents("hub_settings.json");
-        }
-        else {
-            jsonText = getFileContents(hubSettingsPath.c_str());
-        }
+        std::optional<Action> boundAction = keyBindingManager.onKeyEvent(key, action, mods);
+        if (!boundAction)
+            return;
 
-        try {
-            j = json::parse(jsonText);
-        }
-        catch (const std::exception& e) {
-            j = json();
+        switch (*boundAction) {
+        case Action::CloseApp:
+            glfwSetWindowShouldClose(window, GLFW_TRUE);
+            exit(0);
         }
+    }
 
-        static std::vector<int> pressedKeys;
+    // Hands focus back to the side panel shortly after a click.
+    static Coroutine::Task<> focusSidePanelAfterClick() {
+        co_await Coroutine::delay(std::chrono::milliseconds(200));
 
-        if (action == GLFW_PRESS) {
-            pressedKeys.push_back(key);
-        }
-        else if (action == GLFW_RELEASE) {
-            pressedKeys.erase(std::remove(pressedKeys.begin(), pressedKeys.end(), key), pressedKeys.end());
-        }
+        if (canFocusOnSidePanelWindow)
+            ImGui::SetWindowFocus("VoltLine Side Panel");
+    }
 
-        std::vector<std::string> keyBindings;
+    static Coroutine::Task<> openInEditor(string command) {
+        // Let pending saves reach the disk before the editor reads the file.
+        co_await Coroutine::runInBackground([]() { SettingsManager::settingsWriter().flush(); });
 
-        for (const auto& combo : j["keybinds"])
-        {
-            keyBindings.push_back(combo);
-        }
+        int exitCode = co_await Coroutine::waitForProcess(command);
+        if (exitCode != 0)
+            cf_Sink::logger->warn(std::format("Editor exited with code {}: {}", exitCode, command));
+    }
 
-        for (const auto& keyBinding : keyBindings) {
-            std::vector<int> expectedKeys = keyBindingManager.parseKeyCombo(keyBinding);
+    void Window::processInputEvents() {
+        inputQueue.drain([this](const InputEvent& event) {
+            switch (event.type) {
+            case InputEvent::Type::Key:
+                keyCallback(applicationWindow, event.code, event.scancode, event.action, event.mods);
+                break;
 
-            bool match = true;
-            for (int expectedKey : expectedKeys) {
-                if (std::find(pressedKeys.begin(), pressedKeys.end(), expectedKey) == pressedKeys.end()) {
-                    match = false;
-                    break;
+            case InputEvent::Type::MouseButton:
+                if (event.code == GLFW_MOUSE_BUTTON_LEFT && event.action == GLFW_PRESS)
+                {
+                    Coroutine::spawn(focusSidePanelAfterClick());
                 }
+                break;
             }
+            });
+    }
 
-            if (match) {
-                if (keyBinding == escapeCombo) {
-                    glfwSetWindowShouldClose(window, GLFW_TRUE);
-                    exit(0);
-                }
+    void Window::updateKeyBinding(Action action, const std::string& newKeyCombo) {
+        keyBindingManager.unregisterAction(action);
+        keyBindingManager.registerKeyBinding(newKeyCombo, action);
+    }
+
+    void Window::loadKeyBindings(const SettingsManager::HubSettings& hubSettings) {
+        keyBindingManager.clearKeyBindings();
+
+        for (const auto& [name, combination] : hubSettings.keybinds)
+        {
+            std::optional<Action> action = KeyBindingManager::actionFromName(name);
+            if (!action) {
+                cf_Sink::logger->warn(std::format("Ignoring unknown keybind: {}", name));
+                continue;
             }
+
+            keyBindingManager.registerKeyBinding(combination, *action);
         }
     }
 
-    void Window::updateKeyBinding(Action action, const std::string& newKeyCombo) {
-        for (auto& keyBinding : keyBindingManager.keyBindings) {
-            if (keyBinding.second == action) {
-                keyBindingManager.keyBindings.erase(keyBinding.first);
-                break;
-            }
+    void Window::applyRenderSettings(const SettingsManager::HubSettings& hubSettings) {
+        framePacer.setMaxFps(hubSettings.render.maxFps);
+        framePacer.setVsync(hubSettings.render.vsync);
+        framePacer.setIdleMode(hubSettings.render.idleMode);
+    }
+
+    void Window::applyProjectRoots(const SettingsManager::HubSettings& hubSettings) {
+        std::vector<std::filesystem::path> roots;
+
+        if (hubSettings.projectRoots) {
+            for (const string& root : *hubSettings.projectRoots)
+                roots.emplace_back(root);
+        }
+        else if (!DirectoryManager::defaultProjectsPath().empty()) {
+            roots.push_back(DirectoryManager::defaultProjectsPath());
+        }
+        else {
+            cf_Sink::logger->warn("No default project root: the documents directory is unknown");
         }
 
-        keyBindingManager.registerKeyBinding(newKeyCombo, action);
+        // Changing the roots restarts the crawl, so only do it when they really changed.
+        if (roots != projectScanner.getRoots())
+            projectScanner.setRoots(std::move(roots));
+    }
+
+    // Registers projects the scanner found that the hub doesn't know yet. Names
+    // already taken by another project are left alone rather than repointed.
+    void Window::addDiscoveredProjects() {
+        VOLT_PROFILE_SCOPE("Window::addDiscoveredProjects");
+
+        size_t added = 0;
+        for (const ProjectManager::DiscoveredProject& project : projectScanner.getProjects()) {
+            if (projectRegistry.findByPath(project.projectFile) || projectRegistry.findByName(project.name))
+                continue;
+
+            if (projectRegistry.add(project.name, project.projectFile))
+                ++added;
+        }
+
+        if (added > 0)
+            cf_Sink::logger->info(std::format("Discovered {} new projects", added));
+    }
+
+    // Parses and validates the document into settings once; everything that runs per
+    // frame reads the typed copy instead of the JSON.
+    void Window::applyHubSettings(const json& j) {
+        SettingsManager::SchemaReport report;
+        settings = SettingsManager::parseSettings<SettingsManager::HubSettings>(j, report);
+
+        for (const string& error : report.errors)
+            cf_Sink::logger->error(std::format("hub_settings.json: {}", error));
+        for (const string& warning : report.warnings)
+            cf_Sink::logger->warn(std::format("hub_settings.json: {}", warning));
+
+        loadKeyBindings(settings);
+        applyRenderSettings(settings);
+        applyProjectRoots(settings);
+        pluginHost.configure(j);
+
+        frameProfiler.setEnabled(settings.debugging.showFps);
     }
 
     int Window::Init() {
+        VOLT_PROFILE_SCOPE("Window::Init");
+        VOLT_PROFILE_THREAD("Main");
+
+        headlessReport.beginStartup();
 
-        cf_Sink::logger->flush_on(spdlog::level::info);
+        // With the async sink this only asks the log writer to flush; everything else is flushed periodically.
+        cf_Sink::logger->flush_on(spdlog::level::err);
         spdlog::set_level(spdlog::level::info);
 
-        cf_Sink::logger->set_pattern("%+");
+        // Starts the workers and makes this thread the one runOnMainThread() jobs land on.
+        EngineManager::JobSystem& jobs = EngineManager::jobSystem();
+        cf_Sink::logger->info(std::format("Job system started with {} workers", jobs.getWorkerCount()));
 
-        if (!glfwInit()) {
-            std::cerr << "Failed to initialize GLFW" << std::endl;
-            return -1;
-        }
+        {
+            VOLT_PROFILE_SCOPE("Window::Init/CreateWindow");
 
-        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef GLFW_PLATFORM_NULL
+            // No display needed: GLFW 3.4's null platform, rendering through OSMesa when it is installed.
+            if (headless.enabled)
+                glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+#endif
 
-        applicationWindow = glfwCreateWindow(windowW, windowH, windowTitle.c_str(), NULL, NULL);
+            if (!glfwInit()) {
+                std::cerr << "Failed to initialize GLFW" << std::endl;
+                return -1;
+            }
 
-        if (!applicationWindow) {
-            cf_Sink::logger->error("Failed to create GLFW window");
-            glfwTerminate();
-            return -1;
-        }
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+            glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
-        string iconPath = "bin/" + string(CURRENT_PLAT) + "-" + string(CURRENT_CONF) + "/VoltLine Engine/logo.png";
+            if (headless.enabled) {
+                glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+#ifdef GLFW_PLATFORM_NULL
+                glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+#endif
+            }
 
-        if (fileExists("logo.png"))
-        {
-            setWindowIcon(applicationWindow, "logo.png");
-        } else {
-            setWindowIcon(applicationWindow, iconPath.c_str());
-        }
+            applicationWindow = glfwCreateWindow(windowW, windowH, windowTitle.c_str(), NULL, NULL);
 
-        static json j;
-        hubSettingsPath = "bin/" + string(CURRENT_PLAT) + "-" + string(CURRENT_CONF) + "/VoltLine Engine/hub_settings.json";
-        jsonText;
+            // No GL at all (no OSMesa, no driver): still run the UI code, just don't draw it.
+            if (!applicationWindow && headless.enabled) {
+                cf_Sink::logger->warn("No OpenGL context available, running headless without a renderer");
+                glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+                applicationWindow = glfwCreateWindow(windowW, windowH, windowTitle.c_str(), NULL, NULL);
+                hasGL = false;
+            }
 
-        if (fileExists("hub_settings.json")) {
-            jsonText = getFileContents("hub_settings.json");
-        }
-        else {
-            jsonText = getFileContents(hubSettingsPath.c_str());
-        }
+            if (!applicationWindow) {
+                cf_Sink::logger->error("Failed to create GLFW window");
+                glfwTerminate();
+                return -1;
+            }
 
-        try {
-            j = json::parse(jsonText);
-        }
-        catch (const std::exception& e) {
-            j = json();
+            // Headless runs have nothing to show it on.
+            if (!headless.enabled)
+                setWindowIcon(applicationWindow, "hub://logo.png");
         }
 
-        glfwMakeContextCurrent(applicationWindow);
-        glfwSetWindowUserPointer(applicationWindow, this);
+        const json& j = SettingsManager::hubSettings().get();
 
-        glfwSetMouseButtonCallback(applicationWindow, [](GLFWwindow* window, int button, int action, int mods)
-            {
-                if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS)
-                {
-                    std::thread([]() {
-                        std::this_thread::sleep_for(std::chrono::milliseconds(200));
-                        if (canFocusOnSidePanelWindow)
-                            ImGui::SetWindowFocus("VoltLine Side Panel");
-                        }).detach();
-                }
-            });
+        if (hasGL)
+            glfwMakeContextCurrent(applicationWindow);
+        glfwSetWindowUserPointer(applicationWindow, this);
 
         setupCallbacks();
 
-        escapeCombo = j["keybinds"]["Escape"];
-        keyBindingManager.registerKeyBinding(escapeCombo, Action::CloseApp);
+        // Background work finishing for a hub task wakes the loop if it is idling.
+        Coroutine::mainScheduler().setWakeCallback([]() { glfwPostEmptyEvent(); });
+
+        // The scan cache lives next to the other hub data; roots come from the settings below.
+        projectScanner.open(SettingsManager::projectsFile().getPath().parent_path() / "project_scan.cache");
+        projectScanner.setScanFinishedCallback([]() { glfwPostEmptyEvent(); });
+
+        applyHubSettings(j);
+        appliedSettingsGeneration = SettingsManager::hubSettings().getGeneration();
+
+        // Initialized on the job system while the window comes up; external plugins wait for first use.
+        pluginHost.loadCorePlugins();
+
+        {
+            VOLT_PROFILE_SCOPE("Window::Init/ProjectRegistry");
+
+            SettingsManager::SettingsStore& projectsFile = SettingsManager::projectsFile();
+            std::filesystem::path registryPath = projectsFile.getPath().parent_path() / "projects.vlreg";
+            bool firstRun = !std::filesystem::exists(registryPath);
+
+            if (!projectRegistry.open(registryPath))
+                cf_Sink::logger->error(std::format("Could not open the project registry: {}", registryPath.string()));
+
+            // Seed a brand new registry with whatever projects.json already lists.
+            if (firstRun)
+                projectRegistry.importJson(projectsFile.get());
+
+            importedProjectsGeneration = projectsFile.getGeneration();
+
+            // Whatever the scan cache from the last run already knows.
+            addDiscoveredProjects();
+        }
 
         IMGUI_CHECKVERSION();
         ImGui::CreateContext();
         ImGuiIO& io = ImGui::GetIO();
         io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
 
-        string fontPath = "bin/" + string(CURRENT_PLAT) + "-" + string(CURRENT_CONF) + "/VoltLine Engine/Fredoka-Medium.ttf";
-        if (fileExists("Fredoka-Medium.ttf"))
         {
-            defaultFont = io.Fonts->AddFontFromFileTTF("Fredoka-Medium.ttf", 16.0f);
-            largeFont = io.Fonts->AddFontFromFileTTF("Fredoka-Medium.ttf", 18.0f);
-            TitleFont = io.Fonts->AddFontFromFileTTF("Fredoka-Medium.ttf", 32.0f);
-            SubHeaderFont = io.Fonts->AddFontFromFileTTF("Fredoka-Medium.ttf", 29.0f);
-            ParagraphFont = io.Fonts->AddFontFromFileTTF("Fredoka-Medium.ttf", 23.0f);
-        }
-        else {
-            defaultFont = io.Fonts->AddFontFromFileTTF(fontPath.c_str(), 16.0f);
-            largeFont = io.Fonts->AddFontFromFileTTF(fontPath.c_str(), 18.0f);
-            TitleFont = io.Fonts->AddFontFromFileTTF(fontPath.c_str(), 32.0f);
-            SubHeaderFont = io.Fonts->AddFontFromFileTTF(fontPath.c_str(), 25.0f);
-            ParagraphFont = io.Fonts->AddFontFromFileTTF(fontPath.c_str(), 20.0f);
+            VOLT_PROFILE_SCOPE("Window::Init/Fonts");
+
+            // The TTF is mapped once (or used in place from hub.vpak) and shared by every size;
+            // warm launches restore the baked atlas from the on-disk cache instead of
+            // rasterizing the glyphs again.
+            // The font shipped next to the hub (loose or packed) keeps its larger sub-header and
+            // paragraph sizes; the build output copy a development tree falls back to uses smaller ones.
+            FileSystem::AssetOrigin fontOrigin;
+            std::optional<FileSystem::AssetData> fontData = FileSystem::vfs().read("hub://Fredoka-Medium.ttf", &fontOrigin);
+            bool localFont = fontOrigin.packed || fontOrigin.directory == 0;
+            const Renderer::FontRequest fontRequests[] = {
+                { 16.0f, &defaultFont },
+                { 18.0f, &largeFont },
+                { 32.0f, &TitleFont },
+                { localFont ? 29.0f : 25.0f, &SubHeaderFont },
+                { localFont ? 23.0f : 20.0f, &ParagraphFont },
+            };
+
+            if (fontData && fontCache.load(io.Fonts, std::move(*fontData), fontRequests))
+                cf_Sink::logger->info(std::format("Font atlas {} ({:016x})", fontCache.wasCacheHit() ? "restored from cache" : "baked", fontCache.getCacheKey()));
+            else
+                cf_Sink::logger->error("Failed to load font: Fredoka-Medium.ttf");
         }
 
-        ImGui_ImplGlfw_InitForOpenGL(applicationWindow, true);
-        ImGui_ImplOpenGL3_Init("#version 420");
+        {
+            VOLT_PROFILE_SCOPE("Window::Init/ImGuiBackends");
 
-        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
-            cf_Sink::logger->error("Failed to initialize GLAD");
-            return -1;
-        }
+            if (hasGL) {
+                ImGui_ImplGlfw_InitForOpenGL(applicationWindow, true);
 
-        ApplyCustomStyle();
+                if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+                    cf_Sink::logger->error("Failed to initialize GLAD");
+                    return -1;
+                }
 
-        string projectIconPath = "bin/" + string(CURRENT_PLAT) + "-" + string(CURRENT_CONF) + "/VoltLine Engine/project_icon.png";
-        if (fileExists("project_icon.png"))
-        {
-            projectIcon = LoadTexture("project_icon.png");
-        }
-        else {
-            projectIcon = LoadTexture(projectIconPath.c_str());
-        }
+                string rendererError;
+                if (!stockUiRenderer) {
+                    streamingUiRenderer = uiRenderer.init(rendererError);
+                    if (!streamingUiRenderer)
+                        cf_Sink::logger->warn(std::format("Streaming UI renderer unavailable ({}), using imgui_impl_opengl3", rendererError));
+                }
+                if (!streamingUiRenderer)
+                    ImGui_ImplOpenGL3_Init("#version 420");
+            }
+            else {
+                ImGui_ImplGlfw_InitForOther(applicationWindow, true);
 
-        string settingsIconPath = "bin/" + string(CURRENT_PLAT) + "-" + string(CURRENT_CONF) + "/VoltLine Engine/settings_icon.png";
-        if (fileExists("settings_icon.png"))
-        {
-            settingsIcon = LoadTexture("settings_icon.png");
-        }
-        else {
-            settingsIcon = LoadTexture(settingsIconPath.c_str());
+                // What the renderer backend would do when it uploads the font texture.
+                unsigned char* fontPixels = nullptr;
+                int fontWidth = 0, fontHeight = 0;
+                io.Fonts->GetTexDataAsRGBA32(&fontPixels, &fontWidth, &fontHeight);
+            }
         }
 
-        string newProjectIconPath = "bin/" + string(CURRENT_PLAT) + "-" + string(CURRENT_CONF) + "/VoltLine Engine/new_project_icon.png";
-        if (fileExists("new_project_icon.png"))
-        {
-            newProjectIcon = LoadTexture("new_project_icon.png");
-        }
-        else {
-            newProjectIcon = LoadTexture(newProjectIconPath.c_str());
-        }
+        ApplyCustomStyle();
 
-        string emptyProjectTemplateIconPath = "bin/" + string(CURRENT_PLAT) + "-" + string(CURRENT_CONF) + "/VoltLine Engine/empty_project_template_icon.png";
-        if (fileExists("empty_project_template_icon.png"))
         {
-            emptyProjectTemplateIcon = LoadTexture("empty_project_template_icon.png");
-        }
-        else {
-            emptyProjectTemplateIcon = LoadTexture(emptyProjectTemplateIconPath.c_str());
-        }
+            VOLT_PROFILE_SCOPE("Window::Init/Textures");
 
-        static json k;
-        string hubSettingsPath = "bin/" + string(CURRENT_PLAT) + "-" + string(CURRENT_CONF) + "/VoltLine Engine/hub_settings.json";
-        string jsonText;
+            // Decoded as jobs on the job system; the main loop packs them into a shared atlas page as
+            // they finish and the buttons show a placeholder until then.
+            textureLoader.setDecodedCallback([]() { glfwPostEmptyEvent(); });
 
-        if (fileExists("hub_settings.json")) {
-            jsonText = getFileContents("hub_settings.json");
-        }
-        else {
-            jsonText = getFileContents(hubSettingsPath.c_str());
+            projectIcon = textureLoader.requestAtlased("hub://project_icon.png");
+            settingsIcon = textureLoader.requestAtlased("hub://settings_icon.png");
+            newProjectIcon = textureLoader.requestAtlased("hub://new_project_icon.png");
+            emptyProjectTemplateIcon = textureLoader.requestAtlased("hub://empty_project_template_icon.png");
         }
 
-        try {
-            k = json::parse(jsonText);
-        }
-        catch (const std::exception& e) {
-            k = json();
-        }
+        int frameIndex = 0;
 
         while (!glfwWindowShouldClose(applicationWindow)) {
-            glClear(GL_COLOR_BUFFER_BIT);
+            if (headless.enabled) {
+                // Scripted runs go flat out: no event waits and no frame limiter.
+                if (frameIndex >= headless.frames)
+                    break;
+
+                glfwPollEvents();
+                headlessReport.beginFrame(selectHeadlessScreen(frameIndex));
+            }
+            else {
+                glClear(GL_COLOR_BUFFER_BIT);
+                framePacer.waitForEvents(applicationWindow);
+            }
+
+            frameProfiler.beginFrame();
 
-            glfwPollEvents();
+            VOLT_PROFILE_SCOPE("Window::Frame");
 
-            ImGui_ImplOpenGL3_NewFrame();
+            processInputEvents();
+
+            jobs.pumpMainThread();
+            if (hasGL)
+                textureLoader.processUploads();
+
+            for (const SettingsManager::WriteFailure& failure : SettingsManager::settingsWriter().takeFailures()) {
+                cf_Sink::logger->error(std::format("Failed to save {}: {}", failure.path.string(), failure.message));
+                saveError = std::format("Failed to save {}.", failure.path.filename().string());
+            }
+
+            // Picks up both external edits to hub_settings.json and changes saved from the Settings popup.
+            SettingsManager::SettingsStore& hubSettings = SettingsManager::hubSettings();
+            hubSettings.poll();
+            if (hubSettings.getGeneration() != appliedSettingsGeneration) {
+                applyHubSettings(hubSettings.get());
+                appliedSettingsGeneration = hubSettings.getGeneration();
+            }
+
+            // projects.json is only a compatibility view of the registry; hand edits to it are merged back.
+            SettingsManager::SettingsStore& projectsFile = SettingsManager::projectsFile();
+            projectsFile.poll();
+            if (projectsFile.getGeneration() != importedProjectsGeneration) {
+                projectRegistry.importJson(projectsFile.get());
+                importedProjectsGeneration = projectsFile.getGeneration();
+
+                // Projects under the roots are discovered, not listed; an edit to the file doesn't drop them.
+                addDiscoveredProjects();
+            }
+
+            // Crawls run on the job system; this only reads change notifications and picks up results.
+            if (projectScanner.poll())
+                addDiscoveredProjects();
+
+            if (hasGL && !streamingUiRenderer)
+                ImGui_ImplOpenGL3_NewFrame();
             ImGui_ImplGlfw_NewFrame();
             ImGui::NewFrame();
 
+            // Resumes hub tasks inside the ImGui frame, so they may call into ImGui.
+            Coroutine::Scheduler& scheduler = Coroutine::mainScheduler();
+            scheduler.tick();
+            if (scheduler.hasPendingWork())
+                framePacer.keepAwake();
+
             ImGui::SetNextWindowPos(ImVec2(0, 0));
             ImGui::SetNextWindowSize(io.DisplaySize);
             ImGui::Begin("MainWindow", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoBackground);
@@ -420,43 +483,85 @@ namespace Window {
 
             ImGui::End();
 
+            frameProfiler.drawOverlay(defaultFont);
+
+            VOLT_PROFILE_SCOPE("Window::Frame/Render");
+
             ImGui::Render();
-            int display_w, display_h;
-            glfwGetFramebufferSize(applicationWindow, &display_w, &display_h);
-            glViewport(0, 0, display_w, display_h);
-            glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
-            glClear(GL_COLOR_BUFFER_BIT);
-            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-
-            glfwSwapBuffers(applicationWindow);
+
+            if (hasGL) {
+                int display_w, display_h;
+                glfwGetFramebufferSize(applicationWindow, &display_w, &display_h);
+
+                frameProfiler.beginGpu();
+                glViewport(0, 0, display_w, display_h);
+                glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+                glClear(GL_COLOR_BUFFER_BIT);
+                ImDrawData* drawData = ImGui::GetDrawData();
+                if (streamingUiRenderer)
+                    uiRenderer.render(drawData);
+                else
+                    ImGui_ImplOpenGL3_RenderDrawData(drawData);
+                frameProfiler.endGpu();
+
+                // The stock backend doesn't count; what it did is derived from the same draw data.
+                if (frameProfiler.isEnabled() || headless.enabled) {
+                    Renderer::UiRenderStats uiStats = streamingUiRenderer ? uiRenderer.getLastFrameStats() : Renderer::describeStockRender(drawData);
+                    frameProfiler.setUiRenderStats(uiStats);
+                    headlessReport.recordUiRender(uiStats);
+                }
+            }
+
+            // Widgets being edited (text carets, drags) count as animation.
+            if (ImGui::IsAnyItemActive())
+                framePacer.keepAwake();
+
+            frameProfiler.endFrame();
+
+            if (hasGL)
+                glfwSwapBuffers(applicationWindow);
+
+            if (headless.enabled) {
+                headlessReport.endFrame();
+                if (frameIndex == 0)
+                    headlessReport.endStartup();
+            }
+            else {
+                framePacer.endFrame();
+            }
+
+            // Every label formatted this frame has been drawn.
+            frameArena().reset();
+
+            ++frameIndex;
         }
 
+        if (headless.enabled)
+            writeHeadlessReport();
+
+        frameProfiler.shutdown();
+        if (hasGL) {
+            textureLoader.shutdown();
+            if (streamingUiRenderer)
+                uiRenderer.shutdown();
+            else
+                ImGui_ImplOpenGL3_Shutdown();
+        }
+        projectScanner.shutdown();
+        pluginHost.shutdown();
+        Coroutine::mainScheduler().shutdown();
+        SettingsManager::settingsWriter().shutdown();
         glfwTerminate();
         return 0;
     }
 
     void Window::ShowMainPanel(const std::string& screen)
     {
+        VOLT_PROFILE_SCOPE("Window::ShowMainPanel");
 
         if (screen == "project")
         {
-            static json j;
-            hubSettingsPath = "bin/" + string(CURRENT_PLAT) + "-" + string(CURRENT_CONF) + "/VoltLine Engine/projects.json";
-            jsonText;
-
-            if (fileExists("projects.json")) {
-                jsonText = getFileContents("projects.json");
-            }
-            else {
-                jsonText = getFileContents(hubSettingsPath.c_str());
-            }
-
-            try {
-                j = json::parse(jsonText);
-            }
-            catch (const std::exception& e) {
-                j = json();
-            }
+            projectList.sync(projectRegistry);
 
             ImGui::SetCursorPos(ImVec2(220, 20));
 
@@ -467,19 +572,34 @@ namespace Window {
             ImGui::SetCursorPos(ImVec2(220, 75));
 
             if (ImGui::BeginChild("ScrollableRegion", ImVec2(1000, 600), true, ImGuiWindowFlags_HorizontalScrollbar)) {
-                for (const auto& [name, value]: j["projects"].items())
+                const std::vector<const ProjectManager::ProjectRecord*>& projects = projectList.getEntries();
+
+                // Only the rows inside the scroll region are submitted.
+                ImGuiListClipper clipper;
+                clipper.Begin(static_cast<int>(projects.size()));
+
+                while (clipper.Step())
                 {
-                    if (ImGui::Button(std::format("{}: {}", name, value["project_file"].dump()).c_str()))
+                    for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
                     {
-                        if (!std::string_view(value["project_file"].dump()).ends_with(R"(.voltproj")"))
+                        const ProjectManager::ProjectRecord& project = *projects[i];
+
+                        if (ImGui::Button(project.label.c_str()))
                         {
-                            cf_Sink::logger->error(std::format("{}: is not a valid VoltLine project type. (etc., .voltproj)", value["project_file"].dump()).c_str());
-                            throw std::runtime_error("Invalid VoltLine Project Type");
-                        }
+                            if (!project.validType)
+                            {
+                                cf_Sink::logger->error(std::format("\"{}\": is not a valid VoltLine project type. (etc., .voltproj)", project.projectFile).c_str());
+                                throw std::runtime_error("Invalid VoltLine Project Type");
+                            }
+
+                            cf_Sink::logger->info(std::format("Opening Project: \"{}\"", project.projectFile));
+                            projectRegistry.touch(project.name);
 
-                        cf_Sink::logger->info(std::format("Opening Project: {}", value["project_file"].dump()));
+                            ImGui::SetWindowFocus("VoltLine Side Panel");
+                        }
 
-                        ImGui::SetWindowFocus("VoltLine Side Panel");
+                        if (ImGui::IsItemHovered())
+                            ShowProjectTooltip(project);
                     }
                 }
             }
@@ -489,15 +609,24 @@ namespace Window {
         {
 
             static char projectName[64] = "New Project";
-            auto defaultProjectPath = DirectoryManager::getUserDocumentsPath({"Documents", "VoltLine Projects", projectName});
+            static char projectLocation[128] = "";
+            static char locationForName[64] = "";
+            static char generatedLocation[128] = "";
 
-            std::string defaultProjectPathStr = defaultProjectPath.string();
+            // The location follows the name until the user edits it; only rebuilt when the name was edited.
+            if (std::strcmp(projectName, locationForName) != 0) {
+                std::memcpy(locationForName, projectName, sizeof(projectName));
 
-            static char projectLocation[128] = "";
+                string defaultProjectPath = (DirectoryManager::defaultProjectsPath() / projectName).string();
+                if (defaultProjectPath.size() >= sizeof(projectLocation)) {
+                    cf_Sink::logger->warn(std::format("Default project location is too long: {}", defaultProjectPath));
+                    defaultProjectPath.clear();
+                }
 
-            errno_t err = strncpy_s(projectLocation, sizeof(projectLocation), defaultProjectPathStr.c_str(), defaultProjectPathStr.size());
-            if (err != 0) {
-                throw std::runtime_error("Error copying defaultProjectPath.string() into projectLocation.");
+                if (std::strcmp(projectLocation, generatedLocation) == 0)
+                    std::memcpy(projectLocation, defaultProjectPath.c_str(), defaultProjectPath.size() + 1);
+
+                std::memcpy(generatedLocation, defaultProjectPath.c_str(), defaultProjectPath.size() + 1);
             }
 
             ImGui::SetCursorPos(ImVec2(220, 20));
@@ -508,7 +637,8 @@ namespace Window {
 
             ImGui::SetCursorPos(ImVec2(220, 90));
             
-            if (ImGui::ImageButton("empty_project_template_icon_id", (ImTextureID)(intptr_t)emptyProjectTemplateIcon, ImVec2(290, 290)))
+            Renderer::TextureView templateIcon = textureLoader.getView(emptyProjectTemplateIcon);
+            if (ImGui::ImageButton("empty_project_template_icon_id", templateIcon.id, ImVec2(290, 290), templateIcon.uv0, templateIcon.uv1))
             {
                 currentTemplate = "Empty";
             }
@@ -518,7 +648,7 @@ namespace Window {
             ImGui::SetCursorPos(ImVec2(220, 400));
 
             ImGui::PushFont(SubHeaderFont);
-            ImGui::Text(std::format("Project Template: {}", currentTemplate).c_str());
+            ImGui::TextUnformatted(frameText("Project Template: {}", currentTemplate));
 
             ImGui::SetCursorPos(ImVec2(220, 430));
 
@@ -561,34 +691,63 @@ namespace Window {
             ImGui::PushFont(SubHeaderFont);
             if (ImGui::Button("Create Project", ImVec2(300, 50)))
             {
-                static json j;
-                hubSettingsPath = "bin/" + string(CURRENT_PLAT) + "-" + string(CURRENT_CONF) + "/VoltLine Engine/projects.json";
-                jsonText;
+                string projectFile = (std::filesystem::path(projectLocation) / (string(projectName) + ".voltproj")).string();
 
-                if (fileExists("projects.json")) {
-                    jsonText = getFileContents("projects.json");
-                }
-                else {
-                    jsonText = getFileContents(hubSettingsPath.c_str());
-                }
-
-                try {
-                    j = json::parse(jsonText);
-                }
-                catch (const std::exception& e) {
-                    j = json();
-                }
+                if (!std::filesystem::exists(projectFile))
+                    createProjectFile(projectFile, projectName);
 
-                j["projects"][projectName] = {
-                    {"project_file", std::string(projectLocation) + "\\" + std::string(projectName) + ".voltproj"}
-                };
-
-                SaveProjects(j);
+                if (!projectRegistry.add(projectName, projectFile))
+                    cf_Sink::logger->error(std::format("Could not register project \"{}\" ({}).", projectName, projectFile));
             }
             ImGui::PopFont();
         }
     }
 
+    // Writes a new .voltproj holding just the project's metadata.
+    void Window::createProjectFile(const std::filesystem::path& projectFile, const string& name)
+    {
+        ProjectManager::ProjectMetadata metadata;
+        metadata.name = name;
+        metadata.templateName = currentTemplate;
+        metadata.engineVersion = settings.engine.engineVersion;
+        metadata.createdTime = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        metadata.modifiedTime = metadata.createdTime;
+
+        std::error_code ec;
+        std::filesystem::create_directories(projectFile.parent_path(), ec);
+
+        ProjectManager::ProjectFileWriter writer;
+        writer.setMetadata(metadata);
+
+        string error;
+        if (!writer.write(projectFile, error))
+            cf_Sink::logger->error(std::format("Could not create project file {}: {}", projectFile.string(), error));
+    }
+
+    void Window::ShowProjectTooltip(const ProjectManager::ProjectRecord& project)
+    {
+        const ProjectManager::ProjectSummary& summary = projectList.getSummary(project);
+
+        ImGui::BeginTooltip();
+        if (summary.metadata) {
+            const ProjectManager::ProjectMetadata& metadata = *summary.metadata;
+
+            std::chrono::year_month_day modified(std::chrono::floor<std::chrono::days>(std::chrono::sys_seconds(std::chrono::seconds(metadata.modifiedTime))));
+
+            ImGui::TextUnformatted(metadata.name.c_str());
+            if (!metadata.description.empty())
+                ImGui::TextUnformatted(metadata.description.c_str());
+            ImGui::Separator();
+            ImGui::TextUnformatted(frameText("Template: {}", metadata.templateName));
+            ImGui::TextUnformatted(frameText("Engine version: {}", metadata.engineVersion));
+            ImGui::TextUnformatted(frameText("Modified: {}-{:02}-{:02}", static_cast<int>(modified.year()), static_cast<unsigned>(modified.month()), static_cast<unsigned>(modified.day())));
+        }
+        else {
+            ImGui::TextDisabled("%s", summary.error.c_str());
+        }
+        ImGui::EndTooltip();
+    }
+
     void Window::ProjectButtonCallback()
     {
         if (currentScreen == "project") {
@@ -605,12 +764,15 @@ namespace Window {
 
     void Window::ShowSidePanel()
     {
+        VOLT_PROFILE_SCOPE("Window::ShowSidePanel");
+
         ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
         ImGui::SetNextWindowSize(ImVec2(200, ImGui::GetIO().DisplaySize.y), ImGuiCond_Always);
 
         ImGui::Begin("VoltLine Side Panel", nullptr, ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove);
 
-        if (ImGui::ImageButton("project_icon_id", (ImTextureID)(intptr_t)projectIcon, ImVec2(64, 64)))
+        Renderer::TextureView projectIconView = textureLoader.getView(projectIcon);
+        if (ImGui::ImageButton("project_icon_id", projectIconView.id, ImVec2(64, 64), projectIconView.uv0, projectIconView.uv1))
         {
             currentScreen = "project";
             ProjectButtonCallback();
@@ -619,7 +781,8 @@ namespace Window {
         ImGui::SetCursorPosY(ImGui::GetCursorPosY() + (64 - ImGui::GetTextLineHeight()) * 0.5f);
         ImGui::Text("Projects");
 
-        if (ImGui::ImageButton("new_project_icon_id", (ImTextureID)(intptr_t)newProjectIcon, ImVec2(64, 64)))
+        Renderer::TextureView newProjectIconView = textureLoader.getView(newProjectIcon);
+        if (ImGui::ImageButton("new_project_icon_id", newProjectIconView.id, ImVec2(64, 64), newProjectIconView.uv0, newProjectIconView.uv1))
         {
             currentScreen = "new_project";
             ProjectButtonCallback();
@@ -628,7 +791,8 @@ namespace Window {
         ImGui::SetCursorPosY(ImGui::GetCursorPosY() + (64 - ImGui::GetTextLineHeight()) * 0.5f);
         ImGui::Text("New Project");
 
-        if (ImGui::ImageButton("settings_icon_id", (ImTextureID)(intptr_t)settingsIcon, ImVec2(64, 64)))
+        Renderer::TextureView settingsIconView = textureLoader.getView(settingsIcon);
+        if (ImGui::ImageButton("settings_icon_id", settingsIconView.id, ImVec2(64, 64), settingsIconView.uv0, settingsIconView.uv1) || std::exchange(settingsOpenRequested, false))
         {
             canFocusOnSidePanelWindow = false;
             ImGui::OpenPopup("Settings Panel");
@@ -648,53 +812,29 @@ namespace Window {
         static bool debuggingOn;
         static bool showingFps;
 
-        static json j;
-        static bool isInitialized = false;
+        static uint64_t loadedGeneration = 0;
 
         if (ImGui::BeginPopupModal("Settings Panel", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
             canFocusOnSidePanelWindow = false;
             ImGui::SetWindowFocus("Settings Panel");
-            if (!isInitialized) {
-                hubSettingsPath = "bin/" + string(CURRENT_PLAT) + "-" + string(CURRENT_CONF) + "/VoltLine Engine/hub_settings.json";
-                jsonText;
 
-                if (fileExists("hub_settings.json")) {
-                    jsonText = getFileContents("hub_settings.json");
-                }
-                else {
-                    jsonText = getFileContents(hubSettingsPath.c_str());
-                }
+            // settings is reparsed whenever the file changes (see applyHubSettings).
+            if (loadedGeneration != appliedSettingsGeneration) {
+                loggingOn = settings.debugging.logging;
+                debuggingOn = settings.debugging.enableDebugMode;
+                showingFps = settings.debugging.showFps;
 
-                try {
-                    j = json::parse(jsonText);
-                }
-                catch (const std::exception& e) {
-                    j = json();
-                }
-
-                loggingOn = j["debugging"]["logging"];
-                debuggingOn = j["debugging"]["enable_debug_mode"];
-                showingFps = j["debugging"]["show_fps"];
-
-                isInitialized = true;
+                loadedGeneration = appliedSettingsGeneration;
             }
 
-            string engineVersion = j["engine_settings"]["engine_version"];
-            string engineLogDir = j["engine_settings"]["engine_log_file_dir"];
-            string preferred_editor_win = j["engine_settings"]["preferred_editor_win"];
-
-            int maxFps = j["render_settings"]["max_fps"];
-
-            auto renderers = j["render_settings"]["renderers"];
-            
             ImGui::PushFont(largeFont);
             ImGui::Text("Engine Settings");
             ImGui::PopFont();
             ImGui::Separator();
 
-            ImGui::Text(std::format("Engine Version: {}", engineVersion).c_str());
-            ImGui::Text(std::format("Engine File Log: {}", engineLogDir).c_str());
-            ImGui::Text(std::format("Preferred Windows Editor: {}", preferred_editor_win).c_str());
+            ImGui::TextUnformatted(frameText("Engine Version: {}", settings.engine.engineVersion));
+            ImGui::TextUnformatted(frameText("Engine File Log: {}", settings.engine.logFileDir));
+            ImGui::TextUnformatted(frameText("Preferred Windows Editor: {}", settings.engine.preferredEditorWin));
 
             ImGui::Spacing();
 
@@ -714,12 +854,11 @@ namespace Window {
             ImGui::PopFont();
             ImGui::Separator();
 
-            ImGui::Text(std::format("Max FPS: {}", maxFps).c_str());
+            ImGui::TextUnformatted(frameText("Max FPS: {}", settings.render.maxFps));
 
             ImGui::Text("Used/Required Renderers:");
-            for (const auto& renderer : renderers) {
-                string rendererStr = renderer.dump();
-                ImGui::Text(fmt::format("{}{}", tenSpace, rendererStr).c_str());
+            for (const string& renderer : settings.render.renderers) {
+                ImGui::TextUnformatted(frameText(tenSpace "{}", renderer));
             }
 
             ImGui::Spacing();
@@ -729,9 +868,9 @@ namespace Window {
             ImGui::PopFont();
             ImGui::Separator();
 
-            for (auto& [name, value] : j["keybinds"].items())
+            for (const auto& [name, combination] : settings.keybinds)
             {
-                ImGui::Text(std::format("{}: {}", name, value.dump()).c_str());
+                ImGui::TextUnformatted(frameText("{}: {}", name, combination));
             }
 
             ImGui::Spacing();
@@ -741,133 +880,132 @@ namespace Window {
             ImGui::PopFont();
             ImGui::Separator();
 
-            for (auto& [name, value] : j["plugins"].items())
+            // Entries the host couldn't use show up as failed here rather than throwing mid-frame.
+            for (const Plugins::Plugin& plugin : pluginHost.getPlugins())
             {
-                bool pluginEnabled = value["enabled"];
-                string pluginType = value["type"];
-                string pluginLocation = value["location"];
-                string pluginPrimaryFile = value["primaryFile"];
-
-                if (pluginEnabled == 1)
-                    pluginEnabled = true;
-                else if (pluginEnabled == 0)
-                    pluginEnabled = false;
-
-                if (pluginType == "core" || pluginType == "Core" || pluginType == "CORE") {
-                    // later
-                }
-                else if (pluginType == "external" || pluginType == "External" || pluginType == "EXTERNAL") {
-                    // much later
-                }
-                else {
-                    cf_Sink::logger->error(std::format("Invalid Plugin Type: {}. Acceptables types include: core (core, Core, or CORE) and external (external, External or EXTERNAL)", pluginType).c_str());
-                    throw std::runtime_error("Invalid Plugin Type");
-                }
-
-                ImGui::Text(std::format(R"({}: 
-    Enabled: {}
+                std::array<char, 512> status;
+                ImGui::TextUnformatted(frameText(R"({}: 
     Type: {}
-    Location: {}
-    Primary File: {}
-)", name, pluginEnabled, pluginType, pluginLocation, pluginPrimaryFile).c_str());
+    File: {}
+    Status: {}
+)", plugin.name, plugin.type == Plugins::PluginType::Core ? "core" : "external", plugin.displayPath, Plugins::describeStatus(plugin, status)));
             }
 
             // Finish Keybinds and Plugins
 
-            bool currentLoggingState = j["debugging"]["logging"];
-            bool currentDebuggingState = j["debugging"]["enable_debug_mode"];
-            bool currentShowFPSState = j["debugging"]["show_fps"];
-
-            if (currentLoggingState != loggingOn) {
-                j["debugging"]["logging"] = loggingOn;
-
-                SaveHubSettings(j);
-            }
-            else if (currentDebuggingState != debuggingOn) {
-                j["debugging"]["enable_debug_mode"] = debuggingOn;
-
-                SaveHubSettings(j);
-            }
-            else if (currentShowFPSState != showingFps) {
-                j["debugging"]["show_fps"] = showingFps;
-
-                SaveHubSettings(j);
+            SettingsManager::DebugSettings debugging = settings.debugging;
+            debugging.logging = loggingOn;
+            debugging.enableDebugMode = debuggingOn;
+            debugging.showFps = showingFps;
+
+            if (debugging.logging != settings.debugging.logging || debugging.enableDebugMode != settings.debugging.enableDebugMode
+                || debugging.showFps != settings.debugging.showFps) {
+                // Only the debugging section is rewritten; the rest of the file stays as the user wrote it.
+                json updated = SettingsManager::hubSettings().get();
+                if (!updated.is_object())
+                    updated = json::object();
+                SettingsManager::writeSettings(debugging, updated["debugging"]);
+                SaveHubSettings(updated);
             }
 
-            std::string filePath1;
-            std::string filePath2;
-            std::string command1 = "error";
-            std::string command2 = "error";
-
-            if (fileExists("hub_settings.json"))
-                filePath1 = "hub_settings.json";
-            else
-                filePath1 = "bin/" + string(CURRENT_PLAT) + "-" + string(CURRENT_CONF) + "/VoltLine Engine/hub_settings.json";
-
-            if (fileExists("projects.json"))
-                filePath2 = "projects.json";
-            else
-                filePath2 = "bin/" + string(CURRENT_PLAT) + "-" + string(CURRENT_CONF) + "/VoltLine Engine/projects.json";
-
+            // The editor command is only built when a button is actually pressed.
+            auto editorCommand = [this](const std::filesystem::path& filePath) -> std::optional<string> {
 #ifdef _WIN32
-            command1 = std::format("{} {}", j["engine_settings"]["preferred_editor_win"].dump(), filePath1);
-            command2 = std::format("{} {}", j["engine_settings"]["preferred_editor_win"].dump(), filePath2);
+                return std::format("\"{}\" {}", settings.engine.preferredEditorWin, filePath.string());
+#else
+                return std::nullopt;
 #endif
+            };
 
             ImGui::Spacing();
             if (ImGui::Button("Open Hub Settings (hub_settings.json)"))
             {
-                if (command1 == "error")
+                std::optional<string> command = editorCommand(SettingsManager::hubSettings().getPath());
+                if (!command)
                 {
                     cf_Sink::logger->error("Unsupported OS");
                     std::this_thread::sleep_for(std::chrono::seconds(1));
                     exit(0);
                 }
-                system(command1.c_str());
+                Coroutine::spawn(openInEditor(*command));
             }
             if (ImGui::Button("Open Projects File (projects.json)"))
             {
-                system(command2.c_str());
+                // Write out the registry so the file being edited is current.
+                SaveProjects(projectRegistry.exportJson());
+                importedProjectsGeneration = SettingsManager::projectsFile().getGeneration();
+                if (std::optional<string> command = editorCommand(SettingsManager::projectsFile().getPath()))
+                    Coroutine::spawn(openInEditor(*command));
             }
             ImGui::Spacing();
 
-            if (ImGui::Button("Close")) {
+            if (!saveError.empty()) {
+                ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%s", saveError.c_str());
+                ImGui::Spacing();
+            }
+
+            if (ImGui::Button("Close") || settingsCloseRequested) {
                 ImGui::CloseCurrentPopup();
                 canFocusOnSidePanelWindow = true;
             }
             ImGui::EndPopup();
         }
+        settingsCloseRequested = false;
         
         ImGui::End();
     }
 
-    void Window::SaveHubSettings(const json& j)
+    // Which screen a headless run shows on the given frame: each scripted screen in
+    // turn for framesPerScreen frames, wrapping around until the run is over.
+    string Window::selectHeadlessScreen(int frame)
     {
-        string hubSettingsJSONPath = "bin/" + string(CURRENT_PLAT) + "-" + string(CURRENT_CONF) + "/VoltLine Engine/hub_settings.json";
+        if (headless.screens.empty())
+            return currentScreen;
 
-        try {
-            if (fileExists("hub_settings.json"))
-                saveFileContents(j.dump(4).c_str(), "hub_settings.json");
-            else
-                saveFileContents(j.dump(4).c_str(), hubSettingsJSONPath.c_str());
+        int perScreen = std::max(headless.framesPerScreen, 1);
+        const string& screen = headless.screens[(frame / perScreen) % headless.screens.size()];
+
+        // The settings popup has no screen of its own: it is opened over the current
+        // one on the way in and closed on the way out.
+        bool showSettings = screen == "settings";
+        if (showSettings != headlessSettingsShown) {
+            settingsOpenRequested = showSettings;
+            settingsCloseRequested = !showSettings;
+            headlessSettingsShown = showSettings;
         }
-        catch (const std::exception& e) {
-            ImGui::Text("Failed to save settings.");
+
+        if (!showSettings)
+            currentScreen = screen;
+
+        return screen;
+    }
+
+    void Window::writeHeadlessReport()
+    {
+        string renderer = "none";
+        if (hasGL) {
+            const GLubyte* name = glGetString(GL_RENDERER);
+            renderer = name ? std::format("opengl ({})", reinterpret_cast<const char*>(name)) : "opengl";
         }
+
+        string uiRenderer = !hasGL ? "none" : streamingUiRenderer ? "streaming" : "imgui_impl_opengl3";
+        string report = headlessReport.toJson(renderer, uiRenderer).dump(4);
+
+        std::ofstream file(headless.reportPath, std::ios::binary);
+        file << report << std::endl;
+        if (file)
+            cf_Sink::logger->info(std::format("Headless report written to {}", headless.reportPath));
+        else
+            cf_Sink::logger->error(std::format("Could not write the headless report to {}", headless.reportPath));
     }
 
-    void Window::SaveProjects(const json& j)
+    void Window::SaveHubSettings(const json& j)
     {
-        string projectsJSONPath = "bin/" + string(CURRENT_PLAT) + "-" + string(CURRENT_CONF) + "/VoltLine Engine/projects.json";
+        SettingsManager::hubSettings().save(j);
+    }
 
-        try {
-            if (fileExists("projects.json"))
-                saveFileContents(j.dump(4).c_str(), "projects.json");
-            else
-                saveFileContents(j.dump(4).c_str(), projectsJSONPath.c_str());
-        }
-        catch (const std::exception& e) {
-            ImGui::Text("Failed to save projects.");
-        }
+    void Window::SaveProjects(const json& j)
+    {
+        SettingsManager::projectsFile().save(j);
     }
 }
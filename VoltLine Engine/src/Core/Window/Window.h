@@ -9,6 +9,21 @@ using json = nlohmann::json;
 #include "imgui_impl_glfw.h"
 #include "imgui_impl_opengl3.h"
 
+#include "Core/Window/FrameArena.h"
+#include "Core/Window/FramePacer.h"
+#include "Core/Window/FrameProfiler.h"
+#include "Core/Window/HeadlessRun.h"
+#include "Core/Window/InputQueue.h"
+#include "Core/Coroutine/Scheduler.h"
+#include "Core/Renderer/AsyncTextureLoader.h"
+#include "Core/Renderer/FontAtlasCache.h"
+#include "Core/Renderer/ImGuiRenderer.h"
+#include "Core/Managers/ProjectManager/ProjectManager.h"
+#include "Core/Managers/ProjectManager/ProjectScanner.h"
+#include "Core/Managers/SettingsManager/HubSettings.h"
+#include "Core/Logging/AsyncSink.h"
+#include "Core/Plugins/PluginHost.h"
+
 enum class Action {
 	CloseApp
 };
@@ -25,42 +40,112 @@ namespace Window {
 	public:
 		int windowW, windowH;
 		std::string windowTitle;
+		HeadlessOptions headless;
+		// --stock-ui-renderer: draw with imgui_impl_opengl3 instead of Renderer::ImGuiRenderer.
+		bool stockUiRenderer = false;
 
 		int Init();
 		void ShowSidePanel();
 		void SaveHubSettings(const json& j);
 		void SaveProjects(const json& j);
 		void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
+		void processInputEvents();
 		void updateKeyBinding(Action action, const std::string& newKeyCombo);
+		void loadKeyBindings(const SettingsManager::HubSettings& hubSettings);
+		void applyRenderSettings(const SettingsManager::HubSettings& hubSettings);
+		void applyProjectRoots(const SettingsManager::HubSettings& hubSettings);
+		void addDiscoveredProjects();
+		void applyHubSettings(const json& j);
 		void ProjectButtonCallback();
 		void ShowMainPanel(const std::string& screen);
+		void ShowProjectTooltip(const ProjectManager::ProjectRecord& project);
+		void createProjectFile(const std::filesystem::path& projectFile, const string& name);
+		string selectHeadlessScreen(int frame);
+		void writeHeadlessReport();
 
 		void setupCallbacks() {
 			glfwSetKeyCallback(applicationWindow, [](GLFWwindow* window, int key, int scancode, int action, int mods) {
 				Window* self = static_cast<Window*>(glfwGetWindowUserPointer(window));
 				if (self) {
-					self->keyCallback(window, key, scancode, action, mods);
+					self->framePacer.markActivity();
+					self->inputQueue.push({ InputEvent::Type::Key, key, scancode, action, mods });
+				}
+				});
+			glfwSetMouseButtonCallback(applicationWindow, [](GLFWwindow* window, int button, int action, int mods) {
+				Window* self = static_cast<Window*>(glfwGetWindowUserPointer(window));
+				if (self) {
+					self->framePacer.markActivity();
+					self->inputQueue.push({ InputEvent::Type::MouseButton, button, 0, action, mods });
 				}
 				});
+
+			// Anything that changes what is on screen wakes the frame pacer up.
+			glfwSetCursorPosCallback(applicationWindow, [](GLFWwindow* window, double x, double y) {
+				markWindowActivity(window);
+				});
+			glfwSetScrollCallback(applicationWindow, [](GLFWwindow* window, double x, double y) {
+				markWindowActivity(window);
+				});
+			glfwSetCharCallback(applicationWindow, [](GLFWwindow* window, unsigned int codepoint) {
+				markWindowActivity(window);
+				});
+			glfwSetWindowFocusCallback(applicationWindow, [](GLFWwindow* window, int focused) {
+				markWindowActivity(window);
+				});
+			glfwSetFramebufferSizeCallback(applicationWindow, [](GLFWwindow* window, int width, int height) {
+				markWindowActivity(window);
+				});
+			glfwSetWindowRefreshCallback(applicationWindow, [](GLFWwindow* window) {
+				markWindowActivity(window);
+				});
+		}
+
+		static void markWindowActivity(GLFWwindow* window) {
+			Window* self = static_cast<Window*>(glfwGetWindowUserPointer(window));
+			if (self) {
+				self->framePacer.markActivity();
+			}
 		}
 		
 	private:
 		GLFWwindow* applicationWindow;
-		GLuint projectIcon;
-		GLuint settingsIcon;
-		GLuint newProjectIcon;
-		GLuint emptyProjectTemplateIcon;
+		FramePacer framePacer;
+		FrameProfiler frameProfiler;
+		InputQueue inputQueue;
+		// hub_settings.json as of appliedSettingsGeneration, parsed and validated.
+		SettingsManager::HubSettings settings;
+		uint64_t appliedSettingsGeneration = 0;
+		Renderer::AsyncTextureLoader textureLoader;
+		Renderer::ImGuiRenderer uiRenderer;
+		// False when ImGui is drawn by imgui_impl_opengl3 (asked for, or the context lacks GL 4.4).
+		bool streamingUiRenderer = false;
+		Renderer::TextureHandle projectIcon = Renderer::InvalidTexture;
+		Renderer::TextureHandle settingsIcon = Renderer::InvalidTexture;
+		Renderer::TextureHandle newProjectIcon = Renderer::InvalidTexture;
+		Renderer::TextureHandle emptyProjectTemplateIcon = Renderer::InvalidTexture;
 
+		Renderer::FontAtlasCache fontCache;
 		ImFont* defaultFont;
 		ImFont* largeFont;
 		ImFont* TitleFont;
 		ImFont* ParagraphFont;
 		ImFont* SubHeaderFont;
 
-		string hubSettingsPath;
-		string jsonText;
-		
-		string escapeCombo;
+		ProjectManager::ProjectRegistry projectRegistry;
+		ProjectManager::ProjectListModel projectList;
+		ProjectManager::ProjectScanner projectScanner;
+		Plugins::PluginHost pluginHost;
+
+		// False when --headless couldn't get a GL context; frames are then built but not drawn.
+		bool hasGL = true;
+		// Open or close the settings popup on the next ShowSidePanel(), as if its buttons were clicked.
+		bool settingsOpenRequested = false;
+		bool settingsCloseRequested = false;
+		// Whether the headless script currently has the settings popup up.
+		bool headlessSettingsShown = false;
+		HeadlessReport headlessReport;
+		uint64_t importedProjectsGeneration = 0;
+		string saveError;
 
 		string currentScreen = "project";
 		string currentTemplate = "Empty";